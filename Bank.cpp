@@ -41,6 +41,9 @@ Bank::Bank() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	invalidScope = design_scope;
+	matCalculated = false;
+	latencyOnly = false;
 }
 
 Bank::~Bank() {
@@ -52,6 +55,39 @@ void Bank::PrintProperty() {
 	FunctionUnit::PrintProperty();
 }
 
+void Bank::GetObjective(double *_objective) {
+	_objective[read_latency_objective] = readLatency;
+	_objective[write_latency_objective] = writeLatency;
+	_objective[read_energy_objective] = readDynamicEnergy;
+	_objective[write_energy_objective] = writeDynamicEnergy;
+	_objective[leakage_objective] = leakage;
+	_objective[area_objective] = area;
+}
+
+void Bank::CalculateMatLatencyAndPower() {
+	if (!matCalculated) {
+		mat.CalculateLatency(1e41 /* means Inf */);
+		if (!latencyOnly)
+			mat.CalculatePower();
+		matCalculated = true;
+	}
+}
+
+void Bank::RecalculateGlobalWire() {
+	/* The mat does not use the global wire, and matCalculated keeps its latency and power */
+	if (!initialized || invalid)
+		return;
+	CalculateArea();
+	CalculateLatencyAndPower();
+}
+
+double Bank::LowerBound(OptimizationTarget _optimizationTarget) {
+	/* The area is final after CalculateArea(), the routing may decrease the other metrics so they are not bounded here */
+	if (_optimizationTarget == area_optimized)
+		return area;
+	return 0;
+}
+
 Bank & Bank::operator=(const Bank &rhs) {
 	height = rhs.height;
 	width = rhs.width;
@@ -68,8 +104,12 @@ Bank & Bank::operator=(const Bank &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
+	invalidScope = rhs.invalidScope;
+	matCalculated = rhs.matCalculated;
+	latencyOnly = rhs.latencyOnly;
 	numRowMat = rhs.numRowMat;
 	numColumnMat = rhs.numColumnMat;
 	capacity = rhs.capacity;
@@ -49,7 +49,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	virtual void Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
+	virtual void Initialize(SimulationContext *_context, int _numRowMat, int _numColumnMat, long long _capacity,
 			long _blockSize, int _associativity, int _numRowPerSet, int _numActiveMatPerRow,
 			int _numActiveMatPerColumn, int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			int _numRowSubarray, int _numColumnSubarray,
@@ -58,11 +58,18 @@ public:
 	virtual void CalculateArea() = 0;
 	virtual void CalculateRC() = 0;
 	virtual void CalculateLatencyAndPower() = 0;
+	void CalculateMatLatencyAndPower();	/* The mat part of CalculateLatencyAndPower(), can be called ahead of it for the bounds */
+	virtual double LowerBound(OptimizationTarget _optimizationTarget);	/* Valid after CalculateArea(), tighter after CalculateMatLatencyAndPower() */
+	void GetObjective(double *_objective);	/* Fill the metrics indexed by ParetoObjective */
+	virtual void RecalculateGlobalWire();	/* Calculate a calculated bank again after the global wire changed, the mat results are kept */
 	virtual Bank & operator=(const Bank &);
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
 	bool invalid;		/* Indicate that the current configuration is not valid, pass down to all the sub-components */
+	InvalidScope invalidScope;	/* The other designs that are invalid for the same reason */
+	bool matCalculated;	/* Whether the mat latency and power are already calculated */
+	bool latencyOnly;	/* Skip the mat power, the energies and the leakage are then not valid */
 	bool internalSenseAmp;
 	int numRowMat;		/* Number of mat rows in a bank */
 	int numColumnMat;	/* Number of mat columns in a bank */
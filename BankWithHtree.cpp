@@ -37,117 +37,39 @@
 
 #include "BankWithHtree.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 
 BankWithHtree::BankWithHtree() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
-	numHorizontalAddressBitToRoute = NULL;  /* The number of horizontal bits to route on level x */
-	numHorizontalDataDistributeBitToRoute = NULL;   /* The number of horizontal data-in bits to route on level x */
-	numHorizontalDataBroadcastBitToRoute = NULL;  /* The number of horizontal data-out bits to route on level x */
-	numHorizontalWire = NULL;		/* The number of horizontal wires on level x */
-	numSumHorizontalWire = NULL;	/* The number of total horizontal wires on level x */
-	numActiveHorizontalWire = NULL;	/* The number of active horizontal wires on level x */
-	lengthHorizontalWire = NULL;	/* The length of horizontal wires on level x, Unit: m */
-	numVerticalAddressBitToRoute = NULL;	/* The number of vertical address bits to route on level x */
-	numVerticalDataDistributeBitToRoute = NULL;  /* The number of vertical data-in bits to route on level x */
-	numVerticalDataBroadcastBitToRoute = NULL; /* The number of vertical data-out bits to route on level x */
-	numVerticalWire = NULL;			/* The number of vertical wires on level x */
-	numSumVerticalWire = NULL;		/* The number of total vertical wires on level x */
-    numActiveVerticalWire = NULL;	/* The number of active vertical wires on level x */
-	lengthVerticalWire = NULL;		/* The length of vertical wires on level 2, Unit: m */
 }
 
 BankWithHtree::~BankWithHtree() {
 	// TODO Auto-generated destructor stub
-	if (numHorizontalAddressBitToRoute)
-		delete [] numHorizontalAddressBitToRoute;
-	if (numHorizontalDataDistributeBitToRoute)
-		delete [] numHorizontalDataDistributeBitToRoute;
-	if (numHorizontalDataBroadcastBitToRoute)
-		delete [] numHorizontalDataBroadcastBitToRoute;
-	if (numHorizontalWire)
-		delete [] numHorizontalWire;
-	if (numSumHorizontalWire)
-		delete [] numSumHorizontalWire;
-	if (numActiveHorizontalWire)
-		delete [] numActiveHorizontalWire;
-	if (lengthHorizontalWire)
-		delete [] lengthHorizontalWire;
-	if (numVerticalAddressBitToRoute)
-		delete [] numVerticalAddressBitToRoute;
-	if (numVerticalDataDistributeBitToRoute)
-		delete [] numVerticalDataDistributeBitToRoute;
-	if (numVerticalDataBroadcastBitToRoute)
-		delete [] numVerticalDataBroadcastBitToRoute;
-	if (numVerticalWire)
-		delete [] numVerticalWire;
-	if (numSumVerticalWire)
-		delete [] numSumVerticalWire;
-	if (numActiveVerticalWire)
-		delete [] numActiveVerticalWire;
-	if (lengthVerticalWire)
-		delete [] lengthVerticalWire;
 }
 
-void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
+void BankWithHtree::Initialize(SimulationContext *_context, int _numRowMat, int _numColumnMat, long long _capacity,
 		long _blockSize, int _associativity, int _numRowPerSet, int _numActiveMatPerRow,
 		int _numActiveMatPerColumn, int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 		int _numRowSubarray, int _numColumnSubarray,
 		int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType) {
+	context = _context;
+	PROFILE_STAGE(bank_profile, initialize_stage);
 	if (initialized) {
 		/* Reset the class for re-initialization */
-		if (numHorizontalAddressBitToRoute)
-			delete [] numHorizontalAddressBitToRoute;
-		if (numHorizontalDataDistributeBitToRoute)
-			delete [] numHorizontalDataDistributeBitToRoute;
-		if (numHorizontalDataBroadcastBitToRoute)
-			delete [] numHorizontalDataBroadcastBitToRoute;
-		if (numHorizontalWire)
-			delete [] numHorizontalWire;
-		if (numSumHorizontalWire)
-			delete [] numSumHorizontalWire;
-		if (numActiveHorizontalWire)
-			delete [] numActiveHorizontalWire;
-		if (lengthHorizontalWire)
-			delete [] lengthHorizontalWire;
-		if (numVerticalAddressBitToRoute)
-			delete [] numVerticalAddressBitToRoute;
-		if (numVerticalDataDistributeBitToRoute)
-			delete [] numVerticalDataDistributeBitToRoute;
-		if (numVerticalDataBroadcastBitToRoute)
-			delete [] numVerticalDataBroadcastBitToRoute;
-		if (numVerticalWire)
-			delete [] numVerticalWire;
-		if (numSumVerticalWire)
-			delete [] numSumVerticalWire;
-		if (numActiveVerticalWire)
-			delete [] numActiveVerticalWire;
-		if (lengthVerticalWire)
-			delete [] lengthVerticalWire;
 		initialized = false;
 		invalid = false;
-		numHorizontalAddressBitToRoute = NULL;  /* The number of horizontal bits to route on level x */
-		numHorizontalDataDistributeBitToRoute = NULL;   /* The number of horizontal data-in bits to route on level x */
-		numHorizontalDataBroadcastBitToRoute = NULL;  /* The number of horizontal data-out bits to route on level x */
-		numHorizontalWire = NULL;		/* The number of horizontal wires on level x */
-		numSumHorizontalWire = NULL;	/* The number of total horizontal wires on level x */
-		numActiveHorizontalWire = NULL;	/* The number of active horizontal wires on level x */
-		lengthHorizontalWire = NULL;	/* The length of horizontal wires on level x, Unit: m */
-		numVerticalAddressBitToRoute = NULL;	/* The number of vertical address bits to route on level x */
-		numVerticalDataDistributeBitToRoute = NULL;  /* The number of vertical data-in bits to route on level x */
-		numVerticalDataBroadcastBitToRoute = NULL; /* The number of vertical data-out bits to route on level x */
-		numVerticalWire = NULL;			/* The number of vertical wires on level x */
-		numSumVerticalWire = NULL;		/* The number of total vertical wires on level x */
-	    numActiveVerticalWire = NULL;	/* The number of active vertical wires on level x */
-		lengthVerticalWire = NULL;		/* The length of vertical wires on level 2, Unit: m */
+		invalidScope = design_scope;
+		matCalculated = false;
 	}
 
 	if (!_internalSenseAmp) {
 		invalid = true;
+		invalidScope = organization_scope;
 		cout << "[Bank] Htree organization does not support external sense amplification scheme" << endl;
 		return;
 	}
@@ -216,23 +138,11 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 
 	levelHorizontal = (int)(log2(numColumnMat)+0.1);
 	levelVertical = (int)(log2(numRowMat)+0.1);
-	if (levelHorizontal > 0) {
-		numHorizontalAddressBitToRoute = new int[levelHorizontal];
-		numHorizontalDataDistributeBitToRoute = new int[levelHorizontal];
-		numHorizontalDataBroadcastBitToRoute = new int[levelHorizontal];
-		numHorizontalWire = new int[levelHorizontal];
-		numSumHorizontalWire = new int[levelHorizontal];
-		numActiveHorizontalWire = new int[levelHorizontal];
-		lengthHorizontalWire = new double[levelHorizontal];
-	}
-	if (levelVertical > 0) {
-		numVerticalAddressBitToRoute = new int[levelVertical];
-		numVerticalDataDistributeBitToRoute = new int[levelVertical];
-		numVerticalDataBroadcastBitToRoute = new int[levelVertical];
-		numVerticalWire = new int[levelVertical];
-		numSumVerticalWire = new int[levelVertical];
-		numActiveVerticalWire = new int[levelVertical];
-		lengthVerticalWire = new double[levelVertical];
+	if (levelHorizontal > MAX_HTREE_LEVEL || levelVertical > MAX_HTREE_LEVEL) {
+		invalid = true;
+		invalidScope = organization_scope;
+		initialized = true;
+		return;
 	}
 
 	/* When H > V */
@@ -248,6 +158,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 	if (h > 0) {
 		if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -267,6 +178,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 	while (h > v) {
 		if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -291,6 +203,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 	while (v > h) {
 		if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -327,6 +240,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 	while (h > 0) {
 		if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -358,6 +272,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		}
 		if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -387,6 +302,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 
 	if (numDataDistributeBitToRoute + numDataBroadcastBitToRoute == 0 || numAddressBitToRoute == 0) {
 		invalid = true;
+		invalidScope = organization_scope;
 		initialized = true;
 		return;
 	}
@@ -404,6 +320,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		if (numRowPerSet > (int)pow(2, numDataBroadcastBitToRoute)) {
 			/* There is no enough ways to distribute into multiple rows */
 			invalid = true;
+			invalidScope = row_per_set_scope;
 			initialized = true;
 			return;
 		}
@@ -414,12 +331,14 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		if (numRowPerSet > 1) {
 			/* tag array cannot have multiple rows to contain ways in a set, otherwise the bitline has to be shared */
 			invalid = true;
+			invalidScope = row_per_set_scope;
 			initialized = true;
 			return;
 		}
 		if (numDataDistributeBitToRoute == 0) {
 			/* This mat does not contain at least one way */
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -435,7 +354,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		int numWayPerRow = numWay / numRowPerSet;	/* At least 1, otherwise it is invalid, and returned already */
 		if (numWayPerRow > 1) {		/* multiple ways per row, needs extra mux level */
 			/* Do mux level recalculation to contain the multiple ways */
-			if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+			if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 				/* for DRAM, mux before sense amp has to be 1, only mux output1 and mux output2 can be used */
 				int numWayPerRowInLog = (int)(log2((double)numWayPerRow) + 0.1);
 				int extraMuxOutputLev2 = (int)pow(2, numWayPerRowInLog / 2);
@@ -462,13 +381,14 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 		numWay = 1;
 	}
 
-	mat.Initialize(numRowSubarray, numColumnSubarray, numAddressBitToRoute, matBlockSize,
+	mat.Initialize(context, numRowSubarray, numColumnSubarray, numAddressBitToRoute, matBlockSize,
 			numWay, numRowPerSet, false, numActiveSubarrayPerRow, numActiveSubarrayPerColumn,
 			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel, memoryType);
 
 	/* Check if mat is under a legal configuration */
 	if (mat.invalid) {
 		invalid = true;
+		invalidScope = mat.invalidScope;
 		initialized = true;
 		return;
 	}
@@ -482,6 +402,7 @@ void BankWithHtree::Initialize(int _numRowMat, int _numColumnMat, long long _cap
 }
 
 void BankWithHtree::CalculateArea() {
+	PROFILE_STAGE(bank_profile, area_stage);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -495,13 +416,13 @@ void BankWithHtree::CalculateArea() {
 		/* Add wire area */
 		int numWireSharingWidth;
 		double effectivePitch;
-		if (globalWire->wireRepeaterType == repeated_none) {
+		if (context->globalWire->wireRepeaterType == repeated_none) {
 			numWireSharingWidth = 1;
 			effectivePitch = 0;		/* assume that the wire is built on another metal layer, there does not cause silicon area */
-			//effectivePitch = globalWire->wirePitch;
+			//effectivePitch = context->globalWire->wirePitch;
 		} else {
-			numWireSharingWidth = (int)floor(globalWire->repeaterSpacing / globalWire->repeaterHeight);
-			effectivePitch = globalWire->repeatedWirePitch;
+			numWireSharingWidth = (int)floor(context->globalWire->repeaterSpacing / context->globalWire->repeaterHeight);
+			effectivePitch = context->globalWire->repeatedWirePitch;
 		}
 
 		for (int i = 0; i < levelHorizontal; i++) {
@@ -577,6 +498,7 @@ void BankWithHtree::CalculateArea() {
 }
 
 void BankWithHtree::CalculateRC() {
+	PROFILE_STAGE(bank_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (!invalid) {
@@ -585,6 +507,7 @@ void BankWithHtree::CalculateRC() {
 }
 
 void BankWithHtree::CalculateLatencyAndPower() {
+	PROFILE_STAGE(bank_profile, latency_and_power_stage);
 	if (!initialized) {
 		cout << "[Bank] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -597,8 +520,7 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		double leakageWire;
 		int beta = 1;	/* Default value is 1. For fast access mode cache, this value is equal to associativity, which means only 1/beta interconnect wires are activated */
 
-		mat.CalculateLatency(1e41 /* means Inf */);
-		mat.CalculatePower();
+		CalculateMatLatencyAndPower();
 		readLatency = mat.readLatency;
 		writeLatency = mat.writeLatency;
 		readDynamicEnergy = mat.readDynamicEnergy * numActiveMatPerRow * numActiveMatPerColumn;
@@ -616,11 +538,11 @@ void BankWithHtree::CalculateLatencyAndPower() {
 		resetDynamicEnergy = mat.resetDynamicEnergy * numActiveMatPerRow * numActiveMatPerColumn;
 		setDynamicEnergy = mat.setDynamicEnergy * numActiveMatPerRow * numActiveMatPerColumn;
 
-		if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode == fast_access_mode)
-			beta = inputParameter->associativity;
+		if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode == fast_access_mode)
+			beta = context->inputParameter->associativity;
 
 		for (int i = 0; i < levelHorizontal; i++) {
-			globalWire->CalculateLatencyAndPower(lengthHorizontalWire[i], &latency, &energy, &leakageWire);
+			context->globalWire->CalculateLatencyAndPower(lengthHorizontalWire[i], &latency, &energy, &leakageWire);
 			readLatency += latency * 2;						/* 2 due to in/out */
 			writeLatency += latency;						/* only in */
 			resetLatency += latency;
@@ -638,7 +560,7 @@ void BankWithHtree::CalculateLatencyAndPower() {
 					numHorizontalDataDistributeBitToRoute[i] + numHorizontalDataBroadcastBitToRoute[i]);
 		}
 		for (int i = 0; i < levelVertical; i++) {
-			globalWire->CalculateLatencyAndPower(lengthVerticalWire[i], &latency, &energy, &leakageWire);
+			context->globalWire->CalculateLatencyAndPower(lengthVerticalWire[i], &latency, &energy, &leakageWire);
 			readLatency += latency * 2;						/* 2 due to in/out */
 			writeLatency += latency;						/* only in */
 			resetLatency += latency;
@@ -657,6 +579,34 @@ void BankWithHtree::CalculateLatencyAndPower() {
 	}
 }
 
+double BankWithHtree::LowerBound(OptimizationTarget _optimizationTarget) {
+	if (_optimizationTarget == area_optimized || !matCalculated)
+		return Bank::LowerBound(_optimizationTarget);
+	/* The H-tree only adds non-negative wire terms to the mat metrics */
+	double readLatencyBound = mat.readLatency;
+	double writeLatencyBound = mat.writeLatency;
+	double readDynamicEnergyBound = mat.readDynamicEnergy * numActiveMatPerRow * numActiveMatPerColumn;
+	double writeDynamicEnergyBound = mat.writeDynamicEnergy * numActiveMatPerRow * numActiveMatPerColumn;
+	switch (_optimizationTarget) {
+	case read_latency_optimized:
+		return readLatencyBound;
+	case write_latency_optimized:
+		return writeLatencyBound;
+	case read_energy_optimized:
+		return readDynamicEnergyBound;
+	case write_energy_optimized:
+		return writeDynamicEnergyBound;
+	case read_edp_optimized:
+		return readLatencyBound * readDynamicEnergyBound;
+	case write_edp_optimized:
+		return writeLatencyBound * writeDynamicEnergyBound;
+	case leakage_optimized:
+		return mat.leakage * numRowMat * numColumnMat;
+	default:	/* Exploration */
+		return 0;
+	}
+}
+
 BankWithHtree & BankWithHtree::operator=(const BankWithHtree &rhs) {
 	Bank::operator=(rhs);
 	levelHorizontal = rhs.levelHorizontal;
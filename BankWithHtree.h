@@ -39,12 +39,13 @@
 #define BANKWITHHTREE_H_
 
 #include "Bank.h"
+#include "constant.h"
 
 class BankWithHtree: public Bank {
 public:
 	BankWithHtree();
 	virtual ~BankWithHtree();
-	void Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
+	void Initialize(SimulationContext *_context, int _numRowMat, int _numColumnMat, long long _capacity,
 			long _blockSize, int _associativity, int _numRowPerSet, int _numActiveMatPerRow,
 			int _numActiveMatPerColumn, int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			int _numRowSubarray, int _numColumnSubarray,
@@ -53,6 +54,7 @@ public:
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatencyAndPower();
+	double LowerBound(OptimizationTarget _optimizationTarget);
 	BankWithHtree & operator=(const BankWithHtree &);
 
 	int numAddressBit;		/* Number of bank address bits */
@@ -61,20 +63,20 @@ public:
 
 	int levelHorizontal;			/* The number of horizontal levels */
 	int levelVertical;				/* The number of vertical levels */
-	int * numHorizontalAddressBitToRoute;  /* The number of horizontal bits to route on level x */
-	int * numHorizontalDataDistributeBitToRoute;	/* The number of horizontal data-in bits to route on level x */
-	int * numHorizontalDataBroadcastBitToRoute;		/* The number of horizontal data-out bits to route on level x */
-	int * numHorizontalWire;        /* The number of horizontal wire tiers on level x */
-	int * numSumHorizontalWire;     /* The number of total horizontal wire groups on level x */
-	int * numActiveHorizontalWire;  /* The number of active horizontal wire groups on level x */
-	double * lengthHorizontalWire;	/* The length of horizontal wires on level x, Unit: m */
-	int * numVerticalAddressBitToRoute;	/* The number of vertical address bits to route on level x */
-	int * numVerticalDataDistributeBitToRoute;	/* The number of vertical data-in bits to route on level x */
-	int * numVerticalDataBroadcastBitToRoute;	/* The number of vertical data-out bits to route on level x */
-	int * numVerticalWire;          /* The number of vertical wire tiers on level x */
-	int * numSumVerticalWire;       /* The number of total vertical wire groups on level x */
-    int * numActiveVerticalWire;    /* The number of active vertical wire groups on level x */
-	double * lengthVerticalWire;	/* The length of vertical wires on level x, Unit: m */
+	int numHorizontalAddressBitToRoute[MAX_HTREE_LEVEL];  /* The number of horizontal bits to route on level x */
+	int numHorizontalDataDistributeBitToRoute[MAX_HTREE_LEVEL];	/* The number of horizontal data-in bits to route on level x */
+	int numHorizontalDataBroadcastBitToRoute[MAX_HTREE_LEVEL];		/* The number of horizontal data-out bits to route on level x */
+	int numHorizontalWire[MAX_HTREE_LEVEL];        /* The number of horizontal wire tiers on level x */
+	int numSumHorizontalWire[MAX_HTREE_LEVEL];     /* The number of total horizontal wire groups on level x */
+	int numActiveHorizontalWire[MAX_HTREE_LEVEL];  /* The number of active horizontal wire groups on level x */
+	double lengthHorizontalWire[MAX_HTREE_LEVEL];	/* The length of horizontal wires on level x, Unit: m */
+	int numVerticalAddressBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical address bits to route on level x */
+	int numVerticalDataDistributeBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical data-in bits to route on level x */
+	int numVerticalDataBroadcastBitToRoute[MAX_HTREE_LEVEL];	/* The number of vertical data-out bits to route on level x */
+	int numVerticalWire[MAX_HTREE_LEVEL];          /* The number of vertical wire tiers on level x */
+	int numSumVerticalWire[MAX_HTREE_LEVEL];       /* The number of total vertical wire groups on level x */
+	int numActiveVerticalWire[MAX_HTREE_LEVEL];    /* The number of active vertical wire groups on level x */
+	double lengthVerticalWire[MAX_HTREE_LEVEL];	/* The length of vertical wires on level x, Unit: m */
 };
 
 #endif /* BANKWITHHTREE_H_ */
@@ -37,7 +37,8 @@
 
 #include "BankWithoutHtree.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 #include <math.h>
 
 BankWithoutHtree::BankWithoutHtree() {
@@ -51,25 +52,31 @@ BankWithoutHtree::~BankWithoutHtree() {
 }
 
 
-void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
+void BankWithoutHtree::Initialize(SimulationContext *_context, int _numRowMat, int _numColumnMat, long long _capacity,
 		long _blockSize, int _associativity, int _numRowPerSet, int _numActiveMatPerRow,
 		int _numActiveMatPerColumn, int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 		int _numRowSubarray, int _numColumnSubarray,
 		int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType) {
+	context = _context;
+	PROFILE_STAGE(bank_profile, initialize_stage);
 	if (initialized) {
 		/* Reset the class for re-initialization */
 		initialized = false;
 		invalid = false;
+		invalidScope = design_scope;
+		matCalculated = false;
 	}
 
 	if (!_internalSenseAmp) {
-		if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 			invalid = true;
+			invalidScope = organization_scope;
 			cout << "[BankWithoutHtree] Error: DRAM does not support external sense amplification!" << endl;
 			return;
-		} else if (globalWire->wireRepeaterType != repeated_none) {
+		} else if (context->globalWire->wireRepeaterType != repeated_none) {
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -136,6 +143,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		if (numRowPerSet > associativity) {
 			/* There is no enough ways to distribute into multiple rows */
 			invalid = true;
+			invalidScope = row_per_set_scope;
 			initialized = true;
 			return;
 		}
@@ -143,7 +151,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		int numWayPerRow = numWay / numRowPerSet;	/* At least 1, otherwise it is invalid, and returned already */
 		if (numWayPerRow > 1) {		/* multiple ways per row, needs extra mux level */
 			/* Do mux level recalculation to contain the multiple ways */
-			if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+			if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 				/* for DRAM, mux before sense amp has to be 1, only mux output1 and mux output2 can be used */
 				int numWayPerRowInLog = (int)(log2((double)numWayPerRow) + 0.1);
 				int extraMuxOutputLev2 = (int)pow(2, numWayPerRowInLog / 2);
@@ -165,6 +173,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		if (numRowPerSet > 1) {
 			/* tag array cannot have multiple rows to contain ways in a set, otherwise the bitline has to be shared */
 			invalid = true;
+			invalidScope = row_per_set_scope;
 			initialized = true;
 			return;
 		}
@@ -173,6 +182,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		if (numWay < 1) {
 			/* This mat does not contain at least one way */
 			invalid = true;
+			invalidScope = organization_scope;
 			initialized = true;
 			return;
 		}
@@ -182,12 +192,13 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 	}
 
 
-	mat.Initialize(numRowSubarray, numColumnSubarray, numAddressBitRouteToMat, numDataBitRouteToMat,
+	mat.Initialize(context, numRowSubarray, numColumnSubarray, numAddressBitRouteToMat, numDataBitRouteToMat,
 			numWay, numRowPerSet, false, numActiveSubarrayPerRow, numActiveSubarrayPerColumn,
 			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel, memoryType);
 	/* Check if mat is under a legal configuration */
 	if (mat.invalid) {
 		invalid = true;
+		invalidScope = mat.invalidScope;
 		initialized = true;
 		return;
 	}
@@ -197,12 +208,12 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 	if (!internalSenseAmp) {
 		bool voltageSense = true;
 		double senseVoltage;
-		senseVoltage = cell->minSenseVoltage;
-		if (cell->memCellType == SRAM) {
+		senseVoltage = context->cell->minSenseVoltage;
+		if (context->cell->memCellType == SRAM) {
 			/* SRAM, DRAM, and eDRAM all use voltage sensing */
 			voltageSense = true;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-			voltageSense = cell->readMode;
+		} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
+			voltageSense = context->cell->readMode;
 		} else {/* NAND flash */
 			// TO-DO
 		}
@@ -213,18 +224,18 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 		else
 			numSenseAmp = blockSize * associativity;
 
-		globalSenseAmp.Initialize(numSenseAmp, !voltageSense, senseVoltage, mat.width * numColumnMat / numSenseAmp);
+		globalSenseAmp.Initialize(context, numSenseAmp, !voltageSense, senseVoltage, mat.width * numColumnMat / numSenseAmp);
 		if (globalSenseAmp.invalid) {
 			invalid = true;
 			initialized = true;
 			return;
 		}
 		globalSenseAmp.CalculateRC();
-		globalBitlineMux.Initialize(numRowMat * numColumnMat / numActiveMatPerColumn / numActiveMatPerRow, numSenseAmp, globalSenseAmp.capLoad, globalSenseAmp.capLoad, 0);
+		globalBitlineMux.Initialize(context, numRowMat * numColumnMat / numActiveMatPerColumn / numActiveMatPerRow, numSenseAmp, globalSenseAmp.capLoad, globalSenseAmp.capLoad, 0);
 		globalBitlineMux.CalculateRC();
 
 		if (memoryType == tag)
-			globalComparator.Initialize(blockSize, 0 /* TO-DO: only for test */);
+			globalComparator.Initialize(context, blockSize, 0 /* TO-DO: only for test */);
 	}
 
 	/* Reset the mux values for correct printing */
@@ -236,6 +247,7 @@ void BankWithoutHtree::Initialize(int _numRowMat, int _numColumnMat, long long _
 }
 
 void BankWithoutHtree::CalculateArea() {
+	PROFILE_STAGE(bank_profile, area_stage);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -246,13 +258,13 @@ void BankWithoutHtree::CalculateArea() {
 
 		int numWireSharingWidth;
 		double effectivePitch;
-		if (globalWire->wireRepeaterType == repeated_none) {
+		if (context->globalWire->wireRepeaterType == repeated_none) {
 			numWireSharingWidth = 1;
 			effectivePitch = 0;		/* assume that the wire is built on another metal layer, there does not cause silicon area */
-			//effectivePitch = globalWire->wirePitch;
+			//effectivePitch = context->globalWire->wirePitch;
 		} else {
-			numWireSharingWidth = (int)floor(globalWire->repeaterSpacing / globalWire->repeaterHeight);
-			effectivePitch = globalWire->repeatedWirePitch;
+			numWireSharingWidth = (int)floor(context->globalWire->repeaterSpacing / context->globalWire->repeaterHeight);
+			effectivePitch = context->globalWire->repeatedWirePitch;
 		}
 
 		width += ceil((double)numRowMat * numColumnMat * numAddressBitRouteToMat / numWireSharingWidth) * effectivePitch;
@@ -282,6 +294,7 @@ void BankWithoutHtree::CalculateArea() {
 }
 
 void BankWithoutHtree::CalculateRC() {
+	PROFILE_STAGE(bank_profile, rc_stage);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (!invalid) {
@@ -296,6 +309,7 @@ void BankWithoutHtree::CalculateRC() {
 }
 
 void BankWithoutHtree::CalculateLatencyAndPower() {
+	PROFILE_STAGE(bank_profile, latency_and_power_stage);
 	if (!initialized) {
 		cout << "[BankWithoutHtree] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -307,8 +321,7 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 		double energy = 0;
 		double leakageWire = 0;
 
-		mat.CalculateLatency(1e41 /* means Inf */);
-		mat.CalculatePower();
+		CalculateMatLatencyAndPower();
 		readLatency = resetLatency = setLatency = writeLatency = 0;
 		readDynamicEnergy = writeDynamicEnergy = resetDynamicEnergy = setDynamicEnergy = 0;
 		leakage = 0;
@@ -319,7 +332,7 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 			lengthWire -= mat.height;
 			if (internalSenseAmp) {
 				double numBitRouteToMat = 0;
-				globalWire->CalculateLatencyAndPower(lengthWire, &latency, &energy, &leakageWire);
+				context->globalWire->CalculateLatencyAndPower(lengthWire, &latency, &energy, &leakageWire);
 				if (i == 0){
 					readLatency += latency;
 					writeLatency += latency;
@@ -340,12 +353,12 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 				resLocalBitline = mat.subarray.resBitline + 3 * resBitlineMux;
 				capLocalBitline = mat.subarray.capBitline + 6 * capBitlineMux;
 				double resGlobalBitline, capGlobalBitline;
-				resGlobalBitline = lengthWire * globalWire->resWirePerUnit;
-				capGlobalBitline = lengthWire * globalWire->capWirePerUnit;
+				resGlobalBitline = lengthWire * context->globalWire->resWirePerUnit;
+				capGlobalBitline = lengthWire * context->globalWire->capWirePerUnit;
 				double capGlobalBitlineMux;
 				capGlobalBitlineMux = globalBitlineMux.capForPreviousDelayCalculation;
-				if (cell->memCellType == SRAM) {
-					double vpre = cell->readVoltage;	/* This value should be equal to resetVoltage and setVoltage for SRAM */
+				if (context->cell->memCellType == SRAM) {
+					double vpre = context->cell->readVoltage;	/* This value should be equal to resetVoltage and setVoltage for SRAM */
 					if (i == 0) {
 						latency = resLocalBitline * capGlobalBitline / 2 +
 								(resLocalBitline + resGlobalBitline) * (capGlobalBitline / 2 + capGlobalBitlineMux);
@@ -359,14 +372,14 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 						readLatency += latency;
 					}
 					if (i <  numActiveMatPerColumn) {
-						energy = capGlobalBitline * tech->vdd * tech->vdd * numAddressBitRouteToMat;
+						energy = capGlobalBitline * context->tech->vdd * context->tech->vdd * numAddressBitRouteToMat;
 						readDynamicEnergy += energy;
 						writeDynamicEnergy += energy;
 						readDynamicEnergy += capGlobalBitline * vpre * vpre * numWay;
 						writeDynamicEnergy += capGlobalBitline * vpre * vpre * numDataBitRouteToMat;
 					}
-				} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-					double vWrite = MAX(fabs(cell->resetVoltage), fabs(cell->setVoltage));
+				} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
+					double vWrite = MAX(fabs(context->cell->resetVoltage), fabs(context->cell->setVoltage));
 					double tau, latencyOff, latencyOn;
 					double vPre = mat.subarray.voltagePrecharge;
 					double vOn = mat.subarray.voltageMemCellOn;
@@ -376,18 +389,18 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 								* (capGlobalBitline + capLocalBitline) / 2 + (resBitlineMux + resGlobalBitline
 										+ resLocalBitline) * capLocalBitline / 2;
 						writeLatency += 0.63 * tau;
-						if (cell->readMode == false) {	/* current-sensing */
+						if (context->cell->readMode == false) {	/* current-sensing */
 							/* Use ICCAD 2009 model */
 							resLocalBitline += mat.subarray.resMemCellOff;
 							tau = resGlobalBitline * capGlobalBitline / 2 *
 									(resLocalBitline + resGlobalBitline / 3) / (resLocalBitline + resGlobalBitline);
 							readLatency += 0.63 * tau;
 						} else {						/* voltage-sensing */
-							if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
+							if (context->cell->readVoltage == 0) {  /* Current-in voltage sensing */
 								resLocalBitline += mat.subarray.resMemCellOn;
 								tau = resLocalBitline * capGlobalBitline + (resLocalBitline + resGlobalBitline) * capGlobalBitline / 2;
 								latencyOn = tau * log((vPre - vOn)/(vPre - vOn - globalSenseAmp.senseVoltage));
-								resLocalBitline += cell->resistanceOff - cell->resistanceOn;
+								resLocalBitline += context->cell->resistanceOff - context->cell->resistanceOn;
 								tau = resLocalBitline * capGlobalBitline + (resLocalBitline + resGlobalBitline) * capGlobalBitline / 2;
 								latencyOff = tau * log((vOff - vPre)/(vOff - vPre - globalSenseAmp.senseVoltage));
 							} else {   /*Voltage-in voltage sensing */
@@ -406,11 +419,11 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 						}
 					}
 					if (i <  numActiveMatPerColumn) {
-						energy = capGlobalBitline * tech->vdd * tech->vdd * numAddressBitRouteToMat;
+						energy = capGlobalBitline * context->tech->vdd * context->tech->vdd * numAddressBitRouteToMat;
 						readDynamicEnergy += energy;
 						writeDynamicEnergy += energy;
 						writeDynamicEnergy += capGlobalBitline * vWrite * vWrite * numDataBitRouteToMat;
-						if (cell->readMode) { /*Voltage-in voltage sensing */
+						if (context->cell->readMode) { /*Voltage-in voltage sensing */
 							readDynamicEnergy += capGlobalBitline * (vPre * vPre - vOn * vOn )* numDataBitRouteToMat;
 						}
 					}
@@ -439,8 +452,8 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 	}
 
 	/* only 1/A wires are activated in fast mode cache write */
-	if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode == fast_access_mode)
-		writeDynamicEnergy /= inputParameter->associativity;
+	if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode == fast_access_mode)
+		writeDynamicEnergy /= context->inputParameter->associativity;
 
 	readLatency += mat.readLatency;
 	resetLatency = writeLatency + mat.resetLatency;
@@ -457,6 +470,15 @@ void BankWithoutHtree::CalculateLatencyAndPower() {
 
 }
 
+void BankWithoutHtree::RecalculateGlobalWire() {
+	if (!internalSenseAmp && context->globalWire->wireRepeaterType != repeated_none) {
+		/* The check of Initialize(), the bank has to be initialized again for the breakdown of the invalid design */
+		invalid = true;
+		return;
+	}
+	Bank::RecalculateGlobalWire();
+}
+
 BankWithoutHtree & BankWithoutHtree::operator=(const BankWithoutHtree &rhs) {
 	Bank::operator=(rhs);
 	numAddressBit = rhs.numAddressBit;
@@ -49,7 +49,7 @@ public:
 	virtual ~BankWithoutHtree();
 
 	/* Functions */
-	void Initialize(int _numRowMat, int _numColumnMat, long long _capacity,
+	void Initialize(SimulationContext *_context, int _numRowMat, int _numColumnMat, long long _capacity,
 			long _blockSize, int _associativity, int _numRowPerSet, int _numActiveMatPerRow,
 			int _numActiveMatPerColumn, int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			int _numRowSubarray, int _numColumnSubarray,
@@ -58,6 +58,7 @@ public:
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatencyAndPower();
+	void RecalculateGlobalWire();
 	BankWithoutHtree & operator=(const BankWithoutHtree &);
 
 	int numAddressBit;		   /* Number of bank address bits */
@@ -37,7 +37,8 @@
 
 #include "BasicDecoder.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 BasicDecoder::BasicDecoder() {
 	// TODO Auto-generated constructor stub
@@ -48,7 +49,9 @@ BasicDecoder::~BasicDecoder() {
 	// TODO Auto-generated destructor stub
 }
 
-void BasicDecoder::Initialize(int _numAddressBit, double _capLoad, double _resLoad){
+void BasicDecoder::Initialize(SimulationContext *_context, int _numAddressBit, double _capLoad, double _resLoad){
+	context = _context;
+	PROFILE_STAGE(basic_decoder_profile, initialize_stage);
 	/*if (initialized)
 			cout << "Warning: Already initialized!" << endl;*/
 	/* might be re-initialized by predecodeblock */
@@ -64,31 +67,32 @@ void BasicDecoder::Initialize(int _numAddressBit, double _capLoad, double _resLo
 	if (numNandInput == 0) {
 		numNandGate = 0;
 		double logicEffortInv = 1;
-		double widthInvN = MIN_NMOS_SIZE * tech->featureSize;
-		double widthInvP = tech->pnSizeRatio * MIN_NMOS_SIZE * tech->featureSize;
-		double capInv = CalculateGateCap(widthInvN, *tech) + CalculateGateCap(widthInvP, *tech);
-		outputDriver.Initialize(logicEffortInv, capInv, capLoad, resLoad, true, latency_first, 0);  /* Always Latency First */
+		double widthInvN = MIN_NMOS_SIZE * context->tech->featureSize;
+		double widthInvP = context->tech->pnSizeRatio * MIN_NMOS_SIZE * context->tech->featureSize;
+		double capInv = CalculateGateCap(widthInvN, context->techView) + CalculateGateCap(widthInvP, context->techView);
+		outputDriver.Initialize(context, logicEffortInv, capInv, capLoad, resLoad, true, latency_first, 0);  /* Always Latency First */
 	}
 	else{
 		double logicEffortNand;
 		double capNand;
 		if (numNandInput == 2) {	/* NAND2 */
 			numNandGate = 4;
-			widthNandN = 2 * MIN_NMOS_SIZE * tech->featureSize;
-			logicEffortNand = (2+tech->pnSizeRatio) / (1+tech->pnSizeRatio);
+			widthNandN = 2 * MIN_NMOS_SIZE * context->tech->featureSize;
+			logicEffortNand = (2+context->tech->pnSizeRatio) / (1+context->tech->pnSizeRatio);
 		} else {					/* NAND3 */
 			numNandGate = 8;
-			widthNandN = 3 * MIN_NMOS_SIZE * tech->featureSize;
-			logicEffortNand = (3+tech->pnSizeRatio) / (1+tech->pnSizeRatio);
+			widthNandN = 3 * MIN_NMOS_SIZE * context->tech->featureSize;
+			logicEffortNand = (3+context->tech->pnSizeRatio) / (1+context->tech->pnSizeRatio);
 		}
-		widthNandP = tech->pnSizeRatio * MIN_NMOS_SIZE * tech->featureSize;
-		capNand = CalculateGateCap(widthNandN, *tech) + CalculateGateCap(widthNandP, *tech);
-		outputDriver.Initialize(logicEffortNand, capNand, capLoad, resLoad, true, latency_first, 0);  /* Always Latency First */
+		widthNandP = context->tech->pnSizeRatio * MIN_NMOS_SIZE * context->tech->featureSize;
+		capNand = CalculateGateCap(widthNandN, context->techView) + CalculateGateCap(widthNandP, context->techView);
+		outputDriver.Initialize(context, logicEffortNand, capNand, capLoad, resLoad, true, latency_first, 0);  /* Always Latency First */
 	}
 	initialized = true;
 }
 
 void BasicDecoder::CalculateArea() {
+	PROFILE_STAGE(basic_decoder_profile, area_stage);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -99,7 +103,7 @@ void BasicDecoder::CalculateArea() {
 		}
 		else {
 			double hNand, wNand;
-			CalculateGateArea(NAND, numNandInput, widthNandN, widthNandP, tech->featureSize*40, *tech, &hNand, &wNand);
+			CalculateGateArea(NAND, numNandInput, widthNandN, widthNandP, context->tech->featureSize*40, context->techView, &hNand, &wNand);
 			height = MAX(hNand, outputDriver.height);
 			width = wNand + outputDriver.width;
 			height *= numNandGate;
@@ -109,17 +113,19 @@ void BasicDecoder::CalculateArea() {
 }
 
 void BasicDecoder::CalculateRC() {
+	PROFILE_STAGE(basic_decoder_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
 		outputDriver.CalculateRC();
 		if (numNandInput > 0) {
-			CalculateGateCapacitance(NAND, numNandInput, widthNandN, widthNandP, tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech, &capNandInput, &capNandOutput);
+			CalculateGateCapacitance(NAND, numNandInput, widthNandN, widthNandP, context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView, &capNandInput, &capNandOutput);
 		}
 	}
 }
 
 void BasicDecoder::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(basic_decoder_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -136,10 +142,10 @@ void BasicDecoder::CalculateLatency(double _rampInput) {
         	double beta;	/* for horowitz calculation */
         	double rampInputForDriver;
 
-        	resPullDown = CalculateOnResistance(widthNandN, NMOS, inputParameter->temperature, *tech) * numNandInput;
+        	resPullDown = CalculateOnResistance(widthNandN, NMOS, context->techView) * numNandInput;
         	capLoad = capNandOutput + outputDriver.capInput[0];
         	tr = resPullDown * capLoad;
-        	gm = CalculateTransconductance(widthNandN, NMOS, *tech);
+        	gm = CalculateTransconductance(widthNandN, NMOS, context->techView);
         	beta = 1 / (resPullDown * gm);
         	readLatency = horowitz(tr, beta, rampInput, &rampInputForDriver);
 
@@ -152,6 +158,7 @@ void BasicDecoder::CalculateLatency(double _rampInput) {
 }
 
 void BasicDecoder::CalculatePower() {
+	PROFILE_STAGE(basic_decoder_profile, power_stage);
 	if (!initialized) {
 		cout << "[Basic Decoder] Error: Require initialization first!" << endl;
 	} else {
@@ -160,20 +167,19 @@ void BasicDecoder::CalculatePower() {
 		if (numNandInput == 0) {
 			leakage = 2 * outputDriver.leakage;
 			capLoad = outputDriver.capInput[0] + outputDriver.capOutput[0];
-			readDynamicEnergy = capLoad * tech->vdd * tech->vdd;
+			readDynamicEnergy = capLoad * context->tech->vdd * context->tech->vdd;
 			readDynamicEnergy += outputDriver.readDynamicEnergy;
 			readDynamicEnergy *= 1;	/* only one row is activated each time */
 			writeDynamicEnergy = readDynamicEnergy;
 
 		} else {
 			/* Leakage power */
-			leakage = CalculateGateLeakage(NAND, numNandInput, widthNandN, widthNandP,
-					inputParameter->temperature, *tech) * tech->vdd;
+			leakage = CalculateGateLeakage(NAND, numNandInput, widthNandN, widthNandP, context->techView) * context->tech->vdd;
 			leakage += outputDriver.leakage;
 			leakage *= numNandGate;
 			/* Dynamic energy */
 			capLoad = capNandOutput + outputDriver.capInput[0];
-			readDynamicEnergy = capLoad * tech->vdd * tech->vdd;
+			readDynamicEnergy = capLoad * context->tech->vdd * context->tech->vdd;
 			readDynamicEnergy += outputDriver.readDynamicEnergy;
 			readDynamicEnergy *= 1;	/* only one row is activated each time */
 			writeDynamicEnergy = readDynamicEnergy;
@@ -48,7 +48,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numAddressBit, double _capLoad, double _resLoad);
+	void Initialize(SimulationContext *_context, int _numAddressBit, double _capLoad, double _resLoad);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Batch.h"
+#include "SimulationContext.h"
+#include "Simulator.h"
+#include <sstream>
+
+Batch::Batch() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	profiler = NULL;
+	cache = NULL;
+	outputFile = NULL;
+	nextRecord = 0;
+}
+
+Batch::~Batch() {
+	// TODO Auto-generated destructor stub
+}
+
+void Batch::Initialize(const string &_manifestFileName) {
+	ifstream manifest(_manifestFileName.c_str());
+	if (!manifest.is_open()) {
+		cout << _manifestFileName << " cannot be found!\n";
+		exit(-1);
+	}
+
+	inputFileName.clear();
+	string line;
+	while (getline(manifest, line)) {
+		size_t comment = line.find('#');
+		if (comment != string::npos)
+			line.erase(comment);
+		size_t begin = line.find_first_not_of(" \t\r");
+		if (begin == string::npos)
+			continue;
+		size_t end = line.find_last_not_of(" \t\r");
+		inputFileName.push_back(line.substr(begin, end - begin + 1));
+	}
+	manifest.close();
+
+	initialized = true;
+}
+
+void Batch::Run(ThreadPool *pool, ostream &_outputFile) {
+	if (!initialized) {
+		cout << "[Batch] Error: Require initialization first!" << endl;
+		return;
+	}
+
+	outputFile = &_outputFile;
+	pendingRecord.assign(inputFileName.size(), string());
+	finishedRecord.assign(inputFileName.size(), false);
+	nextRecord = 0;
+
+	*outputFile << "Configuration,Status,Solutions,Design" << endl;
+	pool->Run(this, (long)inputFileName.size());
+
+	outputFile = NULL;
+	pendingRecord.clear();
+	finishedRecord.clear();
+}
+
+void Batch::Execute(long _index, int _workerId) {
+	stringstream record;
+	record << inputFileName[_index] << ",";
+
+	/* The configuration and its cell are read as text, so a missing or unsupported one only fails its own record */
+	ifstream inputFile(inputFileName[_index].c_str());
+	if (!inputFile.is_open()) {
+		record << "Not Found,0" << endl;
+		Flush(_index, record.str());
+		return;
+	}
+	stringstream inputText;
+	inputText << inputFile.rdbuf();
+	inputFile.close();
+
+	InputParameter inputParameter;
+	inputParameter.ReadInputParameterFromText(inputText.str());
+	ifstream cellFile(inputParameter.fileMemCell.c_str());
+	if (!cellFile.is_open()) {
+		record << "Not Found,0," << inputParameter.fileMemCell << endl;
+		Flush(_index, record.str());
+		return;
+	}
+	stringstream cellText;
+	cellText << cellFile.rdbuf();
+	cellFile.close();
+
+	SimulationContext *context = new SimulationContext();
+	string error;
+	if (!context->InitializeFromText(inputText.str(), cellText.str(), &library, &error)) {
+		record << "Error,0," << error << endl;
+		delete context;
+		Flush(_index, record.str());
+		return;
+	}
+	context->profiler = profiler;
+
+	Simulator simulator;
+	simulator.verbose = false;
+	simulator.Initialize(context);
+
+	string cacheKey;
+	CacheEntry cacheEntry;
+	if (cache)
+		cacheKey = ResultCache::Key(*context->inputParameter, *context->cell);
+	if (cache && cache->Find(cacheKey, &cacheEntry)) {
+		record << cacheEntry.record;
+	} else {
+		ThreadPool serialPool;	/* The configurations are the parallel tasks */
+		serialPool.Initialize(1);
+		stringstream exploration;
+		if (simulator.Run(&serialPool, &exploration)) {
+			stringstream result;
+			simulator.PrintToCsvFile(result);
+			record << result.str();
+			cacheEntry.record = result.str();
+			cacheEntry.exploration = exploration.str();
+			if (cache)
+				cache->Store(cacheKey, cacheEntry);
+		} else {
+			record << "Not Supported,0" << endl;
+		}
+	}
+	if (!cacheEntry.exploration.empty()) {
+		explorationLock.lock();
+		ofstream explorationFile(simulator.OutputFileName().c_str(), ofstream::app);
+		explorationFile << cacheEntry.exploration;
+		explorationFile.close();
+		explorationLock.unlock();
+	}
+
+	context->profiler = NULL;	/* Owned by the batch */
+	delete context;
+	Flush(_index, record.str());
+}
+
+void Batch::Flush(long _index, const string &_record) {
+	outputLock.lock();
+	pendingRecord[_index] = _record;
+	finishedRecord[_index] = true;
+	while (nextRecord < (long)finishedRecord.size() && finishedRecord[nextRecord]) {
+		*outputFile << pendingRecord[nextRecord];
+		outputFile->flush();
+		pendingRecord[nextRecord].clear();
+		nextRecord++;
+	}
+	outputLock.unlock();
+}
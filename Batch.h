@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <iostream>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+#include "ModelLibrary.h"
+#include "Profiler.h"
+#include "ResultCache.h"
+
+using namespace std;
+
+/* Runs the configurations listed in a manifest in one process. The configurations are
+ * the parallel tasks, each one is simulated on a single thread. They share the technology,
+ * wire and subarray models through a ModelLibrary, and each one writes a single CSV record;
+ * the records are written in the manifest order. */
+class Batch: public ParallelTask {
+public:
+	Batch();
+	virtual ~Batch();
+
+	/* Functions */
+	void Initialize(const string &_manifestFileName);	/* One .cfg file per line, '#' starts a comment */
+	void Run(ThreadPool *pool, ostream &outputFile);
+	void Execute(long _index, int _workerId);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	vector<string> inputFileName;	/* The configurations of the manifest */
+	ModelLibrary library;
+	Profiler *profiler;	/* Shared by all the configurations, NULL if not profiled */
+	ResultCache *cache;	/* The results of the earlier runs, NULL if not cached */
+
+private:
+	void Flush(long _index, const string &_record);	/* Write the finished records in the manifest order */
+
+	ostream *outputFile;
+	mutex outputLock;
+	vector<string> pendingRecord;
+	vector<bool> finishedRecord;
+	long nextRecord;
+	mutex explorationLock;	/* Serializes the appends to the exploration CSV files */
+};
+
+#endif /* BATCH_H_ */
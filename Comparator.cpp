@@ -36,7 +36,8 @@
 
 
 #include "Comparator.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 #include "formula.h"
 #include <math.h>
 
@@ -52,27 +53,30 @@ Comparator::~Comparator() {
 	// TODO Auto-generated destructor stub
 }
 
-void Comparator::Initialize(int _numTagBits, double _capLoad){
+void Comparator::Initialize(SimulationContext *_context, int _numTagBits, double _capLoad){
+	context = _context;
+	PROFILE_STAGE(comparator_profile, initialize_stage);
 	if (initialized)
 		cout << "[Comparator] Warning: Already initialized!" << endl;
 
 	numTagBits = _numTagBits / 4;  /* Assuming there are 4 quarter comparators. input tagbits is already a multiple of 4 */
 	capLoad = _capLoad;
-	widthNMOSInv[0] = 7.5 * tech->featureSize;
-	widthPMOSInv[0] = 12.5 * tech->featureSize;
-	widthNMOSInv[1] = 15 * tech->featureSize;
-	widthPMOSInv[1] = 25 * tech->featureSize;
-	widthNMOSInv[2] = 30 * tech->featureSize;
-	widthPMOSInv[2] = 50 * tech->featureSize;
-	widthNMOSInv[3] = 50 * tech->featureSize;
-	widthPMOSInv[3] = 100 * tech->featureSize;
-	widthNMOSComp = 12.5 * tech->featureSize;
-	widthPMOSComp = 37.5 * tech->featureSize;
+	widthNMOSInv[0] = 7.5 * context->tech->featureSize;
+	widthPMOSInv[0] = 12.5 * context->tech->featureSize;
+	widthNMOSInv[1] = 15 * context->tech->featureSize;
+	widthPMOSInv[1] = 25 * context->tech->featureSize;
+	widthNMOSInv[2] = 30 * context->tech->featureSize;
+	widthPMOSInv[2] = 50 * context->tech->featureSize;
+	widthNMOSInv[3] = 50 * context->tech->featureSize;
+	widthPMOSInv[3] = 100 * context->tech->featureSize;
+	widthNMOSComp = 12.5 * context->tech->featureSize;
+	widthPMOSComp = 37.5 * context->tech->featureSize;
 
 	initialized = true;
 }
 
 void Comparator::CalculateArea() {
+	PROFILE_STAGE(comparator_profile, area_stage);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -80,11 +84,11 @@ void Comparator::CalculateArea() {
 		double totalWidth = 0;
 		double h, w;
 		for (int i = 0; i < COMPARATOR_INV_CHAIN_LEN; i++) {
-			CalculateGateArea(INV, 1, widthNMOSInv[i], widthPMOSInv[i], tech->featureSize*40, *tech, &h, &w);
+			CalculateGateArea(INV, 1, widthNMOSInv[i], widthPMOSInv[i], context->tech->featureSize*40, context->techView, &h, &w);
 			totalHeight = MAX(totalHeight, h);
 			totalWidth += w;
 		}
-		CalculateGateArea(NAND, 2, widthNMOSComp, 0, tech->featureSize*40, *tech, &h, &w);
+		CalculateGateArea(NAND, 2, widthNMOSComp, 0, context->tech->featureSize*40, context->techView, &h, &w);
 		totalHeight += h;
 		totalWidth = MAX(totalWidth, numTagBits * w);
 		height = totalHeight * 1; // 4 quarter comparators can have different placement, here assumes 1*4
@@ -94,22 +98,24 @@ void Comparator::CalculateArea() {
 }
 
 void Comparator::CalculateRC() {
+	PROFILE_STAGE(comparator_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
 		for (int i = 0; i < COMPARATOR_INV_CHAIN_LEN; i++) {
-			CalculateGateCapacitance(INV, 1, widthNMOSInv[i], widthPMOSInv[i], tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech, &(capInput[i]), &(capOutput[i]));
+			CalculateGateCapacitance(INV, 1, widthNMOSInv[i], widthPMOSInv[i], context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView, &(capInput[i]), &(capOutput[i]));
 		}
 		double capComp, capTemp;
-		CalculateGateCapacitance(NAND, 2, widthNMOSComp, 0, tech->featureSize*40, *tech, &capTemp, &capComp);
+		CalculateGateCapacitance(NAND, 2, widthNMOSComp, 0, context->tech->featureSize*40, context->techView, &capTemp, &capComp);
 		capBottom = capOutput[COMPARATOR_INV_CHAIN_LEN-1] + numTagBits * capComp;
-		capTop = numTagBits * capComp + CalculateDrainCap(widthPMOSComp, PMOS, tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech) + capLoad;
-		resBottom = CalculateOnResistance(widthNMOSInv[COMPARATOR_INV_CHAIN_LEN-1], NMOS, inputParameter->temperature, *tech);
-		resTop = 2 * CalculateOnResistance(widthNMOSComp, NMOS, inputParameter->temperature, *tech);
+		capTop = numTagBits * capComp + CalculateDrainCap(widthPMOSComp, PMOS, context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView) + capLoad;
+		resBottom = CalculateOnResistance(widthNMOSInv[COMPARATOR_INV_CHAIN_LEN-1], NMOS, context->techView);
+		resTop = 2 * CalculateOnResistance(widthNMOSComp, NMOS, context->techView);
 	}
 }
 
 void Comparator::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(comparator_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
@@ -122,10 +128,10 @@ void Comparator::CalculateLatency(double _rampInput) {
 		double temp;
 		readLatency = 0;
 		for (int i = 0; i < COMPARATOR_INV_CHAIN_LEN - 1; i++) {
-			resPullDown = CalculateOnResistance(widthNMOSInv[i], NMOS, inputParameter->temperature, *tech);
+			resPullDown = CalculateOnResistance(widthNMOSInv[i], NMOS, context->techView);
 			capNode = capOutput[i] + capInput[i+1];
 			tr = resPullDown * capNode;
-			gm = CalculateTransconductance(widthNMOSInv[i], NMOS, *tech);
+			gm = CalculateTransconductance(widthNMOSInv[i], NMOS, context->techView);
 			beta = 1 / (resPullDown * gm);
 			readLatency += horowitz(tr, beta, rampInput, &temp);
 			rampInput = temp;	/* for next stage */
@@ -138,26 +144,27 @@ void Comparator::CalculateLatency(double _rampInput) {
 }
 
 void Comparator::CalculatePower() {
+	PROFILE_STAGE(comparator_profile, power_stage);
 	if (!initialized) {
 		cout << "[Comparator] Error: Require initialization first!" << endl;
 	} else {
 		/* Leakage power */
 		leakage = 0;
 		for (int i = 0; i < COMPARATOR_INV_CHAIN_LEN; i++) {
-			leakage += CalculateGateLeakage(INV, 1, widthNMOSInv[i], widthPMOSInv[i], inputParameter->temperature, *tech)
-					* tech->vdd;
+			leakage += CalculateGateLeakage(INV, 1, widthNMOSInv[i], widthPMOSInv[i], context->techView)
+					* context->tech->vdd;
 		}
-		leakage += numTagBits * CalculateGateLeakage(NAND, 2, widthNMOSComp, 0, inputParameter->temperature, *tech)
-				* tech->vdd;
+		leakage += numTagBits * CalculateGateLeakage(NAND, 2, widthNMOSComp, 0, context->techView)
+				* context->tech->vdd;
 		leakage *= 4;
 		/* Dynamic energy */
 		readDynamicEnergy = 0;
 		double capNode;
 		for (int i = 0; i < COMPARATOR_INV_CHAIN_LEN - 1; i++) {
 			capNode = capOutput[i] + capInput[i+1];
-			readDynamicEnergy += capNode * tech->vdd * tech->vdd;
+			readDynamicEnergy += capNode * context->tech->vdd * context->tech->vdd;
 		}
-		readDynamicEnergy += (capBottom + capTop) * tech->vdd * tech->vdd;
+		readDynamicEnergy += (capBottom + capTop) * context->tech->vdd * context->tech->vdd;
 		readDynamicEnergy *= 4;
 		writeDynamicEnergy = readDynamicEnergy;
 	}
@@ -184,6 +191,7 @@ Comparator & Comparator::operator=(const Comparator &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	numTagBits = rhs.numTagBits;
 	capLoad = rhs.capLoad;
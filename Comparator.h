@@ -48,7 +48,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numTagBits, double _capLoad);
+	void Initialize(SimulationContext *_context, int _numTagBits, double _capLoad);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
@@ -0,0 +1,545 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Explorer.h"
+#include "SimulationContext.h"
+#include "formula.h"
+#include "macros.h"
+
+#include <sstream>
+#include <new>
+
+Explorer::Explorer() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	context = NULL;
+	limitCandidate = false;
+	outputFile = NULL;
+	tagResults = NULL;
+	frontier = NULL;
+	boundTarget = full_exploration;
+	numShard = 0;
+	shardIndex = 0;
+	progress = NULL;
+	topK = NULL;
+	numPeripheralPoint = 0;
+	numWorker = 0;
+	workerResults = NULL;
+	workerSolution = NULL;
+	workerFrontier = NULL;
+	workerTopK = NULL;
+	workerTempResults = NULL;
+	workerBankStorage = NULL;
+	nextOutput = 0;
+}
+
+Explorer::~Explorer() {
+	// TODO Auto-generated destructor stub
+}
+
+void Explorer::Initialize(SimulationContext *_context, const SearchSpace &_space, MemoryType _memoryType, long long _capacity, long _blockSize, int _associativity) {
+	context = _context;
+	space = _space;
+	memoryType = _memoryType;
+	bankCapacity = _capacity;
+	bankBlockSize = _blockSize;
+	bankAssociativity = _associativity;
+	initialized = true;
+}
+
+long long Explorer::Explore(ThreadPool *pool, Result *bestResults, bool _limitCandidate,
+		ostream *_outputFile, Result *_tagResults, ParetoFrontier *_frontier) {
+	if (!initialized) {
+		cout << "[Explorer] Error: Require initialization first!" << endl;
+		return 0;
+	}
+	PROFILE_STAGE(explorer_profile, run_stage);
+	long numItem = Start(pool, bestResults, _limitCandidate, _outputFile, _tagResults, _frontier);
+	pool->Run(this, numItem);
+	return Finish(bestResults);
+}
+
+long Explorer::Start(ThreadPool *pool, Result *bestResults, bool _limitCandidate,
+		ostream *_outputFile, Result *_tagResults, ParetoFrontier *_frontier) {
+	limitCandidate = _limitCandidate;
+	outputFile = _outputFile;
+	tagResults = _tagResults;
+	frontier = _frontier;
+
+	space.GetOrganizations(organizations);
+	numPeripheralPoint = space.NumPeripheralPoint(context->inputParameter->associativity);
+
+	/* The cell write energy is lazily computed by the subarrays, do it once before the workers share the cell */
+	if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM)
+		context->cell->CalculateWriteEnergy(context->tech->vdd);
+
+	numWorker = pool->numThread;
+	workerResults = new Result[numWorker * (int)full_exploration];
+	workerSolution = new long long[numWorker];
+	workerTempResults = new Result[numWorker];
+	workerBankStorage = new char[numWorker * BANK_STORAGE_SIZE];
+	if (frontier)
+		workerFrontier = new ParetoFrontier[numWorker];
+	if (topK) {
+		workerTopK = new TopKCollector[numWorker * (int)full_exploration];
+		for (int w = 0; w < numWorker; w++)
+			for (int i = 0; i < (int)full_exploration; i++)
+				workerTopK[w * (int)full_exploration + i].Initialize(topK[i].k);
+	}
+	for (int w = 0; w < numWorker; w++) {
+		workerSolution[w] = 0;
+		workerTempResults[w].Initialize(context);
+		for (int i = 0; i < (int)full_exploration; i++) {
+			Result &result = workerResults[w * (int)full_exploration + i];
+			result.Initialize(context);
+			result.optimizationTarget = bestResults[i].optimizationTarget;
+			result.limitReadLatency = bestResults[i].limitReadLatency;
+			result.limitWriteLatency = bestResults[i].limitWriteLatency;
+			result.limitReadDynamicEnergy = bestResults[i].limitReadDynamicEnergy;
+			result.limitWriteDynamicEnergy = bestResults[i].limitWriteDynamicEnergy;
+			result.limitReadEdp = bestResults[i].limitReadEdp;
+			result.limitWriteEdp = bestResults[i].limitWriteEdp;
+			result.limitArea = bestResults[i].limitArea;
+			result.limitLeakage = bestResults[i].limitLeakage;
+			result.limitHeight = bestResults[i].limitHeight;
+			result.limitWidth = bestResults[i].limitWidth;
+			result.limitAspectRatio = bestResults[i].limitAspectRatio;
+		}
+	}
+
+	long numItem = SearchSpace::NumShardItem((long)organizations.size(), shardIndex, numShard);
+	if (progress && progress->timeBudget > 0)
+		SearchSpace::GetSpreadOrder(numItem, order);	/* Good designs of every part of the space are met early */
+	else
+		order.clear();
+	if (outputFile) {
+		pendingOutput.assign(numItem, string());
+		finishedOutput.assign(numItem, false);
+		nextOutput = 0;
+	}
+	return numItem;
+}
+
+long long Explorer::Finish(Result *bestResults) {
+	/* Deterministic merge: the sequence number breaks the ties exactly as the serial order does */
+	long long numSolution = 0;
+	for (int w = 0; w < numWorker && bestResults; w++) {
+		numSolution += workerSolution[w];
+		for (int i = 0; i < (int)full_exploration; i++)
+			bestResults[i].compareAndUpdate(workerResults[w * (int)full_exploration + i]);
+		if (frontier)
+			frontier->Merge(workerFrontier[w]);
+		if (topK)
+			for (int i = 0; i < (int)full_exploration; i++)
+				topK[i].Merge(workerTopK[w * (int)full_exploration + i]);
+	}
+	if (bestResults && boundTarget != full_exploration && bestResults[boundTarget].sequence >= 0)
+		bestResults[boundTarget].materialize();	/* Only the metrics of its target may be calculated */
+
+	delete [] workerResults;
+	delete [] workerSolution;
+	delete [] workerTempResults;
+	delete [] workerBankStorage;
+	workerResults = NULL;
+	workerSolution = NULL;
+	workerTempResults = NULL;
+	workerBankStorage = NULL;
+	if (workerFrontier)
+		delete [] workerFrontier;
+	workerFrontier = NULL;
+	if (workerTopK)
+		delete [] workerTopK;
+	workerTopK = NULL;
+	pendingOutput.clear();
+	finishedOutput.clear();
+
+	return numSolution;
+}
+
+void Explorer::Execute(long _index, int _workerId) {
+	long item = order.empty() ? SearchSpace::ShardItem(_index, shardIndex, numShard) : order[_index];
+	const DesignPoint &organization = organizations[item];
+	int numRowMat = organization.numRowMat;
+	int numColumnMat = organization.numColumnMat;
+	int numActiveMatPerRow = organization.numActiveMatPerRow;
+	int numActiveMatPerColumn = organization.numActiveMatPerColumn;
+	int numRowSubarray = organization.numRowSubarray;
+	int numColumnSubarray = organization.numColumnSubarray;
+	int numActiveSubarrayPerRow = organization.numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn = organization.numActiveSubarrayPerColumn;
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;
+
+	long long capacity;
+	long blockSize;
+	int associativity;
+	int numActiveSubarray = numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn;
+
+	if (!GetBankSize(numActiveSubarray, &capacity, &blockSize, &associativity)) {
+		/* To aggressive partitioning */
+		PROFILE_EVENT(aggressive_partitioning_event);
+		if (outputFile)
+			Flush(_index, string());
+		if (progress)
+			progress->Add(numPeripheralPoint, 0);
+		return;
+	}
+
+	Result *bestResults = workerResults + _workerId * (int)full_exploration;
+	TopKCollector *collectors = topK ? workerTopK + _workerId * (int)full_exploration : NULL;
+	Result &tempResult = workerTempResults[_workerId];
+	char *bankStorage = workerBankStorage + _workerId * BANK_STORAGE_SIZE;
+	stringstream output;
+	long long sequence = (long long)item * numPeripheralPoint;
+	Bank *bank;
+
+	/* The later points in the InvalidScope of an invalid design are skipped. For mux_scope, the smallest mux
+	 * degree that failed is kept for each numRowPerSet */
+	int overflowRowPerSet[MAX_ROW_PER_SET_STEP], overflowMux[MAX_ROW_PER_SET_STEP];
+	int numOverflow = 0;
+	int invalidRowPerSet = 0;		/* The smallest numRowPerSet that failed with row_per_set_scope, 0 if none */
+	bool invalidAreaLevel = false;	/* The last design failed with area_level_scope */
+	bool invalidOrganization = false;
+	long long numVisited = 0, numValid = 0;		/* For the progress */
+
+	PERIPHERAL_FORLOOP(space, context->inputParameter->associativity) {
+		if (progress && progress->Expired())
+			continue;	/* The rest of the work item is skipped */
+		PROFILE_EVENT(design_point_event);
+		numVisited++;
+		if (areaOptimizationLevel == space.minAreaOptimizationLevel)
+			invalidAreaLevel = false;	/* Other mux degrees or numRowPerSet */
+		if (invalidOrganization || invalidAreaLevel || (invalidRowPerSet > 0 && numRowPerSet >= invalidRowPerSet)) {
+			PROFILE_EVENT(invalid_scope_event);
+			sequence++;
+			continue;
+		}
+		int overflow = 0;
+		while (overflow < numOverflow && overflowRowPerSet[overflow] != numRowPerSet)
+			overflow++;
+		if (overflow < numOverflow && muxSenseAmp * muxOutputLev1 * muxOutputLev2 >= overflowMux[overflow]) {
+			PROFILE_EVENT(mux_overflow_event);
+			sequence++;
+			continue;
+		}
+		/* The candidates of a worker are built one after another in the same storage instead of the heap */
+		INITIALIZE_BANK_AT(bank, bankStorage, memoryType);
+		if (bank->invalid) {
+			switch (bank->invalidScope) {
+			case organization_scope:
+				invalidOrganization = true;
+				break;
+			case row_per_set_scope:
+				invalidRowPerSet = numRowPerSet;	/* The smaller ones are not skipped, so it only decreases */
+				break;
+			case mux_scope:
+				if (overflow < MAX_ROW_PER_SET_STEP) {
+					overflowRowPerSet[overflow] = numRowPerSet;
+					overflowMux[overflow] = muxSenseAmp * muxOutputLev1 * muxOutputLev2;
+					if (overflow == numOverflow)
+						numOverflow++;
+				}
+				break;
+			case area_level_scope:
+				invalidAreaLevel = true;
+				break;
+			default:
+				break;
+			}
+		}
+		bool valid = Calculate(bank, bestResults, collectors);	/* The rejected designs are counted by Calculate() */
+		if (valid && limitCandidate && !bestResults[0].checkLimit(bank)) {
+			PROFILE_EVENT(constraint_event);
+			valid = false;
+		}
+		if (valid) {
+			PROFILE_EVENT(solution_event);
+			VERIFY_CAPACITY(bank);
+			workerSolution[_workerId]++;
+			numValid++;
+			tempResult.store(bank);
+			tempResult.localWire = context->localWire;
+			tempResult.globalWire = context->globalWire;
+			tempResult.sequence = sequence;
+			if (boundTarget == full_exploration) {
+				for (int i = 0; i < (int)full_exploration; i++)
+					bestResults[i].compareAndUpdate(tempResult);
+			} else {
+				bestResults[boundTarget].compareAndUpdate(tempResult);	/* The others are bounded away */
+			}
+			if (progress && memoryType != tag)
+				OfferProgress(bestResults, sequence);
+			DesignPoint design = organization;
+			design.muxSenseAmp = muxSenseAmp;
+			design.muxOutputLev1 = muxOutputLev1;
+			design.muxOutputLev2 = muxOutputLev2;
+			design.numRowPerSet = numRowPerSet;
+			design.areaOptimizationLevel = areaOptimizationLevel;
+			if (frontier) {
+				ParetoPoint point;
+				bank->GetObjective(point.objective);
+				point.sequence = sequence;
+				point.design = design;
+				workerFrontier[_workerId].Insert(point);
+			}
+			if (collectors) {
+				double objective[(int)num_objective];
+				tempResult.getObjective(objective);
+				for (int i = 0; i < (int)full_exploration; i++) {
+					if (boundTarget != full_exploration && i != (int)boundTarget)
+						continue;	/* Not calculated */
+					TopKPoint point;
+					point.value = ParetoFrontier::TargetValue(objective, (OptimizationTarget)i);
+					point.sequence = sequence;
+					point.design = design;
+					collectors[i].Offer(point);
+				}
+			}
+			if (outputFile) {
+				tempResult.bank = bank;	/* Lent for the breakdown of the row */
+				if (tagResults) {
+					for (int i = 0; i < (int)full_exploration; i++)
+						tempResult.printAsCacheToCsvFile(tagResults[i], context->inputParameter->cacheAccessMode, output);
+				} else {
+					tempResult.printToCsvFile(output);
+					output << endl;
+				}
+				tempResult.bank = NULL;
+			}
+		}
+		bank->~Bank();
+		sequence++;
+	}
+
+	if (progress)
+		progress->Add(numVisited, numValid);
+	if (outputFile)
+		Flush(_index, output.str());
+}
+
+void Explorer::OfferProgress(Result *_bestResults, long long _sequence) {
+	for (int i = 0; i < (int)full_exploration; i++) {
+		if (_bestResults[i].sequence != _sequence)
+			continue;	/* Not improved by this design */
+		double objective[(int)num_objective];
+		_bestResults[i].getObjective(objective);
+		progress->Offer((OptimizationTarget)i, ParetoFrontier::TargetValue(objective, (OptimizationTarget)i));
+	}
+}
+
+bool Explorer::Calculate(Bank *_bank, Result *_bestResults, TopKCollector *_topK) {
+	/* The stages run from the cheapest, and each one can reject the candidate before the next. The validity
+	 * and the area are final after CalculateArea(), the mat metrics bound the others from below */
+	_bank->CalculateArea();
+	if (_bank->invalid) {
+		PROFILE_EVENT(invalid_bank_event);
+		return false;
+	}
+	if (!_bestResults[0].checkShape(_bank->height, _bank->width)) {
+		PROFILE_EVENT(shape_event);
+		return false;	/* Does not fit the floorplan, whatever its latency and power */
+	}
+
+	/* Branch and bound: a candidate whose lower bound is above the incumbent cannot win, not even a tie.
+	 * When the k best designs are collected, the incumbent is the worst of them */
+	double bestValue = 0;
+	if (boundTarget != full_exploration) {
+		if (_topK) {
+			bestValue = _topK[boundTarget].Threshold();
+		} else {
+			double objective[(int)num_objective];
+			_bestResults[boundTarget].getObjective(objective);
+			bestValue = ParetoFrontier::TargetValue(objective, boundTarget);
+		}
+		if (_bank->LowerBound(boundTarget) > bestValue) {
+			PROFILE_EVENT(area_bound_event);
+			return false;
+		}
+	}
+	if (limitCandidate && !MeetLimit(_bank, _bestResults[0])) {
+		PROFILE_EVENT(constraint_event);
+		return false;
+	}
+	if (boundTarget == area_optimized)
+		return true;	/* Only the target is compared, the record of the winner is completed by Explore() */
+
+	/* The latency targets do not need the mat power */
+	_bank->latencyOnly = (boundTarget == read_latency_optimized || boundTarget == write_latency_optimized) && !limitCandidate;
+	_bank->CalculateRC();
+	_bank->CalculateMatLatencyAndPower();
+	if (boundTarget != full_exploration && _bank->LowerBound(boundTarget) > bestValue) {
+		PROFILE_EVENT(mat_bound_event);
+		return false;
+	}
+	if (limitCandidate && !MeetLimit(_bank, _bestResults[0])) {
+		PROFILE_EVENT(constraint_event);
+		return false;
+	}
+	_bank->CalculateLatencyAndPower();
+	if (_bank->invalid) {
+		PROFILE_EVENT(invalid_bank_event);
+		return false;
+	}
+	return true;
+}
+
+bool Explorer::MeetLimit(Bank *_bank, Result &_constraint) {
+	return _bank->LowerBound(read_latency_optimized) <= _constraint.limitReadLatency
+			&& _bank->LowerBound(write_latency_optimized) <= _constraint.limitWriteLatency
+			&& _bank->LowerBound(read_energy_optimized) <= _constraint.limitReadDynamicEnergy
+			&& _bank->LowerBound(write_energy_optimized) <= _constraint.limitWriteDynamicEnergy
+			&& _bank->LowerBound(read_edp_optimized) <= _constraint.limitReadEdp
+			&& _bank->LowerBound(write_edp_optimized) <= _constraint.limitWriteEdp
+			&& _bank->LowerBound(area_optimized) <= _constraint.limitArea
+			&& _bank->LowerBound(leakage_optimized) <= _constraint.limitLeakage;
+}
+
+void Explorer::Flush(long _index, const string &_output) {
+	outputLock.lock();
+	pendingOutput[_index] = _output;
+	finishedOutput[_index] = true;
+	while (nextOutput < (long)finishedOutput.size() && finishedOutput[nextOutput]) {
+		if (numShard > 0 && !pendingOutput[nextOutput].empty())
+			*outputFile << "Item " << SearchSpace::ShardItem(nextOutput, shardIndex, numShard) << " " << pendingOutput[nextOutput].size() << endl;
+		*outputFile << pendingOutput[nextOutput];
+		pendingOutput[nextOutput].clear();
+		nextOutput++;
+	}
+	outputLock.unlock();
+}
+
+void Explorer::Materialize(const ParetoPoint &_point, Result *_result) {
+	Evaluate(_point.design, _result);
+	_result->sequence = _point.sequence;
+}
+
+bool Explorer::Evaluate(const DesignPoint &_design, Result *_result) {
+	int numRowMat = _design.numRowMat;
+	int numColumnMat = _design.numColumnMat;
+	int numActiveMatPerRow = _design.numActiveMatPerRow;
+	int numActiveMatPerColumn = _design.numActiveMatPerColumn;
+	int numRowSubarray = _design.numRowSubarray;
+	int numColumnSubarray = _design.numColumnSubarray;
+	int numActiveSubarrayPerRow = _design.numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn = _design.numActiveSubarrayPerColumn;
+	int muxSenseAmp = _design.muxSenseAmp;
+	int muxOutputLev1 = _design.muxOutputLev1;
+	int muxOutputLev2 = _design.muxOutputLev2;
+	int numRowPerSet = _design.numRowPerSet;
+	int areaOptimizationLevel = _design.areaOptimizationLevel;
+
+	long long capacity;
+	long blockSize;
+	int associativity;
+	if (!GetBankSize(numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn,
+			&capacity, &blockSize, &associativity))
+		return false;
+
+	if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM)
+		context->cell->CalculateWriteEnergy(context->tech->vdd);
+
+	Bank *bank;
+	CALCULATE(bank, memoryType);
+	bool valid = !bank->invalid;
+	_result->adopt(bank);
+	_result->localWire = context->localWire;
+	_result->globalWire = context->globalWire;
+	_result->sequence = -1;
+	return valid;
+}
+
+bool Explorer::GetBankSize(int _numActiveSubarray, long long *_capacity, long *_blockSize, int *_associativity) {
+	*_capacity = bankCapacity;
+	*_blockSize = bankBlockSize;
+	*_associativity = bankAssociativity;
+	if (*_blockSize / _numActiveSubarray == 0)
+		return false;
+	if (memoryType == tag) {
+		if (*_blockSize % _numActiveSubarray)
+			*_blockSize = (*_blockSize / _numActiveSubarray + 1) * _numActiveSubarray;
+		*_capacity = (long long)context->inputParameter->capacity * 8 / context->inputParameter->wordWidth * *_blockSize;
+		*_associativity = context->inputParameter->associativity;
+	}
+	return true;
+}
+
+ExplorerPair::ExplorerPair() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	first = second = NULL;
+	numFirstItem = numSecondItem = 0;
+	interleaved = false;
+}
+
+ExplorerPair::~ExplorerPair() {
+	// TODO Auto-generated destructor stub
+}
+
+void ExplorerPair::Initialize(Explorer *_first, long _numFirstItem, Explorer *_second, long _numSecondItem) {
+	first = _first;
+	numFirstItem = _numFirstItem;
+	second = _second;
+	numSecondItem = _numSecondItem;
+	initialized = true;
+}
+
+void ExplorerPair::Run(ThreadPool *pool) {
+	if (!initialized) {
+		cout << "[ExplorerPair] Error: Require initialization first!" << endl;
+		return;
+	}
+	SimulationContext *context = first->context;	/* for the macros */
+	PROFILE_STAGE(explorer_profile, run_stage);
+	pool->Run(this, numFirstItem + numSecondItem);
+}
+
+void ExplorerPair::Execute(long _index, int _workerId) {
+	if (interleaved) {
+		/* Index _index is a first item if it raises the share of the first items that are due */
+		long numItem = numFirstItem + numSecondItem;
+		long numFirstBefore = (long)((double)_index * numFirstItem / numItem);
+		long numFirstAfter = (long)((double)(_index + 1) * numFirstItem / numItem);
+		if (numFirstAfter > numFirstBefore)
+			first->Execute(numFirstBefore, _workerId);
+		else
+			second->Execute(_index - numFirstBefore, _workerId);
+	} else if (_index < numFirstItem) {
+		first->Execute(_index, _workerId);
+	} else {
+		second->Execute(_index - numFirstItem, _workerId);
+	}
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef EXPLORER_H_
+#define EXPLORER_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include "ThreadPool.h"
+#include "Result.h"
+#include "ParetoFrontier.h"
+#include "SearchSpace.h"
+#include "Progress.h"
+#include "TopKCollector.h"
+#include "typedef.h"
+
+using namespace std;
+
+class Explorer: public ParallelTask {
+public:
+	Explorer();
+	virtual ~Explorer();
+
+	/* Functions */
+	void Initialize(SimulationContext *_context, const SearchSpace &_space, MemoryType _memoryType, long long _capacity, long _blockSize, int _associativity);
+	long long Explore(ThreadPool *pool, Result *bestResults, bool _limitCandidate,
+			ostream *_outputFile, Result *_tagResults, ParetoFrontier *_frontier);	/* Return the number of valid solutions */
+	long Start(ThreadPool *pool, Result *bestResults, bool _limitCandidate,
+			ostream *_outputFile, Result *_tagResults, ParetoFrontier *_frontier);	/* Explore() up to the pool, return the number of work items */
+	long long Finish(Result *bestResults);	/* Explore() after the work items ran, NULL discards the results */
+	void Execute(long _index, int _workerId);
+	void Materialize(const ParetoPoint &_point, Result *_result);	/* Build the bank of a frontier point again with the current wires */
+	bool Evaluate(const DesignPoint &_design, Result *_result);	/* Build the bank of any design with the current wires, false if it is not valid */
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	SimulationContext *context;
+	SearchSpace space;		/* The BIGFOR bounds of this exploration */
+	MemoryType memoryType;
+	long long bankCapacity;	/* Unit: bit, for tag arrays it is derived from the block size of each design */
+	long bankBlockSize;		/* Unit: bit, for tag arrays it is the number of tag bits before rounding */
+	int bankAssociativity;
+	bool limitCandidate;	/* Only count the candidates that meet the limits of the best results (constrained pass) */
+	ostream *outputFile;	/* Every valid candidate is written here if it is not NULL (exploration without pruning) */
+	Result *tagResults;		/* The tag results to pair with when a cache is written to outputFile */
+	ParetoFrontier *frontier;	/* Every valid candidate is offered to it if it is not NULL */
+	OptimizationTarget boundTarget;	/* If not full_exploration, skip the candidates whose lower bound cannot beat the best result of this target */
+	int numShard;		/* If it is not 0, only the work items shardIndex, shardIndex + numShard, ... are explored */
+	int shardIndex;		/* and the rows of each work item are preceded by "Item <index> <bytes>" */
+	Progress *progress;	/* Counts the points and stops the exploration when it expires, NULL if not tracked. If it has a
+						time budget, the work items are visited in the spread order instead of the BIGFOR order */
+	TopKCollector *topK;	/* full_exploration collectors, the valid candidates of each compared target are offered to its
+						collector if it is not NULL. boundTarget is then bounded by the worst of its k best designs */
+
+private:
+	void Flush(long _index, const string &_output);
+	bool Calculate(Bank *_bank, Result *_bestResults, TopKCollector *_topK);	/* Return false if the bank is invalid or cannot beat _bestResults[boundTarget]
+											(or get in _topK[boundTarget]), only the metrics of boundTarget may be calculated */
+	bool MeetLimit(Bank *_bank, Result &_constraint);	/* Whether the lower bounds of _bank are within the limits of _constraint */
+	void OfferProgress(Result *_bestResults, long long _sequence);	/* The targets whose best result is the design of _sequence */
+	bool GetBankSize(int _numActiveSubarray, long long *_capacity, long *_blockSize, int *_associativity);
+
+	vector<DesignPoint> organizations;	/* One per work item, only the ORGANIZATION_FORLOOP part is set */
+	vector<long> order;				/* The work item of each task index, empty for the BIGFOR order */
+	long long numPeripheralPoint;	/* Number of PERIPHERAL_FORLOOP points per work item */
+	int numWorker;
+	Result *workerResults;			/* numWorker x full_exploration best results */
+	long long *workerSolution;		/* Number of valid solutions found by each worker */
+	ParetoFrontier *workerFrontier;	/* The frontier of each worker, merged into frontier at the end */
+	TopKCollector *workerTopK;		/* numWorker x full_exploration collectors, merged into topK at the end */
+	Result *workerTempResults;		/* The scratch result of each worker */
+	char *workerBankStorage;		/* numWorker x BANK_STORAGE_SIZE bytes, where each worker builds its candidates */
+
+	/* CSV rows are written in the serial BIGFOR order */
+	mutex outputLock;
+	vector<string> pendingOutput;
+	vector<bool> finishedOutput;
+	long nextOutput;
+};
+
+/* Runs the work items of two started explorers in one pass of the pool, so the workers
+ * that run out of the items of the first one take the items of the second one */
+class ExplorerPair: public ParallelTask {
+public:
+	ExplorerPair();
+	virtual ~ExplorerPair();
+
+	/* Functions */
+	void Initialize(Explorer *_first, long _numFirstItem, Explorer *_second, long _numSecondItem);
+	void Run(ThreadPool *pool);
+	void Execute(long _index, int _workerId);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	Explorer *first;
+	Explorer *second;
+	long numFirstItem;
+	long numSecondItem;
+	bool interleaved;	/* The items of the two explorers alternate in proportion instead of the first ones coming first,
+						so a time budget that expires leaves both of them partly explored */
+};
+
+#endif /* EXPLORER_H_ */
@@ -38,6 +38,7 @@
 #include "FunctionUnit.h"
 
 FunctionUnit::FunctionUnit() {
+	context = NULL;
 	height = width = 0;
 	area = 0;
 	readLatency = writeLatency = 0;
@@ -54,6 +55,10 @@ FunctionUnit::~FunctionUnit() {
 	// TODO Auto-generated destructor stub
 }
 
+void FunctionUnit::SetContext(SimulationContext *_context) {
+	context = _context;
+}
+
 void FunctionUnit::PrintProperty() {
 	cout << "Area = " << height*1e6 << "um x " << width*1e6 << "um = " << area*1e6 << "mm^2" << endl;
 	cout << "Timing:" << endl;
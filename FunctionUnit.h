@@ -42,6 +42,8 @@
 
 using namespace std;
 
+class SimulationContext;
+
 class FunctionUnit {
 public:
 	FunctionUnit();
@@ -49,8 +51,10 @@ public:
 
 	/* Functions */
 	virtual void PrintProperty();
+	virtual void SetContext(SimulationContext *_context);	/* Rebind a copied unit and its sub-units to another context */
 
 	/* Properties */
+	SimulationContext *context;	/* The models this unit is evaluated with, assigned by Initialize() */
 	double height;		/* Unit: m */
 	double width;		/* Unit: m */
 	double area;		/* Unit: m^2 */
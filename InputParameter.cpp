@@ -36,8 +36,8 @@
 
 
 #include "InputParameter.h"
-#include "global.h"
 #include "constant.h"
+#include "macros.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -51,45 +51,6 @@ InputParameter::InputParameter() {
 
 	maxNmosSize = MAX_NMOS_SIZE;
 
-	minNumRowMat = 1;
-	maxNumRowMat = 512;
-	minNumColumnMat = 1;
-	maxNumColumnMat = 512;
-	minNumActiveMatPerRow = 1;
-	maxNumActiveMatPerRow = maxNumColumnMat;
-	minNumActiveMatPerColumn = 1;
-	maxNumActiveMatPerColumn = maxNumRowMat;
-	minNumRowSubarray = 1;
-	maxNumRowSubarray = 2;
-	minNumColumnSubarray = 1;
-	maxNumColumnSubarray = 2;
-	minNumActiveSubarrayPerRow = 1;
-	maxNumActiveSubarrayPerRow = maxNumColumnSubarray;
-	minNumActiveSubarrayPerColumn = 1;
-	maxNumActiveSubarrayPerColumn = maxNumRowSubarray;
-	minMuxSenseAmp = 1;
-	maxMuxSenseAmp = 256;
-	minMuxOutputLev1 = 1;
-	maxMuxOutputLev1 = 256;
-	minMuxOutputLev2 = 1;
-	maxMuxOutputLev2 = 256;
-	minNumRowPerSet = 1;
-	maxNumRowPerSet = 256;
-	minAreaOptimizationLevel = latency_first;
-	maxAreaOptimizationLevel = area_first;
-	minLocalWireType = local_aggressive;
-	maxLocalWireType = local_conservative;
-	minGlobalWireType = global_aggressive;
-	maxGlobalWireType = global_conservative;
-	minLocalWireRepeaterType = repeated_none;
-	maxLocalWireRepeaterType = repeated_50;		/* The limit is repeated_50 */
-	minGlobalWireRepeaterType = repeated_none;
-	maxGlobalWireRepeaterType = repeated_50;	/* The limit is repeated_50 */
-	minIsLocalWireLowSwing = false;
-	maxIsLocalWireLowSwing = true;
-	minIsGlobalWireLowSwing = false;
-	maxIsGlobalWireLowSwing = true;
-
 	associativity = 1;				/* Default value for non-cache design */
 	routingMode = h_tree;
 	internalSensing = true;
@@ -109,6 +70,10 @@ InputParameter::InputParameter() {
 	writeEdpConstraint = 1e41;
 	isConstraintApplied = false;
 	isPruningEnabled = false;
+	topK = 1;
+	maxBankHeight = 1e41;
+	maxBankWidth = 1e41;
+	maxAspectRatio = 1e41;
 
 	pageSize = 0;
 	flashBlockSize = 0;
@@ -122,14 +87,28 @@ InputParameter::~InputParameter() {
 
 void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 	FILE *fp = fopen(inputFile.c_str(), "r");
-	char line[5000];
-	char tmp[5000];
 
 	if (!fp) {
 		cout << inputFile << " cannot be found!\n";
 		exit(-1);
 	}
 
+	ReadInputParameter(fp);
+	fclose(fp);
+}
+
+void InputParameter::ReadInputParameterFromText(const std::string & inputText) {
+	if (inputText.empty())
+		return;
+	FILE *fp = fmemopen((void *)inputText.c_str(), inputText.size(), "r");
+	ReadInputParameter(fp);
+	fclose(fp);
+}
+
+void InputParameter::ReadInputParameter(FILE *fp) {
+	char line[5000];
+	char tmp[5000];
+
 	while (fscanf(fp, "%[^\n]\n", line) != EOF) {
 		if (!strncmp("-DesignTarget", line, strlen("-DesignTarget"))) {
 			sscanf(line, "-DesignTarget: %s", tmp);
@@ -137,12 +116,12 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 				designTarget = cache;
 			else if (!strcmp(tmp, "RAM")) {
 				designTarget = RAM_chip;
-				minNumRowPerSet = 1;
-				maxNumRowPerSet = 1;
+				searchSpace.minNumRowPerSet = 1;
+				searchSpace.maxNumRowPerSet = 1;
 			} else {
 				designTarget = CAM_chip;
-				minNumRowPerSet = 1;
-				maxNumRowPerSet = 1;
+				searchSpace.minNumRowPerSet = 1;
+				searchSpace.maxNumRowPerSet = 1;
 			}
 			continue;
 		}
@@ -256,66 +235,66 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 		if (!strncmp("-LocalWireType", line, strlen("-LocalWireType"))) {
 			sscanf(line, "-LocalWireType: %s", tmp);
 			if (!strcmp(tmp, "LocalAggressive")) {
-				minLocalWireType = local_aggressive;
-				maxLocalWireType = local_aggressive;
+				searchSpace.minLocalWireType = local_aggressive;
+				searchSpace.maxLocalWireType = local_aggressive;
 			} else if (!strcmp(tmp, "LocalConservative")) {
-				minLocalWireType = local_conservative;
-				maxLocalWireType = local_conservative;
+				searchSpace.minLocalWireType = local_conservative;
+				searchSpace.maxLocalWireType = local_conservative;
 			} else if (!strcmp(tmp, "SemiAggressive")) {
-				minLocalWireType = semi_aggressive;
-				maxLocalWireType = semi_aggressive;
+				searchSpace.minLocalWireType = semi_aggressive;
+				searchSpace.maxLocalWireType = semi_aggressive;
 			} else if (!strcmp(tmp, "SemiConservative")) {
-				minLocalWireType = semi_conservative;
-				maxLocalWireType = semi_conservative;
+				searchSpace.minLocalWireType = semi_conservative;
+				searchSpace.maxLocalWireType = semi_conservative;
 			} else if (!strcmp(tmp, "GlobalAggressive")) {
-				minLocalWireType = global_aggressive;
-				maxLocalWireType = global_aggressive;
+				searchSpace.minLocalWireType = global_aggressive;
+				searchSpace.maxLocalWireType = global_aggressive;
 			} else if (!strcmp(tmp, "GlobalConservative")) {
-				minLocalWireType = global_conservative;
-				maxLocalWireType = global_conservative;
+				searchSpace.minLocalWireType = global_conservative;
+				searchSpace.maxLocalWireType = global_conservative;
 			} else {	/* no supported yet */
-				minLocalWireType = dram_wordline;
-				maxLocalWireType = dram_wordline;
+				searchSpace.minLocalWireType = dram_wordline;
+				searchSpace.maxLocalWireType = dram_wordline;
 			}
 			continue;
 		}
 		if (!strncmp("-LocalWireRepeaterType", line, strlen("-LocalWireRepeaterType"))) {
 			sscanf(line, "-LocalWireRepeaterType: %s", tmp);
 			if (!strcmp(tmp, "RepeatedOpt")) {
-				minLocalWireRepeaterType = repeated_opt;
-				maxLocalWireRepeaterType = repeated_opt;
+				searchSpace.minLocalWireRepeaterType = repeated_opt;
+				searchSpace.maxLocalWireRepeaterType = repeated_opt;
 			} else if (!strcmp(tmp, "Repeated5%Penalty")) {
-				minLocalWireRepeaterType = repeated_5;
-				maxLocalWireRepeaterType = repeated_5;
+				searchSpace.minLocalWireRepeaterType = repeated_5;
+				searchSpace.maxLocalWireRepeaterType = repeated_5;
 			} else if (!strcmp(tmp, "Repeated10%Penalty")) {
-				minLocalWireRepeaterType = repeated_10;
-				maxLocalWireRepeaterType = repeated_10;
+				searchSpace.minLocalWireRepeaterType = repeated_10;
+				searchSpace.maxLocalWireRepeaterType = repeated_10;
 			} else if (!strcmp(tmp, "Repeated20%Penalty")) {
-				minLocalWireRepeaterType = repeated_20;
-				maxLocalWireRepeaterType = repeated_20;
+				searchSpace.minLocalWireRepeaterType = repeated_20;
+				searchSpace.maxLocalWireRepeaterType = repeated_20;
 			} else if (!strcmp(tmp, "Repeated30%Penalty")) {
-				minLocalWireRepeaterType = repeated_30;
-				maxLocalWireRepeaterType = repeated_30;
+				searchSpace.minLocalWireRepeaterType = repeated_30;
+				searchSpace.maxLocalWireRepeaterType = repeated_30;
 			} else if (!strcmp(tmp, "Repeated40%Penalty")) {
-				minLocalWireRepeaterType = repeated_40;
-				maxLocalWireRepeaterType = repeated_40;
+				searchSpace.minLocalWireRepeaterType = repeated_40;
+				searchSpace.maxLocalWireRepeaterType = repeated_40;
 			} else if (!strcmp(tmp, "Repeated50%Penalty")) {
-				minLocalWireRepeaterType = repeated_50;
-				maxLocalWireRepeaterType = repeated_50;
+				searchSpace.minLocalWireRepeaterType = repeated_50;
+				searchSpace.maxLocalWireRepeaterType = repeated_50;
 			} else {
-				minLocalWireRepeaterType = repeated_none;
-				maxLocalWireRepeaterType = repeated_none;
+				searchSpace.minLocalWireRepeaterType = repeated_none;
+				searchSpace.maxLocalWireRepeaterType = repeated_none;
 			}
 			continue;
 		}
 		if (!strncmp("-LocalWireUseLowSwing", line, strlen("-LocalWireUseLowSwing"))) {
 			sscanf(line, "-LocalWireUseLowSwing: %s", tmp);
 			if (!strcmp(tmp, "Yes")) {
-				minIsLocalWireLowSwing = 1;
-				maxIsLocalWireLowSwing = 1;
+				searchSpace.minIsLocalWireLowSwing = 1;
+				searchSpace.maxIsLocalWireLowSwing = 1;
 			} else {
-				minIsLocalWireLowSwing = 0;
-				maxIsLocalWireLowSwing = 0;
+				searchSpace.minIsLocalWireLowSwing = 0;
+				searchSpace.maxIsLocalWireLowSwing = 0;
 			}
 			continue;
 		}
@@ -323,66 +302,66 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 		if (!strncmp("-GlobalWireType", line, strlen("-GlobalWireType"))) {
 			sscanf(line, "-GlobalWireType: %s", tmp);
 			if (!strcmp(tmp, "LocalAggressive")) {
-				minGlobalWireType = local_aggressive;
-				maxGlobalWireType = local_aggressive;
+				searchSpace.minGlobalWireType = local_aggressive;
+				searchSpace.maxGlobalWireType = local_aggressive;
 			} else if (!strcmp(tmp, "LocalConservative")) {
-				minGlobalWireType = local_conservative;
-				maxGlobalWireType = local_conservative;
+				searchSpace.minGlobalWireType = local_conservative;
+				searchSpace.maxGlobalWireType = local_conservative;
 			} else if (!strcmp(tmp, "SemiAggressive")) {
-				minGlobalWireType = semi_aggressive;
-				maxGlobalWireType = semi_aggressive;
+				searchSpace.minGlobalWireType = semi_aggressive;
+				searchSpace.maxGlobalWireType = semi_aggressive;
 			} else if (!strcmp(tmp, "SemiConservative")) {
-				minGlobalWireType = semi_conservative;
-				maxGlobalWireType = semi_conservative;
+				searchSpace.minGlobalWireType = semi_conservative;
+				searchSpace.maxGlobalWireType = semi_conservative;
 			} else if (!strcmp(tmp, "GlobalAggressive")) {
-				minGlobalWireType = global_aggressive;
-				maxGlobalWireType = global_aggressive;
+				searchSpace.minGlobalWireType = global_aggressive;
+				searchSpace.maxGlobalWireType = global_aggressive;
 			} else if (!strcmp(tmp, "GlobalConservative")) {
-				minGlobalWireType = global_conservative;
-				maxGlobalWireType = global_conservative;
+				searchSpace.minGlobalWireType = global_conservative;
+				searchSpace.maxGlobalWireType = global_conservative;
 			} else {	/* no supported yet */
-				minGlobalWireType = dram_wordline;
-				maxGlobalWireType = dram_wordline;
+				searchSpace.minGlobalWireType = dram_wordline;
+				searchSpace.maxGlobalWireType = dram_wordline;
 			}
 			continue;
 		}
 		if (!strncmp("-GlobalWireRepeaterType", line, strlen("-GlobalWireRepeaterType"))) {
 			sscanf(line, "-GlobalWireRepeaterType: %s", tmp);
 			if (!strcmp(tmp, "RepeatedOpt")) {
-				minGlobalWireRepeaterType = repeated_opt;
-				maxGlobalWireRepeaterType = repeated_opt;
+				searchSpace.minGlobalWireRepeaterType = repeated_opt;
+				searchSpace.maxGlobalWireRepeaterType = repeated_opt;
 			} else if (!strcmp(tmp, "Repeated5%Penalty")) {
-				minGlobalWireRepeaterType = repeated_5;
-				maxGlobalWireRepeaterType = repeated_5;
+				searchSpace.minGlobalWireRepeaterType = repeated_5;
+				searchSpace.maxGlobalWireRepeaterType = repeated_5;
 			} else if (!strcmp(tmp, "Repeated10%Penalty")) {
-				minGlobalWireRepeaterType = repeated_10;
-				maxGlobalWireRepeaterType = repeated_10;
+				searchSpace.minGlobalWireRepeaterType = repeated_10;
+				searchSpace.maxGlobalWireRepeaterType = repeated_10;
 			} else if (!strcmp(tmp, "Repeated20%Penalty")) {
-				minGlobalWireRepeaterType = repeated_20;
-				maxGlobalWireRepeaterType = repeated_20;
+				searchSpace.minGlobalWireRepeaterType = repeated_20;
+				searchSpace.maxGlobalWireRepeaterType = repeated_20;
 			} else if (!strcmp(tmp, "Repeated30%Penalty")) {
-				minGlobalWireRepeaterType = repeated_30;
-				maxGlobalWireRepeaterType = repeated_30;
+				searchSpace.minGlobalWireRepeaterType = repeated_30;
+				searchSpace.maxGlobalWireRepeaterType = repeated_30;
 			} else if (!strcmp(tmp, "Repeated40%Penalty")) {
-				minGlobalWireRepeaterType = repeated_40;
-				maxGlobalWireRepeaterType = repeated_40;
+				searchSpace.minGlobalWireRepeaterType = repeated_40;
+				searchSpace.maxGlobalWireRepeaterType = repeated_40;
 			} else if (!strcmp(tmp, "Repeated50%Penalty")) {
-				minGlobalWireRepeaterType = repeated_50;
-				maxGlobalWireRepeaterType = repeated_50;
+				searchSpace.minGlobalWireRepeaterType = repeated_50;
+				searchSpace.maxGlobalWireRepeaterType = repeated_50;
 			} else {
-				minGlobalWireRepeaterType = repeated_none;
-				maxGlobalWireRepeaterType = repeated_none;
+				searchSpace.minGlobalWireRepeaterType = repeated_none;
+				searchSpace.maxGlobalWireRepeaterType = repeated_none;
 			}
 			continue;
 		}
 		if (!strncmp("-GlobalWireUseLowSwing", line, strlen("-GlobalWireUseLowSwing"))) {
 			sscanf(line, "-GlobalWireUseLowSwing: %s", tmp);
 			if (!strcmp(tmp, "Yes")) {
-				minIsGlobalWireLowSwing = 1;
-				maxIsGlobalWireLowSwing = 1;
+				searchSpace.minIsGlobalWireLowSwing = 1;
+				searchSpace.maxIsGlobalWireLowSwing = 1;
 			} else {
-				minIsGlobalWireLowSwing = 0;
-				maxIsGlobalWireLowSwing = 0;
+				searchSpace.minIsGlobalWireLowSwing = 0;
+				searchSpace.maxIsGlobalWireLowSwing = 0;
 			}
 			continue;
 		}
@@ -418,39 +397,39 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 
 		if (!strncmp("-ForceBank", line, strlen("-ForceBank"))) {
 			sscanf(line, "-ForceBank (Total AxB, Active CxD): %dx%d, %dx%d",
-					&minNumRowMat, &minNumColumnMat, &minNumActiveMatPerColumn, &minNumActiveMatPerRow);
-			maxNumRowMat = minNumRowMat;
-			maxNumColumnMat = minNumColumnMat;
-			maxNumActiveMatPerColumn = minNumActiveMatPerColumn;
-			maxNumActiveMatPerRow = minNumActiveMatPerRow;
+					&searchSpace.minNumRowMat, &searchSpace.minNumColumnMat, &searchSpace.minNumActiveMatPerColumn, &searchSpace.minNumActiveMatPerRow);
+			searchSpace.maxNumRowMat = searchSpace.minNumRowMat;
+			searchSpace.maxNumColumnMat = searchSpace.minNumColumnMat;
+			searchSpace.maxNumActiveMatPerColumn = searchSpace.minNumActiveMatPerColumn;
+			searchSpace.maxNumActiveMatPerRow = searchSpace.minNumActiveMatPerRow;
 			continue;
 		}
 
 		if (!strncmp("-ForceMat", line, strlen("-ForceMat"))) {
 			sscanf(line, "-ForceMat (Total AxB, Active CxD): %dx%d, %dx%d",
-					&minNumRowSubarray, &minNumColumnSubarray, &minNumActiveSubarrayPerColumn, &minNumActiveSubarrayPerRow);
-			maxNumRowSubarray = minNumRowSubarray;
-			maxNumColumnSubarray = minNumColumnSubarray;
-			maxNumActiveSubarrayPerColumn = minNumActiveSubarrayPerColumn;
-			maxNumActiveSubarrayPerRow = minNumActiveSubarrayPerRow;
+					&searchSpace.minNumRowSubarray, &searchSpace.minNumColumnSubarray, &searchSpace.minNumActiveSubarrayPerColumn, &searchSpace.minNumActiveSubarrayPerRow);
+			searchSpace.maxNumRowSubarray = searchSpace.minNumRowSubarray;
+			searchSpace.maxNumColumnSubarray = searchSpace.minNumColumnSubarray;
+			searchSpace.maxNumActiveSubarrayPerColumn = searchSpace.minNumActiveSubarrayPerColumn;
+			searchSpace.maxNumActiveSubarrayPerRow = searchSpace.minNumActiveSubarrayPerRow;
 			continue;
 		}
 
 		if (!strncmp("-ForceMuxSenseAmp", line, strlen("-ForceMuxSenseAmp"))) {
-			sscanf(line, "-ForceMuxSenseAmp: %d", &minMuxSenseAmp);
-			maxMuxSenseAmp = minMuxSenseAmp;
+			sscanf(line, "-ForceMuxSenseAmp: %d", &searchSpace.minMuxSenseAmp);
+			searchSpace.maxMuxSenseAmp = searchSpace.minMuxSenseAmp;
 			continue;
 		}
 
 		if (!strncmp("-ForceMuxOutputLev1", line, strlen("-ForceMuxOutputLev1"))) {
-			sscanf(line, "-ForceMuxOutputLev1: %d", &minMuxOutputLev1);
-			maxMuxOutputLev1 = minMuxOutputLev1;
+			sscanf(line, "-ForceMuxOutputLev1: %d", &searchSpace.minMuxOutputLev1);
+			searchSpace.maxMuxOutputLev1 = searchSpace.minMuxOutputLev1;
 			continue;
 		}
 
 		if (!strncmp("-ForceMuxOutputLev2", line, strlen("-ForceMuxOutputLev2"))) {
-			sscanf(line, "-ForceMuxOutputLev2: %d", &minMuxOutputLev2);
-			maxMuxOutputLev2 = minMuxOutputLev2;
+			sscanf(line, "-ForceMuxOutputLev2: %d", &searchSpace.minMuxOutputLev2);
+			searchSpace.maxMuxOutputLev2 = searchSpace.minMuxOutputLev2;
 			continue;
 		}
 
@@ -458,23 +437,45 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 			sscanf(line, "-UseCactiAssumption: %s", tmp);
 			if (!strcmp(tmp, "Yes")) {
 				useCactiAssumption = true;
-				minNumActiveMatPerRow = maxNumColumnMat;
-				maxNumActiveMatPerRow = maxNumColumnMat;
-				minNumActiveMatPerColumn = 1;
-				maxNumActiveMatPerColumn = 1;
-				minNumRowSubarray = 2;
-				maxNumRowSubarray = 2;
-				minNumColumnSubarray = 2;
-				maxNumColumnSubarray = 2;
-				minNumActiveSubarrayPerRow = 2;
-				maxNumActiveSubarrayPerRow = 2;
-				minNumActiveSubarrayPerColumn = 2;
-				maxNumActiveSubarrayPerColumn = 2;
+				searchSpace.minNumActiveMatPerRow = searchSpace.maxNumColumnMat;
+				searchSpace.maxNumActiveMatPerRow = searchSpace.maxNumColumnMat;
+				searchSpace.minNumActiveMatPerColumn = 1;
+				searchSpace.maxNumActiveMatPerColumn = 1;
+				searchSpace.minNumRowSubarray = 2;
+				searchSpace.maxNumRowSubarray = 2;
+				searchSpace.minNumColumnSubarray = 2;
+				searchSpace.maxNumColumnSubarray = 2;
+				searchSpace.minNumActiveSubarrayPerRow = 2;
+				searchSpace.maxNumActiveSubarrayPerRow = 2;
+				searchSpace.minNumActiveSubarrayPerColumn = 2;
+				searchSpace.maxNumActiveSubarrayPerColumn = 2;
 			} else
 				useCactiAssumption = false;
 			continue;
 		}
 
+		if (!strncmp("-TopK", line, strlen("-TopK"))) {
+			sscanf(line, "-TopK: %d", &topK);
+			continue;
+		}
+
+		if (!strncmp("-MaxBankHeight", line, strlen("-MaxBankHeight"))) {
+			sscanf(line, "-MaxBankHeight (um): %lf", &maxBankHeight);
+			maxBankHeight /= 1e6;
+			continue;
+		}
+
+		if (!strncmp("-MaxBankWidth", line, strlen("-MaxBankWidth"))) {
+			sscanf(line, "-MaxBankWidth (um): %lf", &maxBankWidth);
+			maxBankWidth /= 1e6;
+			continue;
+		}
+
+		if (!strncmp("-MaxAspectRatio", line, strlen("-MaxAspectRatio"))) {
+			sscanf(line, "-MaxAspectRatio: %lf", &maxAspectRatio);
+			continue;
+		}
+
 		if (!strncmp("-EnablePruning", line, strlen("-EnablePruning"))) {
 			sscanf(line, "-EnablePruning: %s", tmp);
 			if (!strcmp(tmp, "Yes"))
@@ -487,14 +488,14 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 		if (!strncmp("-BufferDesignOptimization", line, strlen("-BufferDesignOptimization"))) {
 			sscanf(line, "-BufferDesignOptimization: %s", tmp);
 			if (!strcmp(tmp, "latency")) {
-				minAreaOptimizationLevel = 0;
-				maxAreaOptimizationLevel = 0;
+				searchSpace.minAreaOptimizationLevel = 0;
+				searchSpace.maxAreaOptimizationLevel = 0;
 			} else if (!strcmp(tmp, "area")) {
-				minAreaOptimizationLevel = 2;
-				maxAreaOptimizationLevel = 2;
+				searchSpace.minAreaOptimizationLevel = 2;
+				searchSpace.maxAreaOptimizationLevel = 2;
 			} else {
-				minAreaOptimizationLevel = 1;
-				maxAreaOptimizationLevel = 1;
+				searchSpace.minAreaOptimizationLevel = 1;
+				searchSpace.maxAreaOptimizationLevel = 1;
 			}
 		}
 
@@ -558,11 +559,9 @@ void InputParameter::ReadInputParameterFromFile(const std::string & inputFile) {
 			continue;
 		}
 	}
-
-	fclose(fp);
 }
 
-void InputParameter::PrintInputParameter() {
+void InputParameter::PrintInputParameter(MemCellType _memCellType) {
 	cout << endl << "====================" << endl << "DESIGN SPECIFICATION" << endl << "====================" << endl;
 	cout << "Design Target: ";
 	switch (designTarget) {
@@ -594,7 +593,7 @@ void InputParameter::PrintInputParameter() {
 		else
 			cout << endl;
 	}
-	if (designTarget == RAM_chip && (cell->memCellType == SLCNAND || cell->memCellType == MLCNAND)) {
+	if (designTarget == RAM_chip && (_memCellType == SLCNAND || _memCellType == MLCNAND)) {
 		cout << "Page Size  : " << pageSize / 8 << "Bytes" << endl;
 		cout << "Block Size : " << flashBlockSize / 8 / 1024 << "KB" << endl;
 	}
@@ -630,4 +629,53 @@ void InputParameter::PrintInputParameter() {
 			cout << "area ..." << endl;
 		}
 	}
+	if (maxBankHeight < 1e41 || maxBankWidth < 1e41 || maxAspectRatio < 1e41) {
+		cout << "Only the data banks";
+		if (maxBankHeight < 1e41)
+			cout << " at most " << TO_METER(maxBankHeight) << " high";
+		if (maxBankWidth < 1e41)
+			cout << " at most " << TO_METER(maxBankWidth) << " wide";
+		if (maxAspectRatio < 1e41)
+			cout << " with an aspect ratio of at most " << maxAspectRatio;
+		cout << " are explored" << endl;
+	}
+}
+
+
+void InputParameter::PrintCanonical(ostream &outputFile) {
+	/* The cell file is left out, the result cache keys the cell by its fields */
+	outputFile << "designTarget=" << (int)designTarget << endl;
+	outputFile << "optimizationTarget=" << (int)optimizationTarget << endl;
+	outputFile << "processNode=" << processNode << endl;
+	outputFile << "capacity=" << capacity << endl;
+	outputFile << "wordWidth=" << wordWidth << endl;
+	outputFile << "deviceRoadmap=" << (int)deviceRoadmap << endl;
+	outputFile << "temperature=" << temperature << endl;
+	outputFile << "maxDriverCurrent=" << maxDriverCurrent << endl;
+	outputFile << "writeScheme=" << (int)writeScheme << endl;
+	outputFile << "readLatencyConstraint=" << readLatencyConstraint << endl;
+	outputFile << "writeLatencyConstraint=" << writeLatencyConstraint << endl;
+	outputFile << "readDynamicEnergyConstraint=" << readDynamicEnergyConstraint << endl;
+	outputFile << "writeDynamicEnergyConstraint=" << writeDynamicEnergyConstraint << endl;
+	outputFile << "leakageConstraint=" << leakageConstraint << endl;
+	outputFile << "areaConstraint=" << areaConstraint << endl;
+	outputFile << "readEdpConstraint=" << readEdpConstraint << endl;
+	outputFile << "writeEdpConstraint=" << writeEdpConstraint << endl;
+	outputFile << "isConstraintApplied=" << (int)isConstraintApplied << endl;
+	outputFile << "isPruningEnabled=" << (int)isPruningEnabled << endl;
+	if (topK != 1)
+		outputFile << "topK=" << topK << endl;	/* Only then, so the keys of the earlier entries still match */
+	if (maxBankHeight < 1e41 || maxBankWidth < 1e41 || maxAspectRatio < 1e41)
+		outputFile << "maxBankHeight=" << maxBankHeight << endl << "maxBankWidth=" << maxBankWidth << endl
+				<< "maxAspectRatio=" << maxAspectRatio << endl;
+	outputFile << "useCactiAssumption=" << (int)useCactiAssumption << endl;
+	outputFile << "associativity=" << associativity << endl;
+	outputFile << "cacheAccessMode=" << (int)cacheAccessMode << endl;
+	outputFile << "pageSize=" << pageSize << endl;
+	outputFile << "flashBlockSize=" << flashBlockSize << endl;
+	outputFile << "routingMode=" << (int)routingMode << endl;
+	outputFile << "internalSensing=" << (int)internalSensing << endl;
+	outputFile << "maxNmosSize=" << maxNmosSize << endl;
+	outputFile << "outputFilePrefix=" << outputFilePrefix << endl;
+	searchSpace.PrintCanonical(outputFile);
 }
@@ -41,7 +41,9 @@
 #include <iostream>
 #include <string>
 #include <stdint.h>
+#include <stdio.h>
 
+#include "SearchSpace.h"
 #include "typedef.h"
 
 using namespace std;
@@ -53,7 +55,9 @@ public:
 
 	/* Functions */
 	void ReadInputParameterFromFile(const std::string & inputFile);
-	void PrintInputParameter();
+	void ReadInputParameterFromText(const std::string & inputText);	/* The same format as the .cfg file */
+	void PrintInputParameter(MemCellType _memCellType);
+	void PrintCanonical(ostream &outputFile);	/* Every field that affects the results, one per line in a fixed order */
 
 	/* Properties */
 	DesignTarget designTarget;		/* Cache, RAM, or CAM */
@@ -77,6 +81,10 @@ public:
 	bool isConstraintApplied;		/* If any design constraint is applied */
 	bool isPruningEnabled;			/* Whether to prune the results during the exploration */
 	bool useCactiAssumption;		/* Use the CACTI assumptions on the array organization */
+	int topK;						/* Number of the best designs of the optimization target to write, 1 means only the best one */
+	double maxBankHeight;			/* The floorplan envelope of the data bank, Unit: m */
+	double maxBankWidth;
+	double maxAspectRatio;			/* The longer side of the data bank over the shorter one */
 
 	int associativity;				/* Associativity, for cache design only */
 	CacheAccessMode cacheAccessMode;	/* Access mode (for cache only) : normal, sequential, fast */
@@ -91,44 +99,10 @@ public:
 
 	string outputFilePrefix;
 
-	int minNumRowMat;
-	int maxNumRowMat;
-	int minNumColumnMat;
-	int maxNumColumnMat;
-	int minNumActiveMatPerRow;
-	int maxNumActiveMatPerRow;
-	int minNumActiveMatPerColumn;
-	int maxNumActiveMatPerColumn;
-	int minNumRowSubarray;
-	int maxNumRowSubarray;
-	int minNumColumnSubarray;
-	int maxNumColumnSubarray;
-	int minNumActiveSubarrayPerRow;
-	int maxNumActiveSubarrayPerRow;
-	int minNumActiveSubarrayPerColumn;
-	int maxNumActiveSubarrayPerColumn;
-	int minMuxSenseAmp;
-	int maxMuxSenseAmp;
-	int minMuxOutputLev1;
-	int maxMuxOutputLev1;
-	int minMuxOutputLev2;
-	int maxMuxOutputLev2;
-	int minNumRowPerSet;
-	int maxNumRowPerSet;
-	int minAreaOptimizationLevel;	/* This one is actually OptPriority type */
-	int maxAreaOptimizationLevel;	/* This one is actually OptPriority type */
-	int minLocalWireType;			/* This one is actually WireType type */
-	int maxLocalWireType;			/* This one is actually WireType type */
-	int minGlobalWireType;			/* This one is actually WireType type */
-	int maxGlobalWireType;			/* This one is actually WireType type */
-	int minLocalWireRepeaterType;		/* This one is actually WireRepeaterType type */
-	int maxLocalWireRepeaterType;		/* This one is actually WireRepeaterType type */
-	int minGlobalWireRepeaterType;		/* This one is actually WireRepeaterType type */
-	int maxGlobalWireRepeaterType;		/* This one is actually WireRepeaterType type */
-	int minIsLocalWireLowSwing;		/* This one is actually boolean */
-	int maxIsLocalWireLowSwing;		/* This one is actually boolean */
-	int minIsGlobalWireLowSwing;		/* This one is actually boolean */
-	int maxIsGlobalWireLowSwing;		/* This one is actually boolean */
+	SearchSpace searchSpace;		/* The bounds of the design space, the Force* options narrow it */
+
+private:
+	void ReadInputParameter(FILE *fp);
 };
 
 #endif /* INPUTPARAMETER_H_ */
@@ -37,22 +37,26 @@
 
 #include "Mat.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 Mat::Mat() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	invalidScope = design_scope;
 }
 
 Mat::~Mat() {
 	// TODO Auto-generated destructor stub
 }
 
-void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
+void Mat::Initialize(SimulationContext *_context, int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
 		int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 		BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType) {
+	context = _context;
+	PROFILE_STAGE(mat_profile, initialize_stage);
 	if (initialized)
 		cout << "[Mat] Warning: Already initialized!" << endl;
 
@@ -94,6 +98,8 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	if (_numAddressBit <= 0) {
 		/* too aggressive partitioning */
 		invalid = true;
+		invalidScope = organization_scope;
+		PROFILE_EVENT(aggressive_partitioning_event);
 		initialized = true;
 		return;
 	}
@@ -105,6 +111,8 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	numRow /= (muxSenseAmp * muxOutputLev1 * muxOutputLev2);	/* Distribute to column decoding */
 	if (numRow == 0) {
 		invalid = true;
+		PROFILE_EVENT(invalid_mat_event);
+		invalidScope = mux_scope;
 		initialized = true;
 		return;
 	}
@@ -112,6 +120,8 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	numColumn = (long long)numDataBit / (numActiveSubarrayPerRow * numActiveSubarrayPerColumn);	/* Adjust the number of columns depending on the access types */
 	if (numColumn == 0) {
 		invalid = true;
+		invalidScope = organization_scope;	/* numDataBit is fixed by the organization */
+		PROFILE_EVENT(invalid_mat_event);
 		initialized = true;
 		return;
 	}
@@ -120,19 +130,45 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 	if (memoryType == tag)
 		numColumn *= numWay;
 
-	subarray.Initialize(numRow, numColumn, numRowPerSet > 1, true /* TO-DO: need to correct */,
-			muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel);
+	subarrayKey.numRow = numRow;
+	subarrayKey.numColumn = numColumn;
+	subarrayKey.multipleRowPerSet = numRowPerSet > 1;
+	subarrayKey.split = true /* TO-DO: need to correct */;
+	subarrayKey.muxSenseAmp = muxSenseAmp;
+	subarrayKey.internalSenseAmp = internalSenseAmp;
+	subarrayKey.muxOutputLev1 = muxOutputLev1;
+	subarrayKey.muxOutputLev2 = muxOutputLev2;
+	subarrayKey.areaOptimizationLevel = areaOptimizationLevel;
+	subarrayKey.localWireType = context->localWire->wireType;
+	subarrayKey.localWireRepeaterType = context->localWire->wireRepeaterType;
+	subarrayKey.isLocalWireLowSwing = context->localWire->isLowSwing;
+	subarrayKey.rampInput = 0;
+
+	if (context->subarrayCache->LoadInitialized(subarrayKey, &subarray)) {
+		PROFILE_EVENT(subarray_cache_hit_event);
+		subarray.SetContext(context);	/* The cache is shared with the other contexts of the model */
+	} else {
+		PROFILE_EVENT(subarray_cache_miss_event);
+		subarray.Initialize(context, numRow, numColumn, subarrayKey.multipleRowPerSet, subarrayKey.split,
+				muxSenseAmp, internalSenseAmp, muxOutputLev1, muxOutputLev2, areaOptimizationLevel);
+		if (!subarray.invalid)
+			subarray.CalculateArea();	/* the area needs to be calculated during the initialization because the size dimension needs to be called by others */
+		context->subarrayCache->StoreInitialized(subarrayKey, subarray);
+	}
 
 	if (subarray.invalid) {
 		invalid = true;
+		invalidScope = subarray.invalidScope;
+		PROFILE_EVENT(invalid_mat_event);
 		initialized = true;
 		return;
 	}
-	subarray.CalculateArea();	/* the area needs to be calculated during the initialization because the size dimension needs to be called by others */
 
 	int numAddressRowPredecoderBlock1 = _numAddressBit - (int)(log2(muxSenseAmp * muxOutputLev1 * muxOutputLev2)+0.1);	/* The address bit on row decodeing */
 	if (numAddressRowPredecoderBlock1 < 0) {
 		invalid = true;
+		PROFILE_EVENT(invalid_mat_event);
+		invalidScope = mux_scope;
 		initialized = true;
 		return;
 	}
@@ -141,21 +177,21 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 		numAddressRowPredecoderBlock2 = numAddressRowPredecoderBlock1 / 2;
 		numAddressRowPredecoderBlock1 = numAddressRowPredecoderBlock1 - numAddressRowPredecoderBlock2;
 	}
-	double capLoadRowPredecoder = subarray.height * localWire->capWirePerUnit * numRowSubarray / 2
-			+ subarray.width * localWire->capWirePerUnit * numColumnSubarray / 2;	/* Assume the predecoder is at the center */
-	rowPredecoderBlock1.Initialize(numAddressRowPredecoderBlock1, capLoadRowPredecoder, 0 /* TO-DO */);
-	rowPredecoderBlock2.Initialize(numAddressRowPredecoderBlock2, capLoadRowPredecoder, 0 /* TO-DO */);
+	double capLoadRowPredecoder = subarray.height * context->localWire->capWirePerUnit * numRowSubarray / 2
+			+ subarray.width * context->localWire->capWirePerUnit * numColumnSubarray / 2;	/* Assume the predecoder is at the center */
+	rowPredecoderBlock1.Initialize(context, numAddressRowPredecoderBlock1, capLoadRowPredecoder, 0 /* TO-DO */);
+	rowPredecoderBlock2.Initialize(context, numAddressRowPredecoderBlock2, capLoadRowPredecoder, 0 /* TO-DO */);
 
-	double capLoadMuxPredecoder = MAX(0, subarray.height * localWire->capWirePerUnit * (numRowSubarray - 2) / 2)
-			+ MAX(0, subarray.width * localWire->capWirePerUnit * (numColumnSubarray - 2) / 2);
+	double capLoadMuxPredecoder = MAX(0, subarray.height * context->localWire->capWirePerUnit * (numRowSubarray - 2) / 2)
+			+ MAX(0, subarray.width * context->localWire->capWirePerUnit * (numColumnSubarray - 2) / 2);
 	int numAddressBitlineMuxPredecoderBlock1 = (int)(log2(muxSenseAmp) + 0.1);
 	int numAddressBitlineMuxPredecoderBlock2 = 0;
 	if (numAddressBitlineMuxPredecoderBlock1 > 3) {		/* Block 2 is needed */
 		numAddressBitlineMuxPredecoderBlock2 = numAddressBitlineMuxPredecoderBlock1 / 2;
 		numAddressBitlineMuxPredecoderBlock1 = numAddressBitlineMuxPredecoderBlock1 - numAddressBitlineMuxPredecoderBlock2;
 	}
-	bitlineMuxPredecoderBlock1.Initialize(numAddressBitlineMuxPredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
-	bitlineMuxPredecoderBlock2.Initialize(numAddressBitlineMuxPredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
+	bitlineMuxPredecoderBlock1.Initialize(context, numAddressBitlineMuxPredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
+	bitlineMuxPredecoderBlock2.Initialize(context, numAddressBitlineMuxPredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
 
 	int numAddressSenseAmpMuxLev1PredecoderBlock1 = (int)(log2(muxOutputLev1) + 0.1);
 	int numAddressSenseAmpMuxLev1PredecoderBlock2 = 0;
@@ -163,8 +199,8 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 		numAddressSenseAmpMuxLev1PredecoderBlock2 = numAddressSenseAmpMuxLev1PredecoderBlock1 / 2;
 		numAddressSenseAmpMuxLev1PredecoderBlock1 = numAddressSenseAmpMuxLev1PredecoderBlock1 - numAddressSenseAmpMuxLev1PredecoderBlock2;
 	}
-	senseAmpMuxLev1PredecoderBlock1.Initialize(numAddressSenseAmpMuxLev1PredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
-	senseAmpMuxLev1PredecoderBlock2.Initialize(numAddressSenseAmpMuxLev1PredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
+	senseAmpMuxLev1PredecoderBlock1.Initialize(context, numAddressSenseAmpMuxLev1PredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
+	senseAmpMuxLev1PredecoderBlock2.Initialize(context, numAddressSenseAmpMuxLev1PredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
 
 	int numAddressSenseAmpMuxLev2PredecoderBlock1 = (int)(log2(muxOutputLev2) + 0.1);
 	int numAddressSenseAmpMuxLev2PredecoderBlock2 = 0;
@@ -172,17 +208,18 @@ void Mat::Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddres
 		numAddressSenseAmpMuxLev2PredecoderBlock2 = numAddressSenseAmpMuxLev2PredecoderBlock1 / 2;
 		numAddressSenseAmpMuxLev2PredecoderBlock1 = numAddressSenseAmpMuxLev2PredecoderBlock1 - numAddressSenseAmpMuxLev2PredecoderBlock2;
 	}
-	senseAmpMuxLev2PredecoderBlock1.Initialize(numAddressSenseAmpMuxLev2PredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
-	senseAmpMuxLev2PredecoderBlock2.Initialize(numAddressSenseAmpMuxLev2PredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
+	senseAmpMuxLev2PredecoderBlock1.Initialize(context, numAddressSenseAmpMuxLev2PredecoderBlock1, capLoadMuxPredecoder, 0 /* TO-DO */);
+	senseAmpMuxLev2PredecoderBlock2.Initialize(context, numAddressSenseAmpMuxLev2PredecoderBlock2, capLoadMuxPredecoder, 0 /* TO-DO */);
 
 	if (memoryType == tag && internalSenseAmp) {
-		comparator.Initialize(numDataBit, 0 /*TO-DO: need to fix */);
+		comparator.Initialize(context, numDataBit, 0 /*TO-DO: need to fix */);
 	}
 
 	initialized = true;
 }
 
 void Mat::CalculateArea() {
+	PROFILE_STAGE(mat_profile, area_stage);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -221,6 +258,7 @@ void Mat::CalculateArea() {
 }
 
 void Mat::CalculateRC() {
+	PROFILE_STAGE(mat_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (!invalid){
@@ -240,6 +278,7 @@ void Mat::CalculateRC() {
 }
 
 void Mat::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(mat_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -265,8 +304,17 @@ void Mat::CalculateLatency(double _rampInput) {
 		predecoderLatency = MAX(MAX(rowPredecoderLatency, bitlineMuxPredecoderLatency),
 				MAX(senseAmpMuxLev1PredecoderLatency, senseAmpMuxLev2PredecoderLatency));
 
-		/* Caluclate subarray latency */
-		subarray.CalculateLatency(MIN(rowPredecoderBlock1.rampOutput, rowPredecoderBlock2.rampOutput));
+		/* Caluclate subarray latency, and its power as well so that both can be taken from the cache */
+		subarrayKey.rampInput = MIN(rowPredecoderBlock1.rampOutput, rowPredecoderBlock2.rampOutput);
+		if (context->subarrayCache->LoadEvaluated(subarrayKey, &subarray)) {
+			PROFILE_EVENT(subarray_cache_hit_event);
+			subarray.SetContext(context);
+		} else {
+			PROFILE_EVENT(subarray_cache_miss_event);
+			subarray.CalculateLatency(subarrayKey.rampInput);
+			subarray.CalculatePower();
+			context->subarrayCache->StoreEvaluated(subarrayKey, subarray);
+		}
 
 		/* Add them together */
 		readLatency = predecoderLatency + subarray.readLatency;
@@ -283,6 +331,7 @@ void Mat::CalculateLatency(double _rampInput) {
 }
 
 void Mat::CalculatePower() {
+	PROFILE_STAGE(mat_profile, power_stage);
 	if (!initialized) {
 		cout << "[Mat] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -296,7 +345,7 @@ void Mat::CalculatePower() {
 		senseAmpMuxLev1PredecoderBlock2.CalculatePower();
 		senseAmpMuxLev2PredecoderBlock1.CalculatePower();
 		senseAmpMuxLev2PredecoderBlock2.CalculatePower();
-		subarray.CalculatePower();
+		/* subarray CalculatePower() is already called by CalculateLatency() */
 
 		readDynamicEnergy = rowPredecoderBlock1.readDynamicEnergy + rowPredecoderBlock2.readDynamicEnergy
 				+ bitlineMuxPredecoderBlock1.readDynamicEnergy + bitlineMuxPredecoderBlock2.readDynamicEnergy
@@ -353,8 +402,10 @@ Mat & Mat::operator=(const Mat &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
+	invalidScope = rhs.invalidScope;
 	numRowSubarray = rhs.numRowSubarray;
 	numColumnSubarray = rhs.numColumnSubarray;
 	numAddressBit = rhs.numAddressBit;
@@ -373,6 +424,7 @@ Mat & Mat::operator=(const Mat &rhs) {
 	predecoderLatency = rhs.predecoderLatency;
 
 	subarray = rhs.subarray;
+	subarrayKey = rhs.subarrayKey;
 	rowPredecoderBlock1 = rhs.rowPredecoderBlock1;
 	rowPredecoderBlock2 = rhs.rowPredecoderBlock2;
 	bitlineMuxPredecoderBlock1 = rhs.bitlineMuxPredecoderBlock1;
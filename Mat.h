@@ -43,6 +43,7 @@
 #include "PredecodeBlock.h"
 #include "typedef.h"
 #include "Comparator.h"
+#include "SubArrayCache.h"
 
 class Mat: public FunctionUnit {
 public:
@@ -51,7 +52,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
+	void Initialize(SimulationContext *_context, int _numRowSubarray, int _numColumnSubarray, int _numAddressBit, long _numDataBit,
 			int _numWay, int _numRowPerSet, bool _split, int _numActiveSubarrayPerRow, int _numActiveSubarrayPerColumn,
 			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			BufferDesignTarget _areaOptimizationLevel, MemoryType _memoryType);
@@ -64,6 +65,7 @@ public:
 	/* Properties */
 	bool initialized;	/* Initialization flag */
 	bool invalid;		/* Indicate that the current configuration is not valid, pass down to all the sub-components */
+	InvalidScope invalidScope;	/* The other designs that are invalid for the same reason */
 	bool internalSenseAmp;
 	int numRowSubarray;		/* Number of subarray rows in a mat */
 	int numColumnSubarray;	/* Number of subarray columns in a mat */
@@ -83,6 +85,7 @@ public:
 	double predecoderLatency;	/* The maximum latency of all the predecoder blocks, Unit: s */
 
 	SubArray subarray;
+	SubArrayKey subarrayKey;	/* Where the subarray is in the subarray cache */
 	PredecodeBlock rowPredecoderBlock1;
 	PredecodeBlock rowPredecoderBlock2;
 	PredecodeBlock bitlineMuxPredecoderBlock1;
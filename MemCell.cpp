@@ -37,7 +37,6 @@
 
 #include "MemCell.h"
 #include "formula.h"
-#include "global.h"
 #include "macros.h"
 #include <math.h>
 
@@ -46,6 +45,8 @@ MemCell::MemCell() {
 	memCellType         = PCRAM;
 	area                = 0;
 	aspectRatio         = 0;
+	widthInFeatureSize  = 0;
+	heightInFeatureSize = 0;
 	resistanceOn        = 0;
 	resistanceOff       = 0;
 	readMode            = true;
@@ -75,6 +76,8 @@ MemCell::MemCell() {
 	voltageDropAccessDevice = 0;
 	leakageCurrentAccessDevice = 0;
 	capDRAMCell		  = 0;
+	capacitanceOn     = 0;
+	capacitanceOff    = 0;
 	widthSRAMCellNMOS = 2.08;	/* Default NMOS width in SRAM cells is 2.08 (from CACTI) */
 	widthSRAMCellPMOS = 1.23;	/* Default PMOS width in SRAM cells is 1.23 (from CACTI) */
 
@@ -88,6 +91,15 @@ MemCell::MemCell() {
 	resistanceOffAtReadVoltage = 0;
 	resistanceOnAtHalfReadVoltage = 0;
 	resistanceOffAtHalfReadVoltage = 0;
+	resistanceOnAtHalfResetVoltage = 0;
+
+	/* For NAND flash */
+	flashEraseVoltage = 0;
+	flashPassVoltage = 0;
+	flashProgramVoltage = 0;
+	flashEraseTime = 0;
+	flashProgramTime = 0;
+	gateCouplingRatio = 0;
 }
 
 MemCell::~MemCell() {
@@ -97,14 +109,30 @@ MemCell::~MemCell() {
 void MemCell::ReadCellFromFile(const string & inputFile)
 {
 	FILE *fp = fopen(inputFile.c_str(), "r");
-	char line[5000];
-	char tmp[5000];
 
 	if (!fp) {
 		cout << inputFile << " cannot be found!\n";
 		exit(-1);
 	}
 
+	ReadCell(fp);
+	fclose(fp);
+}
+
+void MemCell::ReadCellFromText(const string & inputText)
+{
+	if (inputText.empty())
+		return;
+	FILE *fp = fmemopen((void *)inputText.c_str(), inputText.size(), "r");
+	ReadCell(fp);
+	fclose(fp);
+}
+
+void MemCell::ReadCell(FILE *fp)
+{
+	char line[5000];
+	char tmp[5000];
+
 	while (fscanf(fp, "%[^\n]\n", line) != EOF) {
 		if (!strncmp("-MemCellType", line, strlen("-MemCellType"))) {
 			sscanf(line, "-MemCellType: %s", tmp);
@@ -425,8 +453,6 @@ void MemCell::ReadCellFromFile(const string & inputFile)
 			continue;
 		}
 	}
-
-	fclose(fp);
 }
 
 
@@ -497,7 +523,7 @@ double MemCell::GetMemristance(double _relativeReadVoltage) { /* Get the LRS res
 	}
 }
 
-void MemCell::CalculateWriteEnergy() {
+void MemCell::CalculateWriteEnergy(double _vdd) {
 	if (resetEnergy == 0) {
 		if (resetMode) {
 			if (memCellType == memristor)
@@ -513,7 +539,7 @@ void MemCell::CalculateWriteEnergy() {
 				resetEnergy = fabs(resetVoltage) * (fabs(resetVoltage) - voltageDropAccessDevice) / resistanceOn * resetPulse;
 		} else {
 			if (resetVoltage == 0){
-				resetEnergy = tech->vdd * fabs(resetCurrent) * resetPulse; /*TO-DO consider charge pump*/
+				resetEnergy = _vdd * fabs(resetCurrent) * resetPulse; /*TO-DO consider charge pump*/
 			} else {
 				resetEnergy = fabs(resetVoltage) * fabs(resetCurrent) * resetPulse;
 			}
@@ -547,7 +573,7 @@ void MemCell::CalculateWriteEnergy() {
 				setEnergy = fabs(setVoltage) * (fabs(setVoltage) - voltageDropAccessDevice) / resistanceOn * setPulse;
 		} else {
 			if (resetVoltage == 0){
-				setEnergy = tech->vdd * fabs(setCurrent) * setPulse; /*TO-DO consider charge pump*/
+				setEnergy = _vdd * fabs(setCurrent) * setPulse; /*TO-DO consider charge pump*/
 			} else {
 				setEnergy = fabs(setVoltage) * fabs(setCurrent) * setPulse;
 			}
@@ -568,21 +594,21 @@ void MemCell::CalculateWriteEnergy() {
 	}
 }
 
-double MemCell::CalculateReadPower() { /* TO-DO consider charge pumped read voltage */
+double MemCell::CalculateReadPower(double _vdd) { /* TO-DO consider charge pumped read voltage */
 	if (readPower == 0) {
-		if (cell->readMode) {	/* voltage-sensing */
+		if (readMode) {	/* voltage-sensing */
 			if (readVoltage == 0) { /* Current-in voltage sensing */
-				return tech->vdd * readCurrent;
+				return _vdd * readCurrent;
 			}
 			if (readCurrent == 0) { /*Voltage-divider sensing */
 				double resInSerialForSenseAmp, maxBitlineCurrent;
 				resInSerialForSenseAmp = sqrt(resistanceOn * resistanceOff);
 				maxBitlineCurrent = (readVoltage - voltageDropAccessDevice) / (resistanceOn + resInSerialForSenseAmp);
-				return tech->vdd * maxBitlineCurrent;
+				return _vdd * maxBitlineCurrent;
 			}
 		} else { /* current-sensing */
 			double maxBitlineCurrent = (readVoltage - voltageDropAccessDevice) / resistanceOn;
-			return tech->vdd * maxBitlineCurrent;
+			return _vdd * maxBitlineCurrent;
 		}
 	} else {
 		return -1.0; /* should not call the function if read energy exists */
@@ -698,3 +724,60 @@ void MemCell::PrintCell()
 		cout << "Gate Coupling Ratio: " << gateCouplingRatio << endl;
 	}
 }
+
+
+void MemCell::PrintCanonical(ostream &outputFile)
+{
+	outputFile << "memCellType=" << (int)memCellType << endl;
+	outputFile << "processNode=" << processNode << endl;
+	outputFile << "area=" << area << endl;
+	outputFile << "aspectRatio=" << aspectRatio << endl;
+	outputFile << "widthInFeatureSize=" << widthInFeatureSize << endl;
+	outputFile << "heightInFeatureSize=" << heightInFeatureSize << endl;
+	outputFile << "resistanceOn=" << resistanceOn << endl;
+	outputFile << "resistanceOff=" << resistanceOff << endl;
+	outputFile << "capacitanceOn=" << capacitanceOn << endl;
+	outputFile << "capacitanceOff=" << capacitanceOff << endl;
+	outputFile << "readMode=" << (int)readMode << endl;
+	outputFile << "readVoltage=" << readVoltage << endl;
+	outputFile << "readCurrent=" << readCurrent << endl;
+	outputFile << "minSenseVoltage=" << minSenseVoltage << endl;
+	outputFile << "wordlineBoostRatio=" << wordlineBoostRatio << endl;
+	outputFile << "readPower=" << readPower << endl;
+	outputFile << "resetMode=" << (int)resetMode << endl;
+	outputFile << "resetVoltage=" << resetVoltage << endl;
+	outputFile << "resetCurrent=" << resetCurrent << endl;
+	outputFile << "resetPulse=" << resetPulse << endl;
+	outputFile << "resetEnergy=" << resetEnergy << endl;
+	outputFile << "setMode=" << (int)setMode << endl;
+	outputFile << "setVoltage=" << setVoltage << endl;
+	outputFile << "setCurrent=" << setCurrent << endl;
+	outputFile << "setPulse=" << setPulse << endl;
+	outputFile << "setEnergy=" << setEnergy << endl;
+	outputFile << "accessType=" << (int)accessType << endl;
+	outputFile << "stitching=" << stitching << endl;
+	outputFile << "gateOxThicknessFactor=" << gateOxThicknessFactor << endl;
+	outputFile << "widthSOIDevice=" << widthSOIDevice << endl;
+	outputFile << "widthAccessCMOS=" << widthAccessCMOS << endl;
+	outputFile << "voltageDropAccessDevice=" << voltageDropAccessDevice << endl;
+	outputFile << "leakageCurrentAccessDevice=" << leakageCurrentAccessDevice << endl;
+	outputFile << "capDRAMCell=" << capDRAMCell << endl;
+	outputFile << "widthSRAMCellNMOS=" << widthSRAMCellNMOS << endl;
+	outputFile << "widthSRAMCellPMOS=" << widthSRAMCellPMOS << endl;
+	outputFile << "readFloating=" << (int)readFloating << endl;
+	outputFile << "resistanceOnAtSetVoltage=" << resistanceOnAtSetVoltage << endl;
+	outputFile << "resistanceOffAtSetVoltage=" << resistanceOffAtSetVoltage << endl;
+	outputFile << "resistanceOnAtResetVoltage=" << resistanceOnAtResetVoltage << endl;
+	outputFile << "resistanceOffAtResetVoltage=" << resistanceOffAtResetVoltage << endl;
+	outputFile << "resistanceOnAtReadVoltage=" << resistanceOnAtReadVoltage << endl;
+	outputFile << "resistanceOffAtReadVoltage=" << resistanceOffAtReadVoltage << endl;
+	outputFile << "resistanceOnAtHalfReadVoltage=" << resistanceOnAtHalfReadVoltage << endl;
+	outputFile << "resistanceOffAtHalfReadVoltage=" << resistanceOffAtHalfReadVoltage << endl;
+	outputFile << "resistanceOnAtHalfResetVoltage=" << resistanceOnAtHalfResetVoltage << endl;
+	outputFile << "flashEraseVoltage=" << flashEraseVoltage << endl;
+	outputFile << "flashPassVoltage=" << flashPassVoltage << endl;
+	outputFile << "flashProgramVoltage=" << flashProgramVoltage << endl;
+	outputFile << "flashEraseTime=" << flashEraseTime << endl;
+	outputFile << "flashProgramTime=" << flashProgramTime << endl;
+	outputFile << "gateCouplingRatio=" << gateCouplingRatio << endl;
+}
@@ -54,11 +54,13 @@ public:
 
 	/* Functions */
 	void ReadCellFromFile(const std::string & inputFile);
+	void ReadCellFromText(const std::string & inputText);	/* The same format as the .cell file */
 	void CellScaling(int _targetProcessNode);
 	double GetMemristance(double _relativeReadVoltage);  /* Get the LRS resistance of memristor at log-linera region of I-V curve */
-	void CalculateWriteEnergy();
-	double CalculateReadPower();
+	void CalculateWriteEnergy(double _vdd);	/* _vdd is the supply voltage of the peripheral circuitry, Unit: V */
+	double CalculateReadPower(double _vdd);
 	void PrintCell();
+	void PrintCanonical(ostream &outputFile);	/* Every parsed field, one per line in a fixed order */
 
 	/* Properties */
 	MemCellType memCellType;	/* Memory cell type (like MRAM, PCRAM, etc.) */
@@ -119,6 +121,9 @@ public:
 	double flashEraseTime;			/* The flash erase time, Unit: s */
 	double flashProgramTime;		/* The SLC flash program time, Unit: s */
 	double gateCouplingRatio;		/* The ratio of control gate to total floating gate capacitance */
+
+private:
+	void ReadCell(FILE *fp);
 };
 
 #endif /* MEMCELL_H_ */
@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "ModelLibrary.h"
+#include "SimulationContext.h"
+
+void ModelKey::Initialize(const InputParameter &_inputParameter, const string &_cell) {
+	processNode = _inputParameter.processNode;
+	deviceRoadmap = _inputParameter.deviceRoadmap;
+	temperature = _inputParameter.temperature;
+	cell = _cell;
+	maxNmosSize = _inputParameter.maxNmosSize;
+	designTarget = _inputParameter.designTarget;
+	cacheAccessMode = _inputParameter.cacheAccessMode;
+	associativity = _inputParameter.associativity;
+	pageSize = _inputParameter.pageSize;
+	flashBlockSize = _inputParameter.flashBlockSize;
+	writeScheme = _inputParameter.writeScheme;
+}
+
+bool ModelKey::operator<(const ModelKey &rhs) const {
+	if (processNode != rhs.processNode)
+		return processNode < rhs.processNode;
+	if (deviceRoadmap != rhs.deviceRoadmap)
+		return deviceRoadmap < rhs.deviceRoadmap;
+	if (temperature != rhs.temperature)
+		return temperature < rhs.temperature;
+	if (cell != rhs.cell)
+		return cell < rhs.cell;
+	if (maxNmosSize != rhs.maxNmosSize)
+		return maxNmosSize < rhs.maxNmosSize;
+	if (designTarget != rhs.designTarget)
+		return designTarget < rhs.designTarget;
+	if (cacheAccessMode != rhs.cacheAccessMode)
+		return cacheAccessMode < rhs.cacheAccessMode;
+	if (associativity != rhs.associativity)
+		return associativity < rhs.associativity;
+	if (pageSize != rhs.pageSize)
+		return pageSize < rhs.pageSize;
+	if (flashBlockSize != rhs.flashBlockSize)
+		return flashBlockSize < rhs.flashBlockSize;
+	return writeScheme < rhs.writeScheme;
+}
+
+ModelLibrary::ModelLibrary() {
+	// TODO Auto-generated constructor stub
+	numModel = 0;
+}
+
+ModelLibrary::~ModelLibrary() {
+	// TODO Auto-generated destructor stub
+	for (ModelMap::iterator it = model.begin(); it != model.end(); it++)
+		delete it->second;
+}
+
+SimulationContext * ModelLibrary::GetModel(const SimulationContext &_context, const string &_cell) {
+	ModelKey key;
+	key.Initialize(*_context.inputParameter, _cell);
+
+	lock_guard<mutex> guard(lock);
+	ModelMap::iterator it = model.find(key);
+	if (it != model.end())
+		return it->second;
+	SimulationContext *newModel = new SimulationContext();
+	newModel->InitializeModel(*_context.inputParameter, *_context.cell);
+	model[key] = newModel;
+	numModel = (int)model.size();
+	return newModel;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef MODELLIBRARY_H_
+#define MODELLIBRARY_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "typedef.h"
+
+using namespace std;
+
+class SimulationContext;
+class InputParameter;
+
+/* Everything the technology, the wires and the subarrays read from a configuration
+ * besides their own parameters */
+struct ModelKey {
+	int processNode;
+	DeviceRoadmap deviceRoadmap;
+	int temperature;
+	string cell;		/* The cell file, or the cell description when it is given inline */
+	double maxNmosSize;
+	DesignTarget designTarget;
+	CacheAccessMode cacheAccessMode;
+	int associativity;
+	long pageSize;
+	long flashBlockSize;
+	WriteScheme writeScheme;
+
+	void Initialize(const InputParameter &_inputParameter, const string &_cell);
+	bool operator<(const ModelKey &rhs) const;
+};
+
+/* The technology, wire library and subarray cache of every ModelKey seen so far. The
+ * contexts of a batch take them from here, so the configurations with the same key
+ * build each technology, wire and subarray only once. Each key is backed by a model
+ * context that keeps its own copy of the configuration and the cell. */
+class ModelLibrary {
+public:
+	ModelLibrary();
+	virtual ~ModelLibrary();
+
+	/* Functions */
+	SimulationContext * GetModel(const SimulationContext &_context, const string &_cell);	/* The model context for the configuration and cell of _context */
+
+	/* Properties */
+	int numModel;		/* Number of distinct model contexts built so far */
+
+private:
+	typedef map<ModelKey, SimulationContext *> ModelMap;
+
+	mutex lock;
+	ModelMap model;
+};
+
+#endif /* MODELLIBRARY_H_ */
@@ -36,7 +36,8 @@
 
 
 #include "Mux.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 #include "formula.h"
 
 Mux::Mux() {
@@ -52,7 +53,9 @@ Mux::~Mux() {
 	// TODO Auto-generated destructor stub
 }
 
-void Mux::Initialize(int _numInput, long long _numMux, double _capLoad, double _capInputNextStage, double _minDriverCurrent){
+void Mux::Initialize(SimulationContext *_context, int _numInput, long long _numMux, double _capLoad, double _capInputNextStage, double _minDriverCurrent){
+	context = _context;
+	PROFILE_STAGE(mux_profile, initialize_stage);
 	if (initialized)
 		cout << "[Mux] Warning: Already initialized!" << endl;
 
@@ -63,18 +66,18 @@ void Mux::Initialize(int _numInput, long long _numMux, double _capLoad, double _
 	minDriverCurrent = _minDriverCurrent;
 
 	if ((numInput > 1) && (numMux > 0 )) {
-		double minNMOSWidth = minDriverCurrent / tech->currentOnNmos[inputParameter->temperature - 300];
-		if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor) {
+		double minNMOSWidth = minDriverCurrent / context->techView.currentOnNmos;
+		if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor) {
 			/* Mux resistance should be small enough for voltage dividing */
-			double maxResNMOSPassTransistor = cell->resistanceOn * IR_DROP_TOLERANCE;
-	    	widthNMOSPassTransistor = CalculateOnResistance(tech->featureSize, NMOS, inputParameter->temperature, *tech)
-					* tech->featureSize / maxResNMOSPassTransistor;
-	    	if (widthNMOSPassTransistor > inputParameter->maxNmosSize * tech->featureSize) {	// Change the transistor size to avoid severe IR drop
-	    		widthNMOSPassTransistor = inputParameter->maxNmosSize * tech->featureSize;
+			double maxResNMOSPassTransistor = context->cell->resistanceOn * IR_DROP_TOLERANCE;
+	    	widthNMOSPassTransistor = CalculateOnResistance(context->tech->featureSize, NMOS, context->techView)
+					* context->tech->featureSize / maxResNMOSPassTransistor;
+	    	if (widthNMOSPassTransistor > context->inputParameter->maxNmosSize * context->tech->featureSize) {	// Change the transistor size to avoid severe IR drop
+	    		widthNMOSPassTransistor = context->inputParameter->maxNmosSize * context->tech->featureSize;
 	    	}
-			widthNMOSPassTransistor = MAX(MAX(widthNMOSPassTransistor,minNMOSWidth), 6 * MIN_NMOS_SIZE * tech->featureSize);
+			widthNMOSPassTransistor = MAX(MAX(widthNMOSPassTransistor,minNMOSWidth), 6 * MIN_NMOS_SIZE * context->tech->featureSize);
 		} else {
-			widthNMOSPassTransistor = MAX(6 * MIN_NMOS_SIZE * tech->featureSize, minNMOSWidth);
+			widthNMOSPassTransistor = MAX(6 * MIN_NMOS_SIZE * context->tech->featureSize, minNMOSWidth);
 		}
 	}
 
@@ -82,12 +85,13 @@ void Mux::Initialize(int _numInput, long long _numMux, double _capLoad, double _
 }
 
 void Mux::CalculateArea(){
+	PROFILE_STAGE(mux_profile, area_stage);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
 		if ((numInput > 1) && (numMux > 0 )) {
 			double h,w;
-			CalculateGateArea(INV, 1, widthNMOSPassTransistor, 0, tech->featureSize*40, *tech, &h, &w);
+			CalculateGateArea(INV, 1, widthNMOSPassTransistor, 0, context->tech->featureSize*40, context->techView, &h, &w);
 			width = numMux * numInput * w;
 			height = h;
 			area = width * height;
@@ -98,15 +102,16 @@ void Mux::CalculateArea(){
 }
 
 void Mux::CalculateRC() {
+	PROFILE_STAGE(mux_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
 		if ((numInput > 1) && (numMux > 0 )) {
-			capNMOSPassTransistor = CalculateDrainCap(widthNMOSPassTransistor, NMOS, tech->featureSize*40, *tech);
+			capNMOSPassTransistor = CalculateDrainCap(widthNMOSPassTransistor, NMOS, context->tech->featureSize*40, context->techView);
 			capForPreviousPowerCalculation = capNMOSPassTransistor;
 			capOutput = numInput * capNMOSPassTransistor;
 			capForPreviousDelayCalculation = capOutput + capNMOSPassTransistor + capLoad;
-			resNMOSPassTransistor = CalculateOnResistance(widthNMOSPassTransistor, NMOS, inputParameter->temperature, *tech);
+			resNMOSPassTransistor = CalculateOnResistance(widthNMOSPassTransistor, NMOS, context->techView);
 		} else {
 			;	/* nothing to do */
 		}
@@ -115,6 +120,7 @@ void Mux::CalculateRC() {
 
 void Mux::CalculateLatency(double _rampInput) {  //rampInput is actually useless in Mux module
 	if (!initialized) {
+	PROFILE_STAGE(mux_profile, latency_stage);
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
 		if ((numInput > 1) && (numMux > 0 )) {
@@ -130,12 +136,13 @@ void Mux::CalculateLatency(double _rampInput) {  //rampInput is actually useless
 }
 
 void Mux::CalculatePower() {
+	PROFILE_STAGE(mux_profile, power_stage);
 	if (!initialized) {
 		cout << "[Mux] Error: Require initialization first!" << endl;
 	} else {
 		if ((numInput > 1) && (numMux > 0 )) {
 			leakage = 0; //TO-DO
-			readDynamicEnergy = (capOutput + capInputNextStage) * tech->vdd * (tech->vdd - tech->vth);
+			readDynamicEnergy = (capOutput + capInputNextStage) * context->tech->vdd * (context->tech->vdd - context->tech->vth);
 			readDynamicEnergy *= numMux;  //worst-case dynamic power analysis
 			writeDynamicEnergy = readDynamicEnergy;
 		} else {
@@ -158,6 +165,7 @@ Mux & Mux::operator=(const Mux &rhs) {
 	readDynamicEnergy = rhs.readDynamicEnergy;
 	writeDynamicEnergy = rhs.writeDynamicEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	numInput = rhs.numInput;
 	numMux = rhs.numMux;
@@ -47,7 +47,7 @@ public:
 	virtual ~Mux();
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numInput, long long _numMux, double _capLoad, double _capInputNextStage, double _minDriverCurrent);
+	void Initialize(SimulationContext *_context, int _numInput, long long _numMux, double _capLoad, double _capInputNextStage, double _minDriverCurrent);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
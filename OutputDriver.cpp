@@ -36,7 +36,8 @@
 
 
 #include "OutputDriver.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 #include "formula.h"
 #include <math.h>
 
@@ -49,8 +50,10 @@ OutputDriver::~OutputDriver() {
 	// TODO Auto-generated destructor stub
 }
 
-void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _outputCap, double _outputRes,
+void OutputDriver::Initialize(SimulationContext *_context, double _logicEffort, double _inputCap, double _outputCap, double _outputRes,
 		bool _inv, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent) {
+	context = _context;
+	PROFILE_STAGE(output_driver_profile, initialize_stage);
 	if (initialized)
 		cout << "[Output Driver] Warning: Already initialized!" << endl;
 
@@ -62,11 +65,12 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 	areaOptimizationLevel = _areaOptimizationLevel;
 	minDriverCurrent = _minDriverCurrent;
 
-	double minNMOSDriverWidth = minDriverCurrent / tech->currentOnNmos[inputParameter->temperature - 300];
-	minNMOSDriverWidth = MAX(MIN_NMOS_SIZE * tech->featureSize, minNMOSDriverWidth);
+	double minNMOSDriverWidth = minDriverCurrent / context->techView.currentOnNmos;
+	minNMOSDriverWidth = MAX(MIN_NMOS_SIZE * context->tech->featureSize, minNMOSDriverWidth);
 
-	if (minNMOSDriverWidth > inputParameter->maxNmosSize * tech->featureSize) {
+	if (minNMOSDriverWidth > context->inputParameter->maxNmosSize * context->tech->featureSize) {
 		invalid = true;
+		PROFILE_EVENT(invalid_output_driver_event);
 		return;
 	}
 
@@ -90,15 +94,15 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 		double f = pow(F, 1.0 / (optimalNumStage + 1));	/* Logic effort per stage */
 		double inputCapLast = outputCap / f;
 
-		widthNMOS[optimalNumStage-1] = MAX(MIN_NMOS_SIZE * tech->featureSize,
-				inputCapLast / CalculateGateCap(1/*meter*/, *tech) / (1.0 + tech->pnSizeRatio));
+		widthNMOS[optimalNumStage-1] = MAX(MIN_NMOS_SIZE * context->tech->featureSize,
+				inputCapLast / CalculateGateCap(1/*meter*/, context->techView) / (1.0 + context->tech->pnSizeRatio));
 
-		if (widthNMOS[optimalNumStage-1] > inputParameter->maxNmosSize * tech->featureSize) {
+		if (widthNMOS[optimalNumStage-1] > context->inputParameter->maxNmosSize * context->tech->featureSize) {
 			if (WARNING)
 				cout << "[WARNING] Exceed maximum NMOS size!" << endl;
-			widthNMOS[optimalNumStage-1] = inputParameter->maxNmosSize * tech->featureSize;
+			widthNMOS[optimalNumStage-1] = context->inputParameter->maxNmosSize * context->tech->featureSize;
 			/* re-Calculate the logic effort */
-			double capLastStage = CalculateGateCap((1 + tech->pnSizeRatio) * inputParameter->maxNmosSize * tech->featureSize, *tech);
+			double capLastStage = CalculateGateCap((1 + context->tech->pnSizeRatio) * context->inputParameter->maxNmosSize * context->tech->featureSize, context->techView);
 			F = logicEffort * capLastStage / inputCap;
 			f =	pow(F, 1.0 / (optimalNumStage));
 		}
@@ -107,22 +111,22 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 			/* the last level Inv can not provide minimum current so that the Inv chain can't only decided by Logic Effort */
 			areaOptimizationLevel = latency_area_trade_off;
 		} else {
-			widthPMOS[optimalNumStage-1] = widthNMOS[optimalNumStage-1] * tech->pnSizeRatio;
+			widthPMOS[optimalNumStage-1] = widthNMOS[optimalNumStage-1] * context->tech->pnSizeRatio;
 
 			for (int i = optimalNumStage-2; i >= 0; i--) {
 				widthNMOS[i] = widthNMOS[i+1] / f;
-				if (widthNMOS[i] < MIN_NMOS_SIZE * tech->featureSize) {
+				if (widthNMOS[i] < MIN_NMOS_SIZE * context->tech->featureSize) {
 					if (WARNING)
 						cout << "[WARNING] Exceed minimum NMOS size!" << endl;
-					widthNMOS[i] = MIN_NMOS_SIZE * tech->featureSize;
+					widthNMOS[i] = MIN_NMOS_SIZE * context->tech->featureSize;
 				}
-				widthPMOS[i] = widthNMOS[i] * tech->pnSizeRatio;
+				widthPMOS[i] = widthNMOS[i] * context->tech->pnSizeRatio;
 			}
 		}
 	}
 
 	if (areaOptimizationLevel == latency_area_trade_off){
-		double newOutputCap = CalculateGateCap(minNMOSDriverWidth, *tech) * (1.0 + tech->pnSizeRatio);
+		double newOutputCap = CalculateGateCap(minNMOSDriverWidth, context->techView) * (1.0 + context->tech->pnSizeRatio);
 		double F = MAX(1, logicEffort * newOutputCap / inputCap);	/* Total logic effort */
 		optimalNumStage = MAX(0, (int)(log(F) / log(OPT_F) + 0.5) - 1);
 
@@ -138,28 +142,29 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 		numStage = optimalNumStage + 1;
 
 		widthNMOS[optimalNumStage] = minNMOSDriverWidth;
-		widthPMOS[optimalNumStage] = widthNMOS[optimalNumStage] * tech->pnSizeRatio;
+		widthPMOS[optimalNumStage] = widthNMOS[optimalNumStage] * context->tech->pnSizeRatio;
 
 		double f = pow(F, 1.0 / (optimalNumStage + 1));	/* Logic effort per stage */
 
 		for (int i = optimalNumStage - 1; i >= 0; i--) {
 			widthNMOS[i] = widthNMOS[i+1] / f;
-			if (widthNMOS[i] < MIN_NMOS_SIZE * tech->featureSize) {
+			if (widthNMOS[i] < MIN_NMOS_SIZE * context->tech->featureSize) {
 				if (WARNING)
 					cout << "[WARNING] Exceed minimum NMOS size!" << endl;
-				widthNMOS[i] = MIN_NMOS_SIZE * tech->featureSize;
+				widthNMOS[i] = MIN_NMOS_SIZE * context->tech->featureSize;
 			}
-			widthPMOS[i] = widthNMOS[i] * tech->pnSizeRatio;
+			widthPMOS[i] = widthNMOS[i] * context->tech->pnSizeRatio;
 		}
 	} else if (areaOptimizationLevel == area_first) {
 		optimalNumStage = 1;
 		numStage = 1;
-		widthNMOS[optimalNumStage - 1] = MAX(MIN_NMOS_SIZE * tech->featureSize, minNMOSDriverWidth);
-		if (widthNMOS[optimalNumStage - 1] > AREA_OPT_CONSTRAIN * inputParameter->maxNmosSize * tech->featureSize) {
+		widthNMOS[optimalNumStage - 1] = MAX(MIN_NMOS_SIZE * context->tech->featureSize, minNMOSDriverWidth);
+		if (widthNMOS[optimalNumStage - 1] > AREA_OPT_CONSTRAIN * context->inputParameter->maxNmosSize * context->tech->featureSize) {
 			invalid = true;
+			PROFILE_EVENT(invalid_output_driver_event);
 			return;
 		}
-		widthPMOS[optimalNumStage - 1] = widthNMOS[optimalNumStage - 1] * tech->pnSizeRatio;
+		widthPMOS[optimalNumStage - 1] = widthNMOS[optimalNumStage - 1] * context->tech->pnSizeRatio;
 	}
 
 	/* Restore the original buffer design style */
@@ -169,6 +174,7 @@ void OutputDriver::Initialize(double _logicEffort, double _inputCap, double _out
 }
 
 void OutputDriver::CalculateArea() {
+	PROFILE_STAGE(output_driver_profile, area_stage);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -178,7 +184,7 @@ void OutputDriver::CalculateArea() {
 		double totalWidth = 0;
 		double h, w;
 		for (int i = 0; i < numStage; i++) {
-			CalculateGateArea(INV, 1, widthNMOS[i], widthPMOS[i], tech->featureSize*40, *tech, &h, &w);
+			CalculateGateArea(INV, 1, widthNMOS[i], widthPMOS[i], context->tech->featureSize*40, context->techView, &h, &w);
 			totalHeight = MAX(totalHeight, h);
 			totalWidth += w;
 		}
@@ -189,6 +195,7 @@ void OutputDriver::CalculateArea() {
 }
 
 void OutputDriver::CalculateRC() {
+	PROFILE_STAGE(output_driver_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -197,12 +204,13 @@ void OutputDriver::CalculateRC() {
 		capInput[0] = 0;
 	} else {
 		for (int i = 0; i < numStage; i++) {
-			CalculateGateCapacitance(INV, 1, widthNMOS[i], widthPMOS[i], tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech, &(capInput[i]), &(capOutput[i]));
+			CalculateGateCapacitance(INV, 1, widthNMOS[i], widthPMOS[i], context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView, &(capInput[i]), &(capOutput[i]));
 		}
 	}
 }
 
 void OutputDriver::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(output_driver_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -217,19 +225,19 @@ void OutputDriver::CalculateLatency(double _rampInput) {
 		double temp;
 		readLatency = 0;
 		for (int i = 0; i < numStage - 1; i++) {
-			resPullDown = CalculateOnResistance(widthNMOS[i], NMOS, inputParameter->temperature, *tech);
+			resPullDown = CalculateOnResistance(widthNMOS[i], NMOS, context->techView);
 			capLoad = capOutput[i] + capInput[i+1];
 			tr = resPullDown * capLoad;
-			gm = CalculateTransconductance(widthNMOS[i], NMOS, *tech);
+			gm = CalculateTransconductance(widthNMOS[i], NMOS, context->techView);
 			beta = 1 / (resPullDown * gm);
 			readLatency += horowitz(tr, beta, rampInput, &temp);
 			rampInput = temp;	/* for next stage */
 		}
 		/* Last level inverter */
-		resPullDown = CalculateOnResistance(widthNMOS[numStage-1], NMOS, inputParameter->temperature, *tech);
+		resPullDown = CalculateOnResistance(widthNMOS[numStage-1], NMOS, context->techView);
 		capLoad = capOutput[numStage-1] + outputCap;
 		tr = resPullDown * capLoad + outputCap * outputRes / 2;
-		gm = CalculateTransconductance(widthNMOS[numStage-1], NMOS, *tech);
+		gm = CalculateTransconductance(widthNMOS[numStage-1], NMOS, context->techView);
 		beta = 1 / (resPullDown * gm);
 		readLatency += horowitz(tr, beta, rampInput, &rampOutput);
 		rampInput = _rampInput;
@@ -238,6 +246,7 @@ void OutputDriver::CalculateLatency(double _rampInput) {
 }
 
 void OutputDriver::CalculatePower() {
+	PROFILE_STAGE(output_driver_profile, power_stage);
 	if (!initialized) {
 		cout << "[Output Driver] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -246,18 +255,18 @@ void OutputDriver::CalculatePower() {
 		/* Leakage power */
 		leakage = 0;
 		for (int i = 0; i < numStage; i++) {
-			leakage += CalculateGateLeakage(INV, 1, widthNMOS[i], widthPMOS[i], inputParameter->temperature, *tech)
-					* tech->vdd;
+			leakage += CalculateGateLeakage(INV, 1, widthNMOS[i], widthPMOS[i], context->techView)
+					* context->tech->vdd;
 		}
 		/* Dynamic energy */
 		readDynamicEnergy = 0;
 		double capLoad;
 		for (int i = 0; i < numStage - 1; i++) {
 			capLoad = capOutput[i] + capInput[i+1];
-			readDynamicEnergy += capLoad * tech->vdd * tech->vdd;
+			readDynamicEnergy += capLoad * context->tech->vdd * context->tech->vdd;
 		}
 		capLoad = capOutput[numStage-1] + outputCap;	/* outputCap here means the final load capacitance */
-		readDynamicEnergy += capLoad * tech->vdd * tech->vdd;
+		readDynamicEnergy += capLoad * context->tech->vdd * context->tech->vdd;
 		writeDynamicEnergy = readDynamicEnergy;
 	}
 }
@@ -284,6 +293,7 @@ OutputDriver & OutputDriver::operator=(const OutputDriver &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
 	logicEffort = rhs.logicEffort;
@@ -296,6 +306,12 @@ OutputDriver & OutputDriver::operator=(const OutputDriver &rhs) {
 	minDriverCurrent = rhs.minDriverCurrent;
 	rampInput = rhs.rampInput;
 	rampOutput = rhs.rampOutput;
+	for (int i = 0; i < MAX_INV_CHAIN_LEN; i++) {
+		widthNMOS[i] = rhs.widthNMOS[i];
+		widthPMOS[i] = rhs.widthPMOS[i];
+		capInput[i] = rhs.capInput[i];
+		capOutput[i] = rhs.capOutput[i];
+	}
 
 	return *this;
 }
@@ -49,7 +49,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(double _logicEffort, double _inputCap, double _outputCap, double _outputRes,
+	void Initialize(SimulationContext *_context, double _logicEffort, double _inputCap, double _outputCap, double _outputRes,
 			bool _inv, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent);
 	void CalculateArea();
 	void CalculateRC();
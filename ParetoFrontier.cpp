@@ -0,0 +1,368 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "ParetoFrontier.h"
+#include "Result.h"
+#include "constant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+bool ParetoPoint::Dominates(const ParetoPoint &rhs) const {
+	bool strictlyBetter = true;
+	for (int i = 0; i < (int)num_objective; i++) {
+		if (objective[i] < 0 || !(objective[i] <= rhs.objective[i]))
+			return false;	/* the EDP is only monotone for non-negative metrics */
+		if (!(objective[i] < rhs.objective[i]))
+			strictlyBetter = false;
+	}
+	if (sequence < rhs.sequence)
+		return true;
+	/* The products can round to the same value, the EDP has to be strictly better as well */
+	return strictlyBetter
+			&& objective[read_latency_objective] * objective[read_energy_objective]
+				< rhs.objective[read_latency_objective] * rhs.objective[read_energy_objective]
+			&& objective[write_latency_objective] * objective[write_energy_objective]
+				< rhs.objective[write_latency_objective] * rhs.objective[write_energy_objective];
+}
+
+static bool CompareSequence(const ParetoPoint &lhs, const ParetoPoint &rhs) {
+	return lhs.sequence < rhs.sequence;
+}
+
+static double Scale(double _value) {
+	/* Only used to cluster the points, the metrics span many orders of magnitude */
+	if (std::isfinite(_value) && _value > 0)
+		return log(_value);
+	return 0;
+}
+
+ParetoFrontier::ParetoFrontier() {
+	// TODO Auto-generated constructor stub
+	numPoint = 0;
+	root = NULL;
+}
+
+ParetoFrontier::~ParetoFrontier() {
+	// TODO Auto-generated destructor stub
+	Clear();
+}
+
+bool ParetoFrontier::Insert(const ParetoPoint &_point) {
+	if (root == NULL)
+		root = NewNode(true);
+	if (!Update(root, _point))
+		return false;
+	if (IsEmpty(root)) {
+		/* Start over with fresh bounds */
+		DeleteNode(root);
+		root = NewNode(true);
+	}
+	Add(root, _point);
+	numPoint++;
+	return true;
+}
+
+void ParetoFrontier::Merge(const ParetoFrontier &_frontier) {
+	vector<ParetoPoint> points;
+	_frontier.GetPoints(points);
+	for (int i = 0; i < (int)points.size(); i++)
+		Insert(points[i]);
+}
+
+void ParetoFrontier::Clear() {
+	if (root)
+		DeleteNode(root);
+	root = NULL;
+	numPoint = 0;
+}
+
+void ParetoFrontier::GetPoints(vector<ParetoPoint> &_points) const {
+	_points.clear();
+	if (root)
+		Collect(root, _points);
+	sort(_points.begin(), _points.end(), CompareSequence);
+}
+
+const ParetoPoint * ParetoFrontier::FindBest(Result &_constraint) const {
+	const ParetoPoint *best = NULL;
+	double bestValue = 0;
+	if (root)
+		Search(root, _constraint, &best, &bestValue);
+	return best;
+}
+
+long long ParetoFrontier::CountFeasible(Result &_constraint) const {
+	if (root)
+		return Count(root, _constraint);
+	return 0;
+}
+
+double ParetoFrontier::TargetValue(const double *_objective, OptimizationTarget _optimizationTarget) {
+	switch (_optimizationTarget) {
+	case read_latency_optimized:
+		return _objective[read_latency_objective];
+	case write_latency_optimized:
+		return _objective[write_latency_objective];
+	case read_energy_optimized:
+		return _objective[read_energy_objective];
+	case write_energy_optimized:
+		return _objective[write_energy_objective];
+	case read_edp_optimized:
+		return _objective[read_latency_objective] * _objective[read_energy_objective];
+	case write_edp_optimized:
+		return _objective[write_latency_objective] * _objective[write_energy_objective];
+	case area_optimized:
+		return _objective[area_objective];
+	case leakage_optimized:
+		return _objective[leakage_objective];
+	default:	/* Exploration */
+		/* should not happen */
+		return 0;
+	}
+}
+
+ParetoFrontier::Node * ParetoFrontier::NewNode(bool _leaf) {
+	Node *node = new Node;
+	node->leaf = _leaf;
+	for (int i = 0; i < (int)num_objective; i++) {
+		node->ideal[i] = numeric_limits<double>::infinity();
+		node->nadir[i] = -numeric_limits<double>::infinity();
+	}
+	return node;
+}
+
+void ParetoFrontier::DeleteNode(Node *_node) {
+	for (int i = 0; i < (int)_node->child.size(); i++)
+		DeleteNode(_node->child[i]);
+	delete _node;
+}
+
+bool ParetoFrontier::Update(Node *_node, const ParetoPoint &_point) {
+	/* The bounds may be loose after removals, but they are still bounds */
+	bool canBeDominated = true, canDominate = true;
+	for (int i = 0; i < (int)num_objective; i++) {
+		if (!(_node->ideal[i] <= _point.objective[i]))
+			canBeDominated = false;
+		if (!(_point.objective[i] <= _node->nadir[i]))
+			canDominate = false;
+	}
+	if (!canBeDominated && !canDominate)
+		return true;
+
+	if (_node->leaf) {
+		for (int i = 0; i < (int)_node->point.size(); ) {
+			if (canBeDominated && _node->point[i].Dominates(_point))
+				return false;
+			if (canDominate && _point.Dominates(_node->point[i])) {
+				_node->point[i] = _node->point.back();
+				_node->point.pop_back();
+				numPoint--;
+			} else {
+				i++;
+			}
+		}
+	} else {
+		for (int i = 0; i < (int)_node->child.size(); ) {
+			if (!Update(_node->child[i], _point))
+				return false;
+			if (IsEmpty(_node->child[i])) {
+				DeleteNode(_node->child[i]);
+				_node->child[i] = _node->child.back();
+				_node->child.pop_back();
+			} else {
+				i++;
+			}
+		}
+	}
+	return true;
+}
+
+void ParetoFrontier::Add(Node *_node, const ParetoPoint &_point) {
+	Extend(_node, _point.objective);
+	if (_node->leaf) {
+		_node->point.push_back(_point);
+		if ((int)_node->point.size() > PARETO_MAX_LEAF_SIZE)
+			Split(_node);
+	} else {
+		/* Go to the closest child */
+		int closest = 0;
+		double minDistance = Distance(_point.objective, _node->child[0]);
+		for (int i = 1; i < (int)_node->child.size(); i++) {
+			double distance = Distance(_point.objective, _node->child[i]);
+			if (distance < minDistance) {
+				minDistance = distance;
+				closest = i;
+			}
+		}
+		Add(_node->child[closest], _point);
+	}
+}
+
+void ParetoFrontier::Split(Node *_node) {
+	vector<ParetoPoint> points;
+	points.swap(_node->point);
+	_node->leaf = false;
+
+	int numPointToSplit = (int)points.size();
+	vector<vector<double> > scaled(numPointToSplit, vector<double>((int)num_objective));
+	for (int i = 0; i < numPointToSplit; i++)
+		for (int j = 0; j < (int)num_objective; j++)
+			scaled[i][j] = Scale(points[i].objective[j]);
+
+	/* The seeds are picked farthest-first, starting from the point that is the farthest from all the others */
+	vector<double> totalDistance(numPointToSplit, 0);
+	int seed = 0;
+	for (int i = 0; i < numPointToSplit; i++) {
+		for (int j = 0; j < numPointToSplit; j++)
+			for (int k = 0; k < (int)num_objective; k++)
+				totalDistance[i] += (scaled[i][k] - scaled[j][k]) * (scaled[i][k] - scaled[j][k]);
+		if (totalDistance[i] > totalDistance[seed])
+			seed = i;
+	}
+	vector<double> minDistance(numPointToSplit, numeric_limits<double>::infinity());	/* To the closest seed */
+	vector<bool> used(numPointToSplit, false);
+	while ((int)_node->child.size() < PARETO_NUM_CHILD) {
+		Node *child = NewNode(true);
+		Add(child, points[seed]);
+		_node->child.push_back(child);
+		used[seed] = true;
+
+		int next = -1;
+		for (int i = 0; i < numPointToSplit; i++) {
+			if (used[i])
+				continue;
+			double distance = 0;
+			for (int k = 0; k < (int)num_objective; k++)
+				distance += (scaled[i][k] - scaled[seed][k]) * (scaled[i][k] - scaled[seed][k]);
+			minDistance[i] = min(minDistance[i], distance);
+			if (next < 0 || minDistance[i] > minDistance[next])
+				next = i;
+		}
+		if (next < 0)
+			break;
+		seed = next;
+	}
+
+	for (int i = 0; i < numPointToSplit; i++) {
+		if (used[i])
+			continue;
+		int closest = 0;
+		double closestDistance = Distance(points[i].objective, _node->child[0]);
+		for (int j = 1; j < (int)_node->child.size(); j++) {
+			double distance = Distance(points[i].objective, _node->child[j]);
+			if (distance < closestDistance) {
+				closestDistance = distance;
+				closest = j;
+			}
+		}
+		Add(_node->child[closest], points[i]);
+	}
+}
+
+void ParetoFrontier::Extend(Node *_node, const double *_objective) {
+	for (int i = 0; i < (int)num_objective; i++) {
+		if (_objective[i] < _node->ideal[i])
+			_node->ideal[i] = _objective[i];
+		if (_objective[i] > _node->nadir[i])
+			_node->nadir[i] = _objective[i];
+	}
+}
+
+bool ParetoFrontier::IsEmpty(Node *_node) const {
+	if (_node->leaf)
+		return _node->point.empty();
+	return _node->child.empty();
+}
+
+double ParetoFrontier::Distance(const double *_objective, Node *_node) const {
+	/* Distance to the middle of the bounding box of the node */
+	double distance = 0;
+	for (int i = 0; i < (int)num_objective; i++) {
+		double middle = (Scale(_node->ideal[i]) + Scale(_node->nadir[i])) / 2;
+		distance += (Scale(_objective[i]) - middle) * (Scale(_objective[i]) - middle);
+	}
+	return distance;
+}
+
+void ParetoFrontier::Collect(Node *_node, vector<ParetoPoint> &_points) const {
+	if (_node->leaf)
+		_points.insert(_points.end(), _node->point.begin(), _node->point.end());
+	else
+		for (int i = 0; i < (int)_node->child.size(); i++)
+			Collect(_node->child[i], _points);
+}
+
+void ParetoFrontier::Search(Node *_node, Result &_constraint, const ParetoPoint **_best, double *_bestValue) const {
+	/* Every metric and both EDPs are monotone, the ideal point bounds the whole subtree */
+	if (!_constraint.checkLimit(_node->ideal))
+		return;
+	if (*_best && TargetValue(_node->ideal, _constraint.optimizationTarget) > *_bestValue)
+		return;
+	if (_node->leaf) {
+		for (int i = 0; i < (int)_node->point.size(); i++) {
+			const ParetoPoint &point = _node->point[i];
+			if (!_constraint.checkLimit(point.objective))
+				continue;
+			double value = TargetValue(point.objective, _constraint.optimizationTarget);
+			if (*_best == NULL || value < *_bestValue
+					|| (value == *_bestValue && point.sequence < (*_best)->sequence)) {
+				*_best = &point;
+				*_bestValue = value;
+			}
+		}
+	} else {
+		for (int i = 0; i < (int)_node->child.size(); i++)
+			Search(_node->child[i], _constraint, _best, _bestValue);
+	}
+}
+
+long long ParetoFrontier::Count(Node *_node, Result &_constraint) const {
+	if (!_constraint.checkLimit(_node->ideal))
+		return 0;
+	long long numFeasible = 0;
+	if (_node->leaf) {
+		for (int i = 0; i < (int)_node->point.size(); i++)
+			if (_constraint.checkLimit(_node->point[i].objective))
+				numFeasible++;
+	} else {
+		for (int i = 0; i < (int)_node->child.size(); i++)
+			numFeasible += Count(_node->child[i], _constraint);
+	}
+	return numFeasible;
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef PARETOFRONTIER_H_
+#define PARETOFRONTIER_H_
+
+#include <vector>
+#include "SearchSpace.h"
+#include "typedef.h"
+
+using namespace std;
+
+class Result;
+
+struct ParetoPoint {
+	double objective[(int)num_objective];	/* Indexed by ParetoObjective */
+	long long sequence;		/* The position of the design in the BIGFOR order */
+	DesignPoint design;
+
+	/* Whether every optimization target and every limit prefers this point over rhs: it is no worse in all the
+	 * objectives, and it is either met first by the serial BIGFOR or strictly better in all the objectives */
+	bool Dominates(const ParetoPoint &rhs) const;
+};
+
+/* The non-dominated designs of an exploration, kept in an ND-tree: every node knows the ideal and the nadir
+ * point of its subtree, so a new design is only compared with the few leaves that can dominate it or be
+ * dominated by it. Because of the way Dominates() breaks the ties, FindBest() picks exactly the design that
+ * Result::compareAndUpdate() would pick out of the whole BIGFOR sweep. */
+class ParetoFrontier {
+public:
+	ParetoFrontier();
+	virtual ~ParetoFrontier();
+
+	/* Functions */
+	bool Insert(const ParetoPoint &_point);	/* Return false if the point is dominated by the frontier */
+	void Merge(const ParetoFrontier &_frontier);
+	void Clear();
+	void GetPoints(vector<ParetoPoint> &_points) const;	/* In the BIGFOR order */
+	const ParetoPoint * FindBest(Result &_constraint) const;	/* For the target and the limits of _constraint, NULL if nothing meets the limits */
+	long long CountFeasible(Result &_constraint) const;		/* Number of points that meet the limits of _constraint */
+	static double TargetValue(const double *_objective, OptimizationTarget _optimizationTarget);
+
+	/* Properties */
+	long long numPoint;		/* Size of the frontier */
+
+private:
+	struct Node {
+		bool leaf;
+		double ideal[(int)num_objective];	/* The minimum of each objective in the subtree */
+		double nadir[(int)num_objective];	/* The maximum of each objective in the subtree */
+		vector<ParetoPoint> point;			/* Only for leaves */
+		vector<Node *> child;				/* Only for internal nodes */
+	};
+
+	Node * NewNode(bool _leaf);
+	void DeleteNode(Node *_node);
+	bool Update(Node *_node, const ParetoPoint &_point);	/* Remove what _point dominates, return false if _point is dominated */
+	void Add(Node *_node, const ParetoPoint &_point);
+	void Split(Node *_node);
+	void Extend(Node *_node, const double *_objective);
+	bool IsEmpty(Node *_node) const;
+	double Distance(const double *_objective, Node *_node) const;
+	void Collect(Node *_node, vector<ParetoPoint> &_points) const;
+	void Search(Node *_node, Result &_constraint, const ParetoPoint **_best, double *_bestValue) const;
+	long long Count(Node *_node, Result &_constraint) const;
+
+	Node *root;
+};
+
+#endif /* PARETOFRONTIER_H_ */
@@ -37,7 +37,8 @@
 
 #include "Precharger.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 Precharger::Precharger() {
 	// TODO Auto-generated constructor stub
@@ -49,7 +50,9 @@ Precharger::~Precharger() {
 	// TODO Auto-generated destructor stub
 }
 
-void Precharger::Initialize(double _voltagePrecharge, int _numColumn, double _capBitline, double _resBitline){
+void Precharger::Initialize(SimulationContext *_context, double _voltagePrecharge, int _numColumn, double _capBitline, double _resBitline){
+	context = _context;
+	PROFILE_STAGE(precharger_profile, initialize_stage);
 	if (initialized)
 		cout << "[Precharger] Warning: Already initialized!" << endl;
 
@@ -57,25 +60,26 @@ void Precharger::Initialize(double _voltagePrecharge, int _numColumn, double _ca
 	numColumn  = _numColumn;
 	capBitline = _capBitline;
 	resBitline = _resBitline;
-	capWireLoadPerColumn = cell->widthInFeatureSize * tech->featureSize * localWire->capWirePerUnit;
-	resWireLoadPerColumn = cell->widthInFeatureSize * tech->featureSize * localWire->resWirePerUnit;
-	widthInvNmos = MIN_NMOS_SIZE * tech->featureSize;
-	widthInvPmos = widthInvNmos * tech->pnSizeRatio;
-	widthPMOSBitlineEqual      = MIN_NMOS_SIZE * tech->featureSize;
-	widthPMOSBitlinePrecharger = 6 * tech->featureSize;
-	capLoadInv  = CalculateGateCap(widthPMOSBitlineEqual, *tech) + 2 * CalculateGateCap(widthPMOSBitlinePrecharger, *tech)
-			+ CalculateDrainCap(widthInvNmos, NMOS, tech->featureSize*40, *tech)
-			+ CalculateDrainCap(widthInvPmos, PMOS, tech->featureSize*40, *tech);
-	capOutputBitlinePrecharger = CalculateDrainCap(widthPMOSBitlinePrecharger, PMOS, tech->featureSize*40, *tech) + CalculateDrainCap(widthPMOSBitlineEqual, PMOS, tech->featureSize*40, *tech);
-	double capInputInv         = CalculateGateCap(widthInvNmos, *tech) + CalculateGateCap(widthInvPmos, *tech);
+	capWireLoadPerColumn = context->cell->widthInFeatureSize * context->tech->featureSize * context->localWire->capWirePerUnit;
+	resWireLoadPerColumn = context->cell->widthInFeatureSize * context->tech->featureSize * context->localWire->resWirePerUnit;
+	widthInvNmos = MIN_NMOS_SIZE * context->tech->featureSize;
+	widthInvPmos = widthInvNmos * context->tech->pnSizeRatio;
+	widthPMOSBitlineEqual      = MIN_NMOS_SIZE * context->tech->featureSize;
+	widthPMOSBitlinePrecharger = 6 * context->tech->featureSize;
+	capLoadInv  = CalculateGateCap(widthPMOSBitlineEqual, context->techView) + 2 * CalculateGateCap(widthPMOSBitlinePrecharger, context->techView)
+			+ CalculateDrainCap(widthInvNmos, NMOS, context->tech->featureSize*40, context->techView)
+			+ CalculateDrainCap(widthInvPmos, PMOS, context->tech->featureSize*40, context->techView);
+	capOutputBitlinePrecharger = CalculateDrainCap(widthPMOSBitlinePrecharger, PMOS, context->tech->featureSize*40, context->techView) + CalculateDrainCap(widthPMOSBitlineEqual, PMOS, context->tech->featureSize*40, context->techView);
+	double capInputInv         = CalculateGateCap(widthInvNmos, context->techView) + CalculateGateCap(widthInvPmos, context->techView);
 	capLoadPerColumn           = capInputInv + capWireLoadPerColumn;
 	double capLoadOutputDriver = numColumn * capLoadPerColumn;
-	outputDriver.Initialize(1, capInputInv, capLoadOutputDriver, 0 /* TO-DO */, true, latency_first, 0);  /* Always Latency First */
+	outputDriver.Initialize(context, 1, capInputInv, capLoadOutputDriver, 0 /* TO-DO */, true, latency_first, 0);  /* Always Latency First */
 
 	initialized = true;
 }
 
 void Precharger::CalculateArea() {
+	PROFILE_STAGE(precharger_profile, area_stage);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -83,9 +87,9 @@ void Precharger::CalculateArea() {
 		double hBitlinePrechareger, wBitlinePrechareger;
 		double hBitlineEqual, wBitlineEqual;
 		double hInverter, wInverter;
-		CalculateGateArea(INV, 1, 0, widthPMOSBitlinePrecharger, tech->featureSize*40, *tech, &hBitlinePrechareger, &wBitlinePrechareger);
-		CalculateGateArea(INV, 1, 0, widthPMOSBitlineEqual, tech->featureSize*40, *tech, &hBitlineEqual, &wBitlineEqual);
-		CalculateGateArea(INV, 1, widthInvNmos, widthInvPmos, tech->featureSize*40, *tech, &hInverter, &wInverter);
+		CalculateGateArea(INV, 1, 0, widthPMOSBitlinePrecharger, context->tech->featureSize*40, context->techView, &hBitlinePrechareger, &wBitlinePrechareger);
+		CalculateGateArea(INV, 1, 0, widthPMOSBitlineEqual, context->tech->featureSize*40, context->techView, &hBitlineEqual, &wBitlineEqual);
+		CalculateGateArea(INV, 1, widthInvNmos, widthInvPmos, context->tech->featureSize*40, context->techView, &hInverter, &wInverter);
 		width = 2 * wBitlinePrechareger + wBitlineEqual;
 		width = MAX(width, wInverter);
 		width *= numColumn;
@@ -98,6 +102,7 @@ void Precharger::CalculateArea() {
 }
 
 void Precharger::CalculateRC() {
+	PROFILE_STAGE(precharger_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -107,6 +112,7 @@ void Precharger::CalculateRC() {
 }
 
 void Precharger::CalculateLatency(double _rampInput){
+	PROFILE_STAGE(precharger_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
@@ -118,16 +124,15 @@ void Precharger::CalculateLatency(double _rampInput){
 		double gm;	/* transconductance */
 		double beta;	/* for horowitz calculation */
 		double temp;
-		resPullDown = CalculateOnResistance(widthInvNmos, NMOS, inputParameter->temperature, *tech);
+		resPullDown = CalculateOnResistance(widthInvNmos, NMOS, context->techView);
 		tr = resPullDown * capLoadInv;
-		gm = CalculateTransconductance(widthInvNmos, NMOS, *tech);
+		gm = CalculateTransconductance(widthInvNmos, NMOS, context->techView);
 		beta = 1 / (resPullDown * gm);
 		enableLatency += horowitz(tr, beta, outputDriver.rampOutput, &temp);
 		readLatency = 0;
-		double resPullUp = CalculateOnResistance(widthPMOSBitlinePrecharger, PMOS,
-				inputParameter->temperature, *tech);
+		double resPullUp = CalculateOnResistance(widthPMOSBitlinePrecharger, PMOS, context->techView);
 		double tau = resPullUp * (capBitline + capOutputBitlinePrecharger) + resBitline * capBitline / 2;
-		gm = CalculateTransconductance(widthPMOSBitlinePrecharger, PMOS, *tech);
+		gm = CalculateTransconductance(widthPMOSBitlinePrecharger, PMOS, context->techView);
 		beta = 1 / (resPullUp * gm);
 		readLatency += horowitz(tau, beta, temp, &rampOutput);
 		writeLatency = readLatency;
@@ -135,20 +140,20 @@ void Precharger::CalculateLatency(double _rampInput){
 }
 
 void Precharger::CalculatePower() {
+	PROFILE_STAGE(precharger_profile, power_stage);
 	if (!initialized) {
 		cout << "[Precharger] Error: Require initialization first!" << endl;
 	} else {
 		outputDriver.CalculatePower();
 		/* Leakage power */
 		leakage = outputDriver.leakage;
-		leakage += numColumn * tech->vdd * CalculateGateLeakage(INV, 1, widthInvNmos, widthInvPmos, inputParameter->temperature, *tech);
-		leakage += numColumn * voltagePrecharge * CalculateGateLeakage(INV, 1, 0, widthPMOSBitlinePrecharger,
-				inputParameter->temperature, *tech);
+		leakage += numColumn * context->tech->vdd * CalculateGateLeakage(INV, 1, widthInvNmos, widthInvPmos, context->techView);
+		leakage += numColumn * voltagePrecharge * CalculateGateLeakage(INV, 1, 0, widthPMOSBitlinePrecharger, context->techView);
 
 		/* Dynamic energy */
 		/* We don't count bitline precharge energy into account because it is a charging process */
 		readDynamicEnergy = outputDriver.readDynamicEnergy;
-		readDynamicEnergy += capLoadInv * tech->vdd * tech->vdd * numColumn;
+		readDynamicEnergy += capLoadInv * context->tech->vdd * context->tech->vdd * numColumn;
 		writeDynamicEnergy = 0;		/* No precharging is needed during the write operation */
 	}
 }
@@ -158,6 +163,11 @@ void Precharger::PrintProperty() {
 	FunctionUnit::PrintProperty();
 }
 
+void Precharger::SetContext(SimulationContext *_context) {
+	context = _context;
+	outputDriver.SetContext(_context);
+}
+
 Precharger & Precharger::operator=(const Precharger &rhs) {
 	height = rhs.height;
 	width = rhs.width;
@@ -174,8 +184,10 @@ Precharger & Precharger::operator=(const Precharger &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	outputDriver = rhs.outputDriver;
+	voltagePrecharge = rhs.voltagePrecharge;
 	capBitline = rhs.capBitline;
 	resBitline = rhs.resBitline;
 	capLoadInv = rhs.capLoadInv;
@@ -186,6 +198,8 @@ Precharger & Precharger::operator=(const Precharger &rhs) {
 	numColumn = rhs.numColumn;
 	widthPMOSBitlinePrecharger = rhs.widthPMOSBitlinePrecharger;
 	widthPMOSBitlineEqual = rhs.widthPMOSBitlineEqual;
+	widthInvNmos = rhs.widthInvNmos;
+	widthInvPmos = rhs.widthInvPmos;
 	capLoadPerColumn = rhs.capLoadPerColumn;
 	rampInput = rhs.rampInput;
 	rampOutput = rhs.rampOutput;
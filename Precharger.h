@@ -48,11 +48,12 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(double _voltagePrecharge, int _numColumn, double _capBitline, double _resBitline);
+	void Initialize(SimulationContext *_context, double _voltagePrecharge, int _numColumn, double _capBitline, double _resBitline);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
 	void CalculatePower();
+	void SetContext(SimulationContext *_context);
 	Precharger & operator=(const Precharger &);
 
 	/* Properties */
@@ -37,7 +37,8 @@
 
 #include "PredecodeBlock.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 PredecodeBlock::PredecodeBlock() {
 	// TODO Auto-generated constructor stub
@@ -55,24 +56,26 @@ PredecodeBlock::PredecodeBlock() {
 PredecodeBlock::~PredecodeBlock() {
 	// TODO Auto-generated destructor stub
 	if (rowDecoderStage1A)
-		delete rowDecoderStage1A;
+		rowDecoderStage1A->~RowDecoder();
 	if (rowDecoderStage1B)
-		delete rowDecoderStage1B;
+		rowDecoderStage1B->~RowDecoder();
 	if (rowDecoderStage1C)
-		delete rowDecoderStage1C;
+		rowDecoderStage1C->~RowDecoder();
 	if (rowDecoderStage2)
-		delete rowDecoderStage2;
+		rowDecoderStage2->~RowDecoder();
 	if (basicDecoderA1)
-		delete basicDecoderA1;
+		basicDecoderA1->~BasicDecoder();
 	if (basicDecoderA2)
-		delete basicDecoderA2;
+		basicDecoderA2->~BasicDecoder();
 	if (basicDecoderB)
-		delete basicDecoderB;
+		basicDecoderB->~BasicDecoder();
 	if (basicDecoderC)
-		delete basicDecoderC;
+		basicDecoderC->~BasicDecoder();
 }
 
-void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _resLoad) {
+void PredecodeBlock::Initialize(SimulationContext *_context, int _numAddressBit, double _capLoad, double _resLoad) {
+	context = _context;
+	PROFILE_STAGE(predecode_block_profile, initialize_stage);
 	if (initialized)
 		cout << "[Predecoder Block] Warning: Already initialized!" << endl;
 
@@ -114,14 +117,14 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 			rowDecoderStage2 = NULL;
 			rowDecoderStage1B = NULL;
 			rowDecoderStage1C = NULL;
-			rowDecoderStage1A = new RowDecoder;
-			rowDecoderStage1A->Initialize(numOutputAddressBit, capLoad, resLoad, numNandInputStage1A == 3, latency_first, 0);
+			rowDecoderStage1A = new (rowDecoderStorage[0]) RowDecoder;
+			rowDecoderStage1A->Initialize(context, numOutputAddressBit, capLoad, resLoad, numNandInputStage1A == 3, latency_first, 0);
 			rowDecoderStage1A->CalculateRC();
 		} else {
-			rowDecoderStage2 = new RowDecoder;
+			rowDecoderStage2 = new (rowDecoderStorage[3]) RowDecoder;
 			double capLoadStage1A, capLoadStage1B, capLoadStage1C;
 			if (numBasicDecoder <= 6) {
-				rowDecoderStage2->Initialize(numOutputAddressBit, capLoad, resLoad, false, latency_first, 0);
+				rowDecoderStage2->Initialize(context, numOutputAddressBit, capLoad, resLoad, false, latency_first, 0);
 				rowDecoderStage2->CalculateRC();
 				numNandInputStage1B = numBasicDecoder / 2;
 				numNandInputStage1A = numBasicDecoder - numNandInputStage1B;
@@ -132,14 +135,14 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				capLoadStage1A = numAddressBitStage1B * rowDecoderStage2->capNandInput;
 				capLoadStage1B = numAddressBitStage1A * rowDecoderStage2->capNandInput;
 				rowDecoderStage1C = NULL;
-				rowDecoderStage1A = new RowDecoder;
-			    rowDecoderStage1A->Initialize(numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
+				rowDecoderStage1A = new (rowDecoderStorage[0]) RowDecoder;
+			    rowDecoderStage1A->Initialize(context, numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
 			    rowDecoderStage1A->CalculateRC();
-			    rowDecoderStage1B = new RowDecoder;
-			    rowDecoderStage1B->Initialize(numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
+			    rowDecoderStage1B = new (rowDecoderStorage[1]) RowDecoder;
+			    rowDecoderStage1B->Initialize(context, numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
 			    rowDecoderStage1B->CalculateRC();
 			} else if (numBasicDecoder <= 9){
-				rowDecoderStage2->Initialize(numOutputAddressBit, capLoad, resLoad, true, latency_first, 0);
+				rowDecoderStage2->Initialize(context, numOutputAddressBit, capLoad, resLoad, true, latency_first, 0);
 				rowDecoderStage2->CalculateRC();
 				if (numBasicDecoder == 7) {
 					numNandInputStage1A = 3;
@@ -165,14 +168,14 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				capLoadStage1A = numAddressBitStage1B * numAddressBitStage1C * rowDecoderStage2->capNandInput;
 				capLoadStage1B = numAddressBitStage1A * numAddressBitStage1C * rowDecoderStage2->capNandInput;
 				capLoadStage1C = numAddressBitStage1A * numAddressBitStage1B * rowDecoderStage2->capNandInput;
-				rowDecoderStage1A = new RowDecoder;
-				rowDecoderStage1A->Initialize(numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
+				rowDecoderStage1A = new (rowDecoderStorage[0]) RowDecoder;
+				rowDecoderStage1A->Initialize(context, numAddressBitStage1A, capLoadStage1A, 0 /* TO-DO */, numNandInputStage1A == 3, latency_first, 0);
 				rowDecoderStage1A->CalculateRC();
-				rowDecoderStage1B = new RowDecoder;
-				rowDecoderStage1B->Initialize(numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
+				rowDecoderStage1B = new (rowDecoderStorage[1]) RowDecoder;
+				rowDecoderStage1B->Initialize(context, numAddressBitStage1B, capLoadStage1B, 0 /* TO-DO */, numNandInputStage1B == 3, latency_first, 0);
 				rowDecoderStage1B->CalculateRC();
-				rowDecoderStage1C = new RowDecoder;
-				rowDecoderStage1C->Initialize(numAddressBitStage1C, capLoadStage1C, 0 /* TO-DO */, numNandInputStage1C == 3, latency_first, 0);
+				rowDecoderStage1C = new (rowDecoderStorage[2]) RowDecoder;
+				rowDecoderStage1C->Initialize(context, numAddressBitStage1C, capLoadStage1C, 0 /* TO-DO */, numNandInputStage1C == 3, latency_first, 0);
 				rowDecoderStage1C->CalculateRC();
 			}
 		}
@@ -182,8 +185,8 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 			} else {
 				capLoadBasicDecoderC = 64 * rowDecoderStage1C->capNandInput;
 			}
-			basicDecoderC = new BasicDecoder;
-			basicDecoderC->Initialize(3, capLoadBasicDecoderC, 0 /* TO-DO */);
+			basicDecoderC = new (basicDecoderStorage[3]) BasicDecoder;
+			basicDecoderC->Initialize(context, 3, capLoadBasicDecoderC, 0 /* TO-DO */);
 		} else {
 			basicDecoderC = NULL;
 		}
@@ -193,8 +196,8 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 			} else {
 				capLoadBasicDecoderB = 64 * rowDecoderStage1B->capNandInput;
 			}
-			basicDecoderB = new BasicDecoder;
-			basicDecoderB->Initialize(3, capLoadBasicDecoderB, 0 /* TO-DO */);
+			basicDecoderB = new (basicDecoderStorage[2]) BasicDecoder;
+			basicDecoderB->Initialize(context, 3, capLoadBasicDecoderB, 0 /* TO-DO */);
 		} else {
 			basicDecoderB = NULL;
 		}
@@ -205,8 +208,8 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				numBasicDecoderA2 = 0;
 				numCapNandA1 = 1 << ( 3* (numNandInputStage1A - 1));
 				capLoadBasicDecoderA1 = numCapNandA1 * rowDecoderStage1A->capNandInput;
-				basicDecoderA1 = new BasicDecoder;
-				basicDecoderA1->Initialize(3, capLoadBasicDecoderA1, 0 /* TO-DO */);
+				basicDecoderA1 = new (basicDecoderStorage[0]) BasicDecoder;
+				basicDecoderA1->Initialize(context, 3, capLoadBasicDecoderA1, 0 /* TO-DO */);
 				basicDecoderA2 = NULL;
 			} else if (numDecoder24 == 1) {
 				numBasicDecoderA1 = 1;
@@ -215,43 +218,44 @@ void PredecodeBlock::Initialize(int _numAddressBit, double _capLoad, double _res
 				numCapNandA2 = 1 << (2 + 3 * (numBasicDecoderA2 - 1));
 				capLoadBasicDecoderA1 = numCapNandA1 * rowDecoderStage1A->capNandInput;
 				capLoadBasicDecoderA2 = numCapNandA2 * rowDecoderStage1A->capNandInput;
-				basicDecoderA1 = new BasicDecoder;
-			    basicDecoderA1->Initialize(2, capLoadBasicDecoderA1, 0 /* TO-DO */);
-			    basicDecoderA2 = new BasicDecoder;
-			    basicDecoderA2->Initialize(3, capLoadBasicDecoderA2, 0 /* TO-DO */);
+				basicDecoderA1 = new (basicDecoderStorage[0]) BasicDecoder;
+			    basicDecoderA1->Initialize(context, 2, capLoadBasicDecoderA1, 0 /* TO-DO */);
+			    basicDecoderA2 = new (basicDecoderStorage[1]) BasicDecoder;
+			    basicDecoderA2->Initialize(context, 3, capLoadBasicDecoderA2, 0 /* TO-DO */);
 			} else if (numDecoder24 == 2) {
 				if (numNandInputStage1A == 2) {
 		    		numBasicDecoderA1 = 2;
 		    		numBasicDecoderA2 = 0;
-		    		basicDecoderA1 = new BasicDecoder;
-		    		basicDecoderA1->Initialize(2, 4 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
+		    		basicDecoderA1 = new (basicDecoderStorage[0]) BasicDecoder;
+		    		basicDecoderA1->Initialize(context, 2, 4 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
 		    		basicDecoderA2 = NULL;
 				} else {
 		    		numBasicDecoderA1 = 2;
 		    		numBasicDecoderA2 = 1;
-		    		basicDecoderA1 = new BasicDecoder;
-		    		basicDecoderA1->Initialize(2, 32 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
-		    		basicDecoderA2 = new BasicDecoder;
-		    		basicDecoderA2->Initialize(3, 16 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
+		    		basicDecoderA1 = new (basicDecoderStorage[0]) BasicDecoder;
+		    		basicDecoderA1->Initialize(context, 2, 32 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
+		    		basicDecoderA2 = new (basicDecoderStorage[1]) BasicDecoder;
+		    		basicDecoderA2->Initialize(context, 3, 16 * rowDecoderStage1A->capNandInput, 0 /* TO-DO */);
 				}
 			}
 		}else {
 			numBasicDecoderA1 = 1;
 			numBasicDecoderA2 = 0;
-			basicDecoderA1 = new BasicDecoder;
+			basicDecoderA1 = new (basicDecoderStorage[0]) BasicDecoder;
 			basicDecoderA2 = NULL;
 			if (numDecoder12 == 1) {
-				basicDecoderA1->Initialize(1, capLoad, resLoad);
+				basicDecoderA1->Initialize(context, 1, capLoad, resLoad);
 			} else if (numDecoder24 == 1) {
-				basicDecoderA1->Initialize(2, capLoad, resLoad);
+				basicDecoderA1->Initialize(context, 2, capLoad, resLoad);
 			} else if (numDecoder38 == 1)
-				basicDecoderA1->Initialize(3, capLoad, resLoad);
+				basicDecoderA1->Initialize(context, 3, capLoad, resLoad);
 		}
 	}
 	initialized = true;
 }
 
 void PredecodeBlock::CalculateArea() {
+	PROFILE_STAGE(predecode_block_profile, area_stage);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
@@ -309,6 +313,7 @@ void PredecodeBlock::CalculateArea() {
 }
 
 void PredecodeBlock::CalculateRC() {
+	PROFILE_STAGE(predecode_block_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit > 0) {
@@ -328,6 +333,7 @@ void PredecodeBlock::CalculateRC() {
 }
 
 void PredecodeBlock::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(predecode_block_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
@@ -402,6 +408,7 @@ void PredecodeBlock::CalculateLatency(double _rampInput) {
 
 
 void PredecodeBlock::CalculatePower() {
+	PROFILE_STAGE(predecode_block_profile, power_stage);
 	if (!initialized) {
 		cout << "[Predecoder Block] Error: Require initialization first!" << endl;
 	} else if (numAddressBit == 0) {
@@ -473,6 +480,7 @@ PredecodeBlock & PredecodeBlock::operator=(const PredecodeBlock &rhs) {
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
 
+	context = rhs.context;
 	initialized = rhs.initialized;
 	numNandInputStage1A = rhs.numNandInputStage1A;
 	numNandInputStage1B = rhs.numNandInputStage1B;
@@ -49,7 +49,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numAddressBit, double _capLoad, double _resLoad);
+	void Initialize(SimulationContext *_context, int _numAddressBit, double _capLoad, double _resLoad);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
@@ -78,6 +78,11 @@ public:
 	int numBasicDecoderA1, numBasicDecoderA2;
 	double capLoadBasicDecoderA1, capLoadBasicDecoderA2, capLoadBasicDecoderB, capLoadBasicDecoderC;
 	double rampInput, rampOutput;
+
+private:
+	/* The stages (1A, 1B, 1C, 2) and the basic decoders (A1, A2, B, C) are constructed in place here, not on the heap */
+	alignas(RowDecoder) char rowDecoderStorage[4][sizeof(RowDecoder)];
+	alignas(BasicDecoder) char basicDecoderStorage[4][sizeof(BasicDecoder)];
 	/* TO-DO: Predecoder so far does not take OptPriority input because the output driver is already quite fixed in this module */
 };
 
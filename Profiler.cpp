@@ -0,0 +1,118 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Profiler.h"
+#include <atomic>
+#include <string.h>
+
+static const char * const eventName[(int)num_profile_event] = {
+	"design_point", "aggressive_partitioning", "mux_overflow", "invalid_mat", "invalid_subarray",
+	"invalid_row_decoder", "invalid_sense_amp", "invalid_output_driver", "invalid_bank",
+	"area_bound", "mat_bound", "constraint", "solution", "subarray_cache_hit", "subarray_cache_miss",
+	"wire_trial", "invalid_scope", "shape"
+};
+
+static const char * const unitName[(int)num_profile_unit] = {
+	"Bank", "Mat", "SubArray", "RowDecoder", "PredecodeBlock", "BasicDecoder", "Precharger",
+	"SenseAmp", "Mux", "OutputDriver", "Comparator", "Explorer", "WireRefiner"
+};
+
+static const char * const stageName[(int)num_profile_stage] = {
+	"Initialize", "CalculateArea", "CalculateRC", "CalculateLatency", "CalculatePower",
+	"CalculateLatencyAndPower", "Run"
+};
+
+static atomic<long long> nextProfilerId(0);
+
+Profiler::Profiler() {
+	// TODO Auto-generated constructor stub
+	numThread = 0;
+	id = nextProfilerId++;
+}
+
+Profiler::~Profiler() {
+	// TODO Auto-generated destructor stub
+	for (int i = 0; i < (int)record.size(); i++)
+		delete record[i];
+}
+
+void Profiler::AddTime(ProfileUnit _unit, ProfileStage _stage, long long _nanosecond) {
+	Record *local = Local();
+	local->numCall[_unit][_stage]++;
+	local->time[_unit][_stage] += _nanosecond;
+}
+
+Profiler::Record * Profiler::Local() {
+	static thread_local long long localId = -1;
+	static thread_local Record *localRecord = NULL;
+	if (localId != id) {
+		localRecord = new Record;
+		memset(localRecord, 0, sizeof(Record));
+		lock.lock();
+		record.push_back(localRecord);
+		numThread = (int)record.size();
+		lock.unlock();
+		localId = id;
+	}
+	return localRecord;
+}
+
+void Profiler::PrintToCsvFile(ostream &outputFile) {
+	Record total;
+	memset(&total, 0, sizeof(Record));
+	lock.lock();
+	for (int r = 0; r < (int)record.size(); r++) {
+		for (int i = 0; i < (int)num_profile_event; i++)
+			total.numEvent[i] += record[r]->numEvent[i];
+		for (int i = 0; i < (int)num_profile_unit; i++)
+			for (int j = 0; j < (int)num_profile_stage; j++) {
+				total.numCall[i][j] += record[r]->numCall[i][j];
+				total.time[i][j] += record[r]->time[i][j];
+			}
+	}
+	lock.unlock();
+
+	outputFile << "Type,Name,Stage,Count,Time (s)" << endl;
+	outputFile << "thread,,," << numThread << "," << endl;
+	for (int i = 0; i < (int)num_profile_event; i++)
+		outputFile << "event," << eventName[i] << ",," << total.numEvent[i] << "," << endl;
+	for (int i = 0; i < (int)num_profile_unit; i++)
+		for (int j = 0; j < (int)num_profile_stage; j++)
+			if (total.numCall[i][j] > 0)
+				outputFile << "timer," << unitName[i] << "," << stageName[j] << "," << total.numCall[i][j] << ","
+						<< total.time[i][j] / 1e9 << endl;
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include "typedef.h"
+
+using namespace std;
+
+/* Event counters and calculation timers of a simulation, enabled with "--profile".
+ * Every thread counts into its own record, so counting takes no lock; the records
+ * are summed when the summary is printed. The times of a unit include the units it
+ * builds, e.g. the mat time includes its subarray. */
+class Profiler {
+public:
+	Profiler();
+	virtual ~Profiler();
+
+	/* Functions */
+	void Count(ProfileEvent _event) { Local()->numEvent[_event]++; }
+	void AddTime(ProfileUnit _unit, ProfileStage _stage, long long _nanosecond);
+	void PrintToCsvFile(ostream &outputFile);	/* One line per event and per timed stage */
+
+	/* Properties */
+	int numThread;		/* Number of threads that have counted so far */
+
+private:
+	struct Record {
+		long long numEvent[(int)num_profile_event];
+		long long numCall[(int)num_profile_unit][(int)num_profile_stage];
+		long long time[(int)num_profile_unit][(int)num_profile_stage];	/* Unit: ns */
+	};
+
+	Record * Local();	/* The record of the calling thread */
+
+	mutex lock;
+	vector<Record *> record;
+	long long id;		/* Tells the thread-local record of this profiler from the one of a deleted profiler */
+};
+
+/* Times the enclosing scope, nothing is measured when the profiler is NULL */
+class ProfileTimer {
+public:
+	ProfileTimer(Profiler *_profiler, ProfileUnit _unit, ProfileStage _stage) {
+		profiler = _profiler;
+		unit = _unit;
+		stage = _stage;
+		if (profiler)
+			start = chrono::steady_clock::now();
+	}
+	~ProfileTimer() {
+		if (profiler)
+			profiler->AddTime(unit, stage, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+	}
+
+private:
+	Profiler *profiler;
+	ProfileUnit unit;
+	ProfileStage stage;
+	chrono::steady_clock::time_point start;
+};
+
+#endif /* PROFILER_H_ */
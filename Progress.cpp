@@ -0,0 +1,192 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Progress.h"
+#include "constant.h"
+#include "macros.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+static const char * const targetName[(int)full_exploration] = {
+	"ReadLatency", "WriteLatency", "ReadDynamicEnergy", "WriteDynamicEnergy", "ReadEDP", "WriteEDP",
+	"Leakage", "Area"
+};
+
+static void PrintValue(ostream &_file, OptimizationTarget _target, double _value) {
+	switch (_target) {
+	case read_latency_optimized:
+	case write_latency_optimized:
+		_file << TO_SECOND(_value);
+		break;
+	case read_energy_optimized:
+	case write_energy_optimized:
+		_file << TO_JOULE(_value);
+		break;
+	case leakage_optimized:
+		_file << TO_WATT(_value);
+		break;
+	case area_optimized:
+		_file << TO_SQM(_value);
+		break;
+	default:	/* EDP */
+		_file << scientific << _value << "J*s" << fixed;
+		break;
+	}
+}
+
+Progress::Progress() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	timeBudget = 0;
+	numPoint = 0;
+	numVisited = 0;
+	numValid = 0;
+	for (int i = 0; i < (int)full_exploration; i++)
+		best[i] = 1e41;	/* means none */
+	expired = false;
+	stopped = true;
+}
+
+Progress::~Progress() {
+	// TODO Auto-generated destructor stub
+	Stop();
+}
+
+void Progress::Initialize(double _timeBudget, const string &_statusFileName) {
+	timeBudget = _timeBudget;
+	statusFileName = _statusFileName;
+	initialized = true;
+}
+
+void Progress::Start(long long _numPoint) {
+	if (!initialized) {
+		cout << "[Progress] Error: Require initialization first!" << endl;
+		return;
+	}
+	numPoint = _numPoint;
+	numVisited = 0;
+	numValid = 0;
+	for (int i = 0; i < (int)full_exploration; i++)
+		best[i] = 1e41;	/* means none */
+	expired = false;
+	stopped = false;
+	start = chrono::steady_clock::now();
+	reporter = thread(&Progress::Report, this);
+}
+
+void Progress::Stop() {
+	if (!reporter.joinable())
+		return;
+	lock.lock();
+	stopped = true;
+	lock.unlock();
+	wakeUp.notify_all();
+	reporter.join();
+	WriteStatus(true);
+}
+
+void Progress::Add(long long _numVisited, long long _numValid) {
+	numVisited.fetch_add(_numVisited, memory_order_relaxed);
+	numValid.fetch_add(_numValid, memory_order_relaxed);
+}
+
+void Progress::Offer(OptimizationTarget _target, double _value) {
+	double value = best[_target].load(memory_order_relaxed);
+	while (_value < value && !best[_target].compare_exchange_weak(value, _value, memory_order_relaxed))
+		;
+}
+
+void Progress::Report() {
+	chrono::steady_clock::time_point deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+			chrono::duration<double>(timeBudget));
+	chrono::steady_clock::time_point next = start;
+	unique_lock<mutex> guard(lock);
+	while (!stopped) {
+		next += chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(PROGRESS_INTERVAL));
+		if (timeBudget > 0 && deadline < next)
+			next = deadline;
+		wakeUp.wait_until(guard, next, [this] { return stopped; });
+		if (stopped)
+			break;
+		if (timeBudget > 0 && chrono::steady_clock::now() >= deadline) {
+			expired = true;
+			break;		/* The explorers wind down, Stop() writes the last line */
+		}
+		guard.unlock();
+		WriteStatus(false);
+		guard.lock();
+	}
+}
+
+void Progress::WriteStatus(bool _final) {
+	double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	long long visited = numVisited.load(memory_order_relaxed);
+	long long valid = numValid.load(memory_order_relaxed);
+	double throughput = elapsed > 0 ? visited / elapsed : 0;
+
+	stringstream status;
+	status << fixed << setprecision(3);
+	if (_final)
+		status << (Expired() ? "Time budget expired" : "Finished");
+	else
+		status << "Exploring";
+	status << " after " << elapsed << "s: " << visited << " of " << numPoint << " points ("
+			<< (numPoint > 0 ? 100.0 * visited / numPoint : 100.0) << "%), "
+			<< (visited > 0 ? 100.0 * valid / visited : 0.0) << "% valid, " << throughput << " points/s";
+	if (!_final && throughput > 0) {
+		double eta = (numPoint - visited) / throughput;
+		if (timeBudget > 0 && timeBudget - elapsed < eta)
+			eta = timeBudget - elapsed;		/* The budget runs out first */
+		status << ", ETA " << eta << "s";
+	}
+	for (int i = 0; i < (int)full_exploration; i++) {
+		double value = best[i].load(memory_order_relaxed);
+		if (value < 1e41) {
+			status << ", " << targetName[i] << " ";
+			PrintValue(status, (OptimizationTarget)i, value);
+		}
+	}
+	status << endl;
+
+	if (statusFileName.empty()) {
+		cerr << status.str();
+	} else {
+		ofstream statusFile(statusFileName.c_str(), ofstream::trunc);
+		statusFile << status.str();
+	}
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef PROGRESS_H_
+#define PROGRESS_H_
+
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include "typedef.h"
+
+using namespace std;
+
+/* The progress of an exploration, enabled with "--time-budget" or "--status". The explorers add the
+ * points of each finished work item and offer the best value of each target they improve, without a
+ * lock. A reporter thread writes a status line every PROGRESS_INTERVAL seconds: the points visited
+ * out of the exact size of the search space, the valid fraction, the throughput, the best value of
+ * each target so far and the ETA. It also raises the expired flag when the time budget is over, and
+ * the explorers stop at the next design point. */
+class Progress {
+public:
+	Progress();
+	virtual ~Progress();
+
+	/* Functions */
+	void Initialize(double _timeBudget, const string &_statusFileName);
+	void Start(long long _numPoint);	/* The clock and the reporter start, _numPoint points are to be visited */
+	void Stop();		/* The last status line is written */
+	void Add(long long _numVisited, long long _numValid);
+	void Offer(OptimizationTarget _target, double _value);	/* A design with this value of _target was found */
+	bool Expired() const { return expired.load(memory_order_relaxed); }
+	long long NumVisited() const { return numVisited.load(memory_order_relaxed); }
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	double timeBudget;	/* Unit: s, 0 means the exploration is not bounded */
+	string statusFileName;	/* Every status line replaces the file, empty means the lines go to stderr */
+	long long numPoint;	/* The design points of the explorations */
+
+private:
+	void Report();		/* The reporter thread */
+	void WriteStatus(bool _final);
+
+	atomic<long long> numVisited;
+	atomic<long long> numValid;
+	atomic<double> best[(int)full_exploration];
+	atomic<bool> expired;
+	chrono::steady_clock::time_point start;
+	thread reporter;
+	mutex lock;
+	condition_variable wakeUp;
+	bool stopped;
+};
+
+#endif /* PROGRESS_H_ */
@@ -36,7 +36,7 @@
 
 
 #include "Result.h"
-#include "global.h"
+#include "SimulationContext.h"
 #include "formula.h"
 #include "macros.h"
 
@@ -45,24 +45,20 @@
 
 using namespace std;
 
-Result::Result() {
-	// TODO Auto-generated constructor stub
-	if (inputParameter->routingMode == h_tree)
-		bank = new BankWithHtree();
+static Bank * NewBank(SimulationContext *_context) {
+	if (_context->inputParameter->routingMode == h_tree)
+		return new BankWithHtree();
 	else
-		bank = new BankWithoutHtree();
-	localWire = new Wire();
-	globalWire = new Wire();
+		return new BankWithoutHtree();
+}
 
-	/* initialize the worst case */
-	bank->readLatency = 1e41;
-	bank->writeLatency = 1e41;
-	bank->readDynamicEnergy = 1e41;
-	bank->writeDynamicEnergy = 1e41;
-	bank->leakage = 1e41;
-	bank->height = 1e41;
-	bank->width = 1e41;
-	bank->area = 1e41;
+Result::Result() {
+	// TODO Auto-generated constructor stub
+	context = NULL;
+	record = BankRecord();
+	bank = NULL;
+	localWire = NULL;
+	globalWire = NULL;
 
 	/* No constraints */
 	limitReadLatency = 1e41;
@@ -73,85 +69,228 @@ Result::Result() {
 	limitWriteEdp = 1e41;
 	limitArea = 1e41;
 	limitLeakage = 1e41;
+	limitHeight = 1e41;
+	limitWidth = 1e41;
+	limitAspectRatio = 1e41;
 
 	/* Default read latency optimization */
 	optimizationTarget = read_latency_optimized;
+
+	sequence = -1;
+}
+
+void Result::Initialize(SimulationContext *_context) {
+	context = _context;
+	localWire = context->localWire;
+	globalWire = context->globalWire;
+
+	/* initialize the worst case */
+	reset();
 }
 
 Result::~Result() {
 	// TODO Auto-generated destructor stub
 	if (bank)
 		delete bank;
-	if (Result::localWire)
-		delete Result::localWire;
-	if (Result::globalWire)
-		delete Result::globalWire;
 }
 
 void Result::reset() {
-	bank->readLatency = 1e41;
-	bank->writeLatency = 1e41;
-	bank->readDynamicEnergy = 1e41;
-	bank->writeDynamicEnergy = 1e41;
-	bank->leakage = 1e41;
-	bank->height = 1e41;
-	bank->width = 1e41;
-	bank->area = 1e41;
+	record.design.numRowMat = 0;
+	record.readLatency = 1e41;
+	record.writeLatency = 1e41;
+	record.readDynamicEnergy = 1e41;
+	record.writeDynamicEnergy = 1e41;
+	record.leakage = 1e41;
+	record.height = 1e41;
+	record.width = 1e41;
+	record.area = 1e41;
+	sequence = -1;
+	if (bank) {
+		delete bank;
+		bank = NULL;
+	}
+}
+
+void Result::store(Bank *newBank) {
+	record.design.numRowMat = newBank->numRowMat;
+	record.design.numColumnMat = newBank->numColumnMat;
+	record.design.numActiveMatPerRow = newBank->numActiveMatPerRow;
+	record.design.numActiveMatPerColumn = newBank->numActiveMatPerColumn;
+	record.design.numRowSubarray = newBank->numRowSubarray;
+	record.design.numColumnSubarray = newBank->numColumnSubarray;
+	record.design.numActiveSubarrayPerRow = newBank->numActiveSubarrayPerRow;
+	record.design.numActiveSubarrayPerColumn = newBank->numActiveSubarrayPerColumn;
+	record.design.muxSenseAmp = newBank->muxSenseAmp;
+	record.design.muxOutputLev1 = newBank->muxOutputLev1;
+	record.design.muxOutputLev2 = newBank->muxOutputLev2;
+	record.design.numRowPerSet = newBank->numRowPerSet;
+	record.design.areaOptimizationLevel = (int)newBank->areaOptimizationLevel;
+	record.memoryType = newBank->memoryType;
+	record.capacity = newBank->capacity;
+	record.blockSize = newBank->blockSize;
+	record.associativity = newBank->associativity;
+	record.numRowSubarrayCell = newBank->mat.subarray.numRow;
+	record.numColumnSubarrayCell = newBank->mat.subarray.numColumn;
+	record.height = newBank->height;
+	record.width = newBank->width;
+	record.area = newBank->area;
+	record.readLatency = newBank->readLatency;
+	record.writeLatency = newBank->writeLatency;
+	record.setLatency = newBank->setLatency;
+	record.resetLatency = newBank->resetLatency;
+	record.readDynamicEnergy = newBank->readDynamicEnergy;
+	record.writeDynamicEnergy = newBank->writeDynamicEnergy;
+	record.setDynamicEnergy = newBank->setDynamicEnergy;
+	record.resetDynamicEnergy = newBank->resetDynamicEnergy;
+	record.leakage = newBank->leakage;
+	if (bank) {
+		delete bank;
+		bank = NULL;
+	}
+}
+
+void Result::adopt(Bank *newBank) {
+	store(newBank);
+	bank = newBank;
+}
+
+void Result::materialize() {
+	if (bank)
+		return;
+	if (record.design.numRowMat == 0) {
+		/* No design, only the worst case metrics */
+		bank = NewBank(context);
+		bank->readLatency = record.readLatency;
+		bank->writeLatency = record.writeLatency;
+		bank->readDynamicEnergy = record.readDynamicEnergy;
+		bank->writeDynamicEnergy = record.writeDynamicEnergy;
+		bank->leakage = record.leakage;
+		bank->height = record.height;
+		bank->width = record.width;
+		bank->area = record.area;
+		return;
+	}
+
+	/* The same calculation as the exploration, with the wires of this result */
+	const Wire *contextLocalWire = context->localWire;
+	const Wire *contextGlobalWire = context->globalWire;
+	context->localWire = localWire;
+	context->globalWire = globalWire;
+	int numRowMat = record.design.numRowMat;
+	int numColumnMat = record.design.numColumnMat;
+	int numActiveMatPerRow = record.design.numActiveMatPerRow;
+	int numActiveMatPerColumn = record.design.numActiveMatPerColumn;
+	int numRowSubarray = record.design.numRowSubarray;
+	int numColumnSubarray = record.design.numColumnSubarray;
+	int numActiveSubarrayPerRow = record.design.numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn = record.design.numActiveSubarrayPerColumn;
+	int muxSenseAmp = record.design.muxSenseAmp;
+	int muxOutputLev1 = record.design.muxOutputLev1;
+	int muxOutputLev2 = record.design.muxOutputLev2;
+	int numRowPerSet = record.design.numRowPerSet;
+	int areaOptimizationLevel = record.design.areaOptimizationLevel;
+	long long capacity = record.capacity;
+	long blockSize = record.blockSize;
+	int associativity = record.associativity;
+	if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM)
+		context->cell->CalculateWriteEnergy(context->tech->vdd);
+	Bank *newBank;
+	CALCULATE(newBank, record.memoryType);
+	adopt(newBank);		/* Also completes a record that only has the metrics of its target */
+	context->localWire = contextLocalWire;
+	context->globalWire = contextGlobalWire;
+}
+
+void Result::getObjective(double *objective) {
+	objective[read_latency_objective] = record.readLatency;
+	objective[write_latency_objective] = record.writeLatency;
+	objective[read_energy_objective] = record.readDynamicEnergy;
+	objective[write_energy_objective] = record.writeDynamicEnergy;
+	objective[leakage_objective] = record.leakage;
+	objective[area_objective] = record.area;
+}
+
+bool Result::checkLimit(Bank *newBank) {
+	double objective[(int)num_objective];
+	newBank->GetObjective(objective);
+	return checkLimit(objective);
+}
+
+bool Result::checkLimit(const double *objective) {
+	return objective[read_latency_objective] <= limitReadLatency && objective[write_latency_objective] <= limitWriteLatency
+			&& objective[read_energy_objective] <= limitReadDynamicEnergy && objective[write_energy_objective] <= limitWriteDynamicEnergy
+			&& objective[read_latency_objective] * objective[read_energy_objective] <= limitReadEdp
+			&& objective[write_latency_objective] * objective[write_energy_objective] <= limitWriteEdp
+			&& objective[area_objective] <= limitArea && objective[leakage_objective] <= limitLeakage;
+}
+
+bool Result::checkShape(double height, double width) {
+	return height <= limitHeight && width <= limitWidth && MAX(height, width) <= limitAspectRatio * MIN(height, width);
 }
 
 void Result::compareAndUpdate(Result &newResult) {
-	if (newResult.bank->readLatency <= limitReadLatency && newResult.bank->writeLatency <= limitWriteLatency
-			&& newResult.bank->readDynamicEnergy <= limitReadDynamicEnergy && newResult.bank->writeDynamicEnergy <= limitWriteDynamicEnergy
-			&& newResult.bank->readLatency * newResult.bank->readDynamicEnergy <= limitReadEdp
-			&& newResult.bank->writeLatency * newResult.bank->writeDynamicEnergy <= limitWriteEdp
-			&& newResult.bank->area <= limitArea && newResult.bank->leakage <= limitLeakage) {
-		bool toUpdate = false;
+	double objective[(int)num_objective];
+	newResult.getObjective(objective);
+	if (checkLimit(objective) && checkShape(newResult.record.height, newResult.record.width)) {
+		double newValue, oldValue;
 		switch (optimizationTarget) {
 		case read_latency_optimized:
-			if 	(newResult.bank->readLatency < bank->readLatency)
-				toUpdate = true;
+			newValue = newResult.record.readLatency;
+			oldValue = record.readLatency;
 			break;
 		case write_latency_optimized:
-			if 	(newResult.bank->writeLatency < bank->writeLatency)
-				toUpdate = true;
+			newValue = newResult.record.writeLatency;
+			oldValue = record.writeLatency;
 			break;
 		case read_energy_optimized:
-			if 	(newResult.bank->readDynamicEnergy < bank->readDynamicEnergy)
-				toUpdate = true;
+			newValue = newResult.record.readDynamicEnergy;
+			oldValue = record.readDynamicEnergy;
 			break;
 		case write_energy_optimized:
-			if 	(newResult.bank->writeDynamicEnergy < bank->writeDynamicEnergy)
-				toUpdate = true;
+			newValue = newResult.record.writeDynamicEnergy;
+			oldValue = record.writeDynamicEnergy;
 			break;
 		case read_edp_optimized:
-			if 	(newResult.bank->readLatency * newResult.bank->readDynamicEnergy < bank->readLatency * bank->readDynamicEnergy)
-				toUpdate = true;
+			newValue = newResult.record.readLatency * newResult.record.readDynamicEnergy;
+			oldValue = record.readLatency * record.readDynamicEnergy;
 			break;
 		case write_edp_optimized:
-			if 	(newResult.bank->writeLatency * newResult.bank->writeDynamicEnergy < bank->writeLatency * bank->writeDynamicEnergy)
-				toUpdate = true;
+			newValue = newResult.record.writeLatency * newResult.record.writeDynamicEnergy;
+			oldValue = record.writeLatency * record.writeDynamicEnergy;
 			break;
 		case area_optimized:
-			if 	(newResult.bank->area < bank->area)
-				toUpdate = true;
+			newValue = newResult.record.area;
+			oldValue = record.area;
 			break;
 		case leakage_optimized:
-			if 	(newResult.bank->leakage < bank->leakage)
-				toUpdate = true;
+			newValue = newResult.record.leakage;
+			oldValue = record.leakage;
 			break;
 		default:	/* Exploration */
 			/* should not happen */
-			;
+			return;
 		}
-		if (toUpdate) {
-			*bank = *(newResult.bank);
-			*localWire = *(newResult.localWire);
-			*globalWire = *(newResult.globalWire);
+		/* On a tie, keep the design that the serial BIGFOR would have met first */
+		if (newValue < oldValue
+				|| (newValue == oldValue && newResult.sequence >= 0 && newResult.sequence < sequence)) {
+			record = newResult.record;
+			if (newResult.bank) {
+				if (!bank)
+					bank = NewBank(context);
+				*bank = *(newResult.bank);
+			} else if (bank) {
+				delete bank;
+				bank = NULL;
+			}
+			localWire = newResult.localWire;
+			globalWire = newResult.globalWire;
+			sequence = newResult.sequence;
 		}
 	}
 }
 
 void Result::print() {
+	materialize();
 	cout << endl << "=============" << endl << "CONFIGURATION" << endl << "=============" << endl;
 	cout << "Bank Organization: " << bank->numRowMat << " x " << bank->numColumnMat << endl;
 	cout << " - Row Activation   : " << bank->numActiveMatPerColumn << " / " << bank->numRowMat << endl;
@@ -164,7 +303,7 @@ void Result::print() {
 	cout << " - Senseamp Mux      : " << bank->muxSenseAmp << endl;
 	cout << " - Output Level-1 Mux: " << bank->muxOutputLev1 << endl;
 	cout << " - Output Level-2 Mux: " << bank->muxOutputLev2 << endl;
-	if (inputParameter->designTarget == cache)
+	if (context->inputParameter->designTarget == cache)
 		cout << " - One set is partitioned into " << bank->numRowPerSet << " rows" << endl;
 	cout << "Local Wire:" << endl;
 	cout << " - Wire Type : ";
@@ -301,20 +440,20 @@ void Result::print() {
 	cout << " - Total Area = " << TO_METER(bank->height) << " x " << TO_METER(bank->width)
 			<< " = " << TO_SQM(bank->area) << endl;
 	cout << " |--- Mat Area      = " << TO_METER(bank->mat.height) << " x " << TO_METER(bank->mat.width)
-			<< " = " << TO_SQM(bank->mat.area) << "   (" << cell->area * tech->featureSize * tech->featureSize
+			<< " = " << TO_SQM(bank->mat.area) << "   (" << context->cell->area * context->tech->featureSize * context->tech->featureSize
 			* bank->capacity / bank->numRowMat / bank->numColumnMat / bank->mat.area * 100 << "%)" << endl;
 	cout << " |--- Subarray Area = " << TO_METER(bank->mat.subarray.height) << " x "
 			<< TO_METER(bank->mat.subarray.width) << " = " << TO_SQM(bank->mat.subarray.area) << "   ("
-			<< cell->area * tech->featureSize * tech->featureSize * bank->capacity / bank->numRowMat
+			<< context->cell->area * context->tech->featureSize * context->tech->featureSize * bank->capacity / bank->numRowMat
 			/ bank->numColumnMat / bank->numRowSubarray / bank->numColumnSubarray
 			/ bank->mat.subarray.area * 100 << "%)" <<endl;
-	cout << " - Area Efficiency = " << cell->area * tech->featureSize * tech->featureSize
+	cout << " - Area Efficiency = " << context->cell->area * context->tech->featureSize * context->tech->featureSize
 			* bank->capacity / bank->area * 100 << "%" << endl;
 
 	cout << "Timing:" << endl;
 
 	cout << " -  Read Latency = " << TO_SECOND(bank->readLatency) << endl;
-	if (inputParameter->routingMode == h_tree)
+	if (context->inputParameter->routingMode == h_tree)
 		cout << " |--- H-Tree Latency = " << TO_SECOND(bank->readLatency - bank->mat.readLatency) << endl;
 	else
 		cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->readLatency - bank->mat.readLatency) << endl;
@@ -323,7 +462,7 @@ void Result::print() {
 	cout << "    |--- Subarray Latency   = " << TO_SECOND(bank->mat.subarray.readLatency) << endl;
 	cout << "       |--- Row Decoder Latency = " << TO_SECOND(bank->mat.subarray.rowDecoder.readLatency) << endl;
 	cout << "       |--- Bitline Latency     = " << TO_SECOND(bank->mat.subarray.bitlineDelay) << endl;
-	if (inputParameter->internalSensing)
+	if (context->inputParameter->internalSensing)
 		cout << "       |--- Senseamp Latency    = " << TO_SECOND(bank->mat.subarray.senseAmp.readLatency) << endl;
 	cout << "       |--- Mux Latency         = " << TO_SECOND(bank->mat.subarray.bitlineMux.readLatency
 													+ bank->mat.subarray.senseAmpMuxLev1.readLatency
@@ -332,54 +471,54 @@ void Result::print() {
 	if (bank->mat.memoryType == tag && bank->mat.internalSenseAmp)
 		cout << "    |--- Comparator Latency  = " << TO_SECOND(bank->mat.comparator.readLatency) << endl;
 
-	if (cell->memCellType == PCRAM || cell->memCellType == FBRAM ||
-			(cell->memCellType == memristor && (cell->accessType == CMOS_access || cell->accessType == BJT_access))) {
+	if (context->cell->memCellType == PCRAM || context->cell->memCellType == FBRAM ||
+			(context->cell->memCellType == memristor && (context->cell->accessType == CMOS_access || context->cell->accessType == BJT_access))) {
 		cout << " - RESET Latency = " << TO_SECOND(bank->resetLatency) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Latency = " << TO_SECOND(bank->resetLatency - bank->mat.resetLatency) << endl;
 		else
 			cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->resetLatency - bank->mat.resetLatency) << endl;
 		cout << " |--- Mat Latency    = " << TO_SECOND(bank->mat.resetLatency) << endl;
 		cout << "    |--- Predecoder Latency = " << TO_SECOND(bank->mat.predecoderLatency) << endl;
 		cout << "    |--- Subarray Latency   = " << TO_SECOND(bank->mat.subarray.resetLatency) << endl;
-		cout << "       |--- RESET Pulse Duration = " << TO_SECOND(cell->resetPulse) << endl;
+		cout << "       |--- RESET Pulse Duration = " << TO_SECOND(context->cell->resetPulse) << endl;
 		cout << "       |--- Row Decoder Latency  = " << TO_SECOND(bank->mat.subarray.rowDecoder.writeLatency) << endl;
 		cout << "       |--- Charge Latency   = " << TO_SECOND(bank->mat.subarray.chargeLatency) << endl;
 		cout << " - SET Latency   = " << TO_SECOND(bank->setLatency) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Latency = " << TO_SECOND(bank->setLatency - bank->mat.setLatency) << endl;
 		else
 			cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->setLatency - bank->mat.setLatency) << endl;
 		cout << " |--- Mat Latency    = " << TO_SECOND(bank->mat.setLatency) << endl;
 		cout << "    |--- Predecoder Latency = " << TO_SECOND(bank->mat.predecoderLatency) << endl;
 		cout << "    |--- Subarray Latency   = " << TO_SECOND(bank->mat.subarray.setLatency) << endl;
-		cout << "       |--- SET Pulse Duration   = " << TO_SECOND(cell->setPulse) << endl;
+		cout << "       |--- SET Pulse Duration   = " << TO_SECOND(context->cell->setPulse) << endl;
 		cout << "       |--- Row Decoder Latency  = " << TO_SECOND(bank->mat.subarray.rowDecoder.writeLatency) << endl;
 		cout << "       |--- Charger Latency      = " << TO_SECOND(bank->mat.subarray.chargeLatency) << endl;
-	} else if (cell->memCellType == SLCNAND) {
+	} else if (context->cell->memCellType == SLCNAND) {
 		cout << " - Erase Latency = " << TO_SECOND(bank->resetLatency) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Latency = " << TO_SECOND(bank->resetLatency - bank->mat.resetLatency) << endl;
 		else
 			cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->resetLatency - bank->mat.resetLatency) << endl;
 		cout << " |--- Mat Latency    = " << TO_SECOND(bank->mat.resetLatency) << endl;
 		cout << " - Programming Latency   = " << TO_SECOND(bank->setLatency) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Latency = " << TO_SECOND(bank->setLatency - bank->mat.setLatency) << endl;
 		else
 			cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->setLatency - bank->mat.setLatency) << endl;
 		cout << " |--- Mat Latency    = " << TO_SECOND(bank->mat.setLatency) << endl;
 	} else {
 		cout << " - Write Latency = " << TO_SECOND(bank->writeLatency) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Latency = " << TO_SECOND(bank->writeLatency - bank->mat.writeLatency) << endl;
 		else
 			cout << " |--- Non-H-Tree Latency = " << TO_SECOND(bank->writeLatency - bank->mat.writeLatency) << endl;
 		cout << " |--- Mat Latency    = " << TO_SECOND(bank->mat.writeLatency) << endl;
 		cout << "    |--- Predecoder Latency = " << TO_SECOND(bank->mat.predecoderLatency) << endl;
 		cout << "    |--- Subarray Latency   = " << TO_SECOND(bank->mat.subarray.writeLatency) << endl;
-		if (cell->memCellType == MRAM)
-			cout << "       |--- Write Pulse Duration = " << TO_SECOND(cell->resetPulse) << endl;	// MRAM reset/set is equal
+		if (context->cell->memCellType == MRAM)
+			cout << "       |--- Write Pulse Duration = " << TO_SECOND(context->cell->resetPulse) << endl;	// MRAM reset/set is equal
 		cout << "       |--- Row Decoder Latency = " << TO_SECOND(bank->mat.subarray.rowDecoder.writeLatency) << endl;
 		cout << "       |--- Charge Latency      = " << TO_SECOND(bank->mat.subarray.chargeLatency) << endl;
 	}
@@ -395,7 +534,7 @@ void Result::print() {
 	cout << "Power:" << endl;
 
 	cout << " -  Read Dynamic Energy = " << TO_JOULE(bank->readDynamicEnergy) << endl;
-	if (inputParameter->routingMode == h_tree)
+	if (context->inputParameter->routingMode == h_tree)
 		cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->readDynamicEnergy - bank->mat.readDynamicEnergy
 													* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 													<< endl;
@@ -412,20 +551,20 @@ void Result::print() {
 	cout << "       |--- Mux Decoder Dynamic Energy = " << TO_JOULE(bank->mat.subarray.bitlineMuxDecoder.readDynamicEnergy
 													+ bank->mat.subarray.senseAmpMuxLev1Decoder.readDynamicEnergy
 													+ bank->mat.subarray.senseAmpMuxLev2Decoder.readDynamicEnergy) << endl;
-	if (cell->memCellType == PCRAM || cell->memCellType == FBRAM || cell->memCellType == MRAM || cell->memCellType == memristor ) {
+	if (context->cell->memCellType == PCRAM || context->cell->memCellType == FBRAM || context->cell->memCellType == MRAM || context->cell->memCellType == memristor ) {
 		cout << "       |--- Bitline & Cell Read Energy = " << TO_JOULE(bank->mat.subarray.cellReadEnergy) << endl;
 	}
-	if (inputParameter->internalSensing)
+	if (context->inputParameter->internalSensing)
 		cout << "       |--- Senseamp Dynamic Energy    = " << TO_JOULE(bank->mat.subarray.senseAmp.readDynamicEnergy) << endl;
 	cout << "       |--- Mux Dynamic Energy         = " << TO_JOULE(bank->mat.subarray.bitlineMux.readDynamicEnergy
 													+ bank->mat.subarray.senseAmpMuxLev1.readDynamicEnergy
 													+ bank->mat.subarray.senseAmpMuxLev2.readDynamicEnergy) << endl;
 	cout << "       |--- Precharge Dynamic Energy   = " << TO_JOULE(bank->mat.subarray.precharger.readDynamicEnergy) << endl;
 
-	if (cell->memCellType == PCRAM || cell->memCellType == FBRAM ||
-			(cell->memCellType == memristor && (cell->accessType == CMOS_access || cell->accessType == BJT_access))) {
+	if (context->cell->memCellType == PCRAM || context->cell->memCellType == FBRAM ||
+			(context->cell->memCellType == memristor && (context->cell->accessType == CMOS_access || context->cell->accessType == BJT_access))) {
 		cout << " - RESET Dynamic Energy = " << TO_JOULE(bank->resetDynamicEnergy) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->resetDynamicEnergy - bank->mat.resetDynamicEnergy
 														* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 														<< endl;
@@ -447,7 +586,7 @@ void Result::print() {
 														+ bank->mat.subarray.senseAmpMuxLev2.writeDynamicEnergy) << endl;
 		cout << "       |--- Cell RESET Dynamic Energy  = " << TO_JOULE(bank->mat.subarray.cellResetEnergy) << endl;
 		cout << " - SET Dynamic Energy = " << TO_JOULE(bank->setDynamicEnergy) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->setDynamicEnergy - bank->mat.setDynamicEnergy
 														* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 														<< endl;
@@ -468,9 +607,9 @@ void Result::print() {
 														+ bank->mat.subarray.senseAmpMuxLev1.writeDynamicEnergy
 														+ bank->mat.subarray.senseAmpMuxLev2.writeDynamicEnergy) << endl;
 		cout << "       |--- Cell SET Dynamic Energy    = " << TO_JOULE(bank->mat.subarray.cellSetEnergy) << endl;
-	} else if (cell->memCellType == SLCNAND) {
+	} else if (context->cell->memCellType == SLCNAND) {
 		cout << " - Erase Dynamic Energy = " << TO_JOULE(bank->resetDynamicEnergy) << " per block" << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->resetDynamicEnergy - bank->mat.resetDynamicEnergy
 														* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 														<< endl;
@@ -491,7 +630,7 @@ void Result::print() {
 														+ bank->mat.subarray.senseAmpMuxLev1.writeDynamicEnergy
 														+ bank->mat.subarray.senseAmpMuxLev2.writeDynamicEnergy) << endl;
 		cout << " - Programming Dynamic Energy = " << TO_JOULE(bank->setDynamicEnergy) << " per page" << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->setDynamicEnergy - bank->mat.setDynamicEnergy
 														* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 														<< endl;
@@ -513,7 +652,7 @@ void Result::print() {
 														+ bank->mat.subarray.senseAmpMuxLev2.writeDynamicEnergy) << endl;
 	} else {
 		cout << " - Write Dynamic Energy = " << TO_JOULE(bank->writeDynamicEnergy) << endl;
-		if (inputParameter->routingMode == h_tree)
+		if (context->inputParameter->routingMode == h_tree)
 			cout << " |--- H-Tree Dynamic Energy = " << TO_JOULE(bank->writeDynamicEnergy - bank->mat.writeDynamicEnergy
 														* bank->numActiveMatPerColumn * bank->numActiveMatPerRow)
 														<< endl;
@@ -533,13 +672,13 @@ void Result::print() {
 		cout << "       |--- Mux Dynamic Energy         = " << TO_JOULE(bank->mat.subarray.bitlineMux.writeDynamicEnergy
 														+ bank->mat.subarray.senseAmpMuxLev1.writeDynamicEnergy
 														+ bank->mat.subarray.senseAmpMuxLev2.writeDynamicEnergy) << endl;
-		if (cell->memCellType == MRAM) {
+		if (context->cell->memCellType == MRAM) {
 			cout << "       |--- Bitline & Cell Write Energy= " << TO_JOULE(bank->mat.subarray.cellResetEnergy) << endl;
 		}
 	}
 
 	cout << " - Leakage Power = " << TO_WATT(bank->leakage) << endl;
-	if (inputParameter->routingMode == h_tree)
+	if (context->inputParameter->routingMode == h_tree)
 		cout << " |--- H-Tree Leakage Power = " << TO_WATT(bank->leakage - bank->mat.leakage
 													* bank->numColumnMat * bank->numRowMat)
 													<< endl;
@@ -552,6 +691,8 @@ void Result::print() {
 
 
 void Result::printAsCache(Result &tagResult, CacheAccessMode cacheAccessMode) {
+	materialize();
+	tagResult.materialize();
 	if (bank->memoryType != data || tagResult.bank->memoryType != tag) {
 		cout << "This is not a valid cache configuration." << endl;
 		return;
@@ -633,7 +774,8 @@ void Result::printAsCache(Result &tagResult, CacheAccessMode cacheAccessMode) {
 	}
 }
 
-void Result::printToCsvFile(ofstream &outputFile) {
+void Result::printToCsvFile(ostream &outputFile) {
+	materialize();
 /*
 	outputFile << bank->readDynamicEnergy * 1e12 << ",";
 	outputFile << (bank->readDynamicEnergy - bank->mat.readDynamicEnergy
@@ -674,7 +816,7 @@ void Result::printToCsvFile(ofstream &outputFile) {
 	outputFile << bank->numRowSubarray << "," << bank->numColumnSubarray << "," << bank->numActiveSubarrayPerColumn << "," << bank->numActiveSubarrayPerRow << ",";
 	outputFile << bank->mat.subarray.numRow << "," << bank->mat.subarray.numColumn << ",";
 	outputFile << bank->muxSenseAmp << "," << bank->muxOutputLev1 << "," << bank->muxOutputLev2 << ",";
-	if (inputParameter->designTarget == cache)
+	if (context->inputParameter->designTarget == cache)
 		outputFile << bank->numRowPerSet << ",";
 	else
 		outputFile << "N/A,";
@@ -799,13 +941,15 @@ void Result::printToCsvFile(ofstream &outputFile) {
 	outputFile << bank->height * 1e6 << "," << bank->width * 1e6 << "," << bank->area * 1e6 << ",";
 	outputFile << bank->mat.height * 1e6 << "," << bank->mat.width * 1e6 << "," << bank->mat.area * 1e6 << ",";
 	outputFile << bank->mat.subarray.height * 1e6 << "," << bank->mat.subarray.width * 1e6 << "," << bank->mat.subarray.area * 1e6 << ",";
-	outputFile << cell->area * tech->featureSize * tech->featureSize * bank->capacity / bank->area * 100 << ",";
+	outputFile << context->cell->area * context->tech->featureSize * context->tech->featureSize * bank->capacity / bank->area * 100 << ",";
 	outputFile << bank->readLatency * 1e9 << "," << bank->writeLatency * 1e9 << ",";
 	outputFile << bank->readDynamicEnergy * 1e12 << "," << bank->writeDynamicEnergy * 1e12 << ",";
 	outputFile << bank->leakage * 1e3 << ",";
 }
 
-void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAccessMode, ofstream &outputFile) {
+void Result::printAsCacheToCsvFile(Result &tagResult, CacheAccessMode cacheAccessMode, ostream &outputFile) {
+	materialize();
+	tagResult.materialize();
 	if (bank->memoryType != data || tagResult.bank->memoryType != tag) {
 		cout << "This is not a valid cache configuration." << endl;
 		return;
@@ -41,6 +41,21 @@
 #include "BankWithHtree.h"
 #include "BankWithoutHtree.h"
 #include "Wire.h"
+#include "ParetoFrontier.h"
+
+/* What a result keeps of its bank: the organization and the metrics, enough to build the bank again */
+struct BankRecord {
+	DesignPoint design;		/* numRowMat is 0 if there is no design */
+	MemoryType memoryType;
+	long long capacity;		/* Unit: bit */
+	long blockSize;			/* Unit: bit */
+	int associativity;
+	int numRowSubarrayCell, numColumnSubarrayCell;
+	double height, width, area;		/* Unit: m, m, m^2 */
+	double readLatency, writeLatency, setLatency, resetLatency;		/* Unit: s */
+	double readDynamicEnergy, writeDynamicEnergy, setDynamicEnergy, resetDynamicEnergy;	/* Unit: J */
+	double leakage;		/* Unit: W */
+};
 
 class Result {
 public:
@@ -48,18 +63,30 @@ public:
 	virtual ~Result();
 
 	/* Functions */
+	void Initialize(SimulationContext *_context);
+	void store(Bank *newBank);		/* Keep the record of newBank, the materialized bank is dropped */
+	void adopt(Bank *newBank);		/* The same, and newBank (allocated with new) becomes the materialized bank */
+	void materialize();				/* Build the bank of the record again with the wires of this result, and complete the record */
+	void getObjective(double *objective);	/* Indexed by ParetoObjective, as Bank::GetObjective() */
 	void print();
 	void printAsCache(Result &tagBank, CacheAccessMode cacheAccessMode);
 	void reset();
-	void printToCsvFile(ofstream &outputFile);
-	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, ofstream &outputFile);
+	void printToCsvFile(ostream &outputFile);
+	void printAsCacheToCsvFile(Result &tagBank, CacheAccessMode cacheAccessMode, ostream &outputFile);
 	void compareAndUpdate(Result &newResult);
+	bool checkLimit(Bank *newBank);
+	bool checkLimit(const double *objective);	/* The metrics indexed by ParetoObjective */
+	bool checkShape(double height, double width);	/* Whether a bank of this size fits the floorplan limits */
 
+	SimulationContext *context;
 	OptimizationTarget optimizationTarget;	/* Exploration should not be assigned here */
 
-	Bank * bank;
-	Wire * localWire;		/* TO-DO: this one has the same name as one of the global variables */
-	Wire * globalWire;
+	BankRecord record;
+	Bank * bank;		/* The complete bank of the record, NULL until it is materialized */
+	const Wire * localWire;		/* Owned by the wire library of the context */
+	const Wire * globalWire;
+
+	long long sequence;		/* The position of this design in the BIGFOR order, -1 if unknown. Ties go to the smaller one */
 
 	double limitReadLatency;			/* The maximum allowable read latency, Unit: s */
 	double limitWriteLatency;			/* The maximum allowable write latency, Unit: s */
@@ -69,6 +96,9 @@ public:
 	double limitWriteEdp;				/* The maximum allowable write EDP, Unit: s-J */
 	double limitArea;					/* The maximum allowable area, Unit: m^2 */
 	double limitLeakage;				/* The maximum allowable leakage power, Unit: W */
+	double limitHeight;					/* The maximum allowable height, Unit: m */
+	double limitWidth;					/* The maximum allowable width, Unit: m */
+	double limitAspectRatio;			/* The maximum allowable longer side over the shorter one */
 };
 
 #endif /* RESULT_H_ */
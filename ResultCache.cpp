@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "ResultCache.h"
+#include "constant.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CACHE_MAGIC	"NVSim result cache"
+
+static bool ReadSection(istream &_entryFile, const string &_name, string *_text) {
+	string name;
+	size_t length;
+	if (!(_entryFile >> name >> length) || name != _name || _entryFile.get() != '\n')
+		return false;
+	_text->resize(length);
+	if (length > 0 && !_entryFile.read(&(*_text)[0], length))
+		return false;
+	return true;
+}
+
+static void WriteSection(ostream &_entryFile, const string &_name, const string &_text) {
+	_entryFile << _name << " " << _text.size() << "\n" << _text;
+}
+
+ResultCache::ResultCache() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	numHit = 0;
+	numMiss = 0;
+	numTemporary = 0;
+}
+
+ResultCache::~ResultCache() {
+	// TODO Auto-generated destructor stub
+}
+
+void ResultCache::Initialize(const string &_directory) {
+	directory = _directory;
+	mkdir(directory.c_str(), 0777);
+	struct stat status;
+	if (stat(directory.c_str(), &status) != 0 || !S_ISDIR(status.st_mode) || access(directory.c_str(), R_OK | W_OK | X_OK) != 0) {
+		cout << "[ResultCache] Error: Cannot use " << directory << " as the cache directory!" << endl;
+		return;
+	}
+	initialized = true;
+}
+
+string ResultCache::Key(InputParameter &_inputParameter, MemCell &_cell) {
+	stringstream key;
+	key << setprecision(17);	/* Enough to tell every two doubles apart */
+	key << "version=" << MODEL_VERSION << endl;
+	_inputParameter.PrintCanonical(key);
+	_cell.PrintCanonical(key);
+	return key.str();
+}
+
+bool ResultCache::Find(const string &_key, CacheEntry *_entry) {
+	if (!initialized)
+		return false;
+
+	ifstream entryFile(EntryFileName(_key).c_str(), ifstream::binary);
+	string magic, key;
+	bool found = entryFile.is_open() && getline(entryFile, magic) && magic == CACHE_MAGIC
+			&& ReadSection(entryFile, "key", &key) && key == _key
+			&& ReadSection(entryFile, "record", &_entry->record)
+			&& ReadSection(entryFile, "exploration", &_entry->exploration)
+			&& ReadSection(entryFile, "report", &_entry->report);
+	if (found)
+		numHit++;
+	else
+		numMiss++;
+	return found;
+}
+
+void ResultCache::Store(const string &_key, const CacheEntry &_entry) {
+	if (!initialized)
+		return;
+
+	string entryFileName = EntryFileName(_key);
+	stringstream temporaryFileName;
+	temporaryFileName << entryFileName << ".tmp." << getpid() << "." << numTemporary++;
+	ofstream entryFile(temporaryFileName.str().c_str(), ofstream::binary);
+	entryFile << CACHE_MAGIC << "\n";
+	WriteSection(entryFile, "key", _key);
+	WriteSection(entryFile, "record", _entry.record);
+	WriteSection(entryFile, "exploration", _entry.exploration);
+	WriteSection(entryFile, "report", _entry.report);
+	entryFile.close();
+	if (entryFile.fail() || rename(temporaryFileName.str().c_str(), entryFileName.c_str()) != 0) {
+		cout << "[ResultCache] Warning: Cannot write " << entryFileName << endl;
+		remove(temporaryFileName.str().c_str());
+	}
+}
+
+string ResultCache::Hash(const string &_key) {
+	uint64_t hash = 14695981039346656037ULL;	/* 64-bit FNV-1a */
+	for (size_t i = 0; i < _key.size(); i++) {
+		hash ^= (unsigned char)_key[i];
+		hash *= 1099511628211ULL;
+	}
+	stringstream text;
+	text << hex << setw(16) << setfill('0') << hash;
+	return text.str();
+}
+
+string ResultCache::EntryFileName(const string &_key) {
+	return directory + "/" + Hash(_key) + ".entry";
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef RESULTCACHE_H_
+#define RESULTCACHE_H_
+
+#include <atomic>
+#include <string>
+#include "InputParameter.h"
+#include "MemCell.h"
+
+using namespace std;
+
+/* What a run of a configuration produced */
+struct CacheEntry {
+	string record;		/* The CSV record of Simulator::PrintToCsvFile */
+	string exploration;	/* The rows appended to the exploration CSV file, if any */
+	string report;		/* The console output of the run, empty if it was run without one */
+};
+
+/* A directory of the results of earlier runs, addressed by a hash of the parsed configuration, the
+ * parsed cell and MODEL_VERSION. Each entry also holds its full key, so a hash collision is a miss.
+ * An entry is written to a temporary file and renamed into place, so the processes sharing the
+ * directory never read a partial entry; two writers of the same key write the same entry. */
+class ResultCache {
+public:
+	ResultCache();
+	virtual ~ResultCache();
+
+	/* Functions */
+	void Initialize(const string &_directory);	/* The directory is created if it does not exist */
+	static string Key(InputParameter &_inputParameter, MemCell &_cell);	/* Call it before the run changes them */
+	static string Hash(const string &_key);		/* 16 hex digits */
+	bool Find(const string &_key, CacheEntry *_entry);
+	void Store(const string &_key, const CacheEntry &_entry);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	string directory;
+	atomic<long long> numHit;
+	atomic<long long> numMiss;
+
+private:
+	string EntryFileName(const string &_key);
+
+	atomic<long long> numTemporary;	/* Makes the temporary file names unique within the process */
+};
+
+#endif /* RESULTCACHE_H_ */
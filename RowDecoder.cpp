@@ -37,7 +37,8 @@
 
 #include "RowDecoder.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 RowDecoder::RowDecoder() : FunctionUnit(){
 	// TODO Auto-generated constructor stub
@@ -49,8 +50,10 @@ RowDecoder::~RowDecoder() {
 	// TODO Auto-generated destructor stub
 }
 
-void RowDecoder::Initialize(int _numRow, double _capLoad, double _resLoad,
+void RowDecoder::Initialize(SimulationContext *_context, int _numRow, double _capLoad, double _resLoad,
 		bool _multipleRowPerSet, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent) {
+	context = _context;
+	PROFILE_STAGE(row_decoder_profile, initialize_stage);
 	if (initialized)
 		cout << "[Row Decoder] Warning: Already initialized!" << endl;
 
@@ -77,26 +80,27 @@ void RowDecoder::Initialize(int _numRow, double _capLoad, double _resLoad,
 		double logicEffortNand;
 		double capNand;
 		if (numNandInput == 2) {	/* NAND2 */
-			widthNandN = 2 * MIN_NMOS_SIZE * tech->featureSize;
-			logicEffortNand = (2+tech->pnSizeRatio) / (1+tech->pnSizeRatio);
+			widthNandN = 2 * MIN_NMOS_SIZE * context->tech->featureSize;
+			logicEffortNand = (2+context->tech->pnSizeRatio) / (1+context->tech->pnSizeRatio);
 		} else {					/* NAND3 */
-			widthNandN = 3 * MIN_NMOS_SIZE * tech->featureSize;
-			logicEffortNand = (3+tech->pnSizeRatio) / (1+tech->pnSizeRatio);
+			widthNandN = 3 * MIN_NMOS_SIZE * context->tech->featureSize;
+			logicEffortNand = (3+context->tech->pnSizeRatio) / (1+context->tech->pnSizeRatio);
 		}
-		widthNandP = tech->pnSizeRatio * MIN_NMOS_SIZE * tech->featureSize;
-		capNand = CalculateGateCap(widthNandN, *tech) + CalculateGateCap(widthNandP, *tech);
-		outputDriver.Initialize(logicEffortNand, capNand, capLoad, resLoad, true, areaOptimizationLevel, minDriverCurrent);
+		widthNandP = context->tech->pnSizeRatio * MIN_NMOS_SIZE * context->tech->featureSize;
+		capNand = CalculateGateCap(widthNandN, context->techView) + CalculateGateCap(widthNandP, context->techView);
+		outputDriver.Initialize(context, logicEffortNand, capNand, capLoad, resLoad, true, areaOptimizationLevel, minDriverCurrent);
 	} else {
 		/* we only need an 1-level output buffer to driver the wordline */
 		double capInv;
-		widthNandN = MIN_NMOS_SIZE * tech->featureSize;
-		widthNandP = tech->pnSizeRatio * MIN_NMOS_SIZE * tech->featureSize;
-		capInv = CalculateGateCap(widthNandN, *tech) + CalculateGateCap(widthNandP, *tech);
-		outputDriver.Initialize(1, capInv, capLoad, resLoad, true, areaOptimizationLevel, minDriverCurrent);
+		widthNandN = MIN_NMOS_SIZE * context->tech->featureSize;
+		widthNandP = context->tech->pnSizeRatio * MIN_NMOS_SIZE * context->tech->featureSize;
+		capInv = CalculateGateCap(widthNandN, context->techView) + CalculateGateCap(widthNandP, context->techView);
+		outputDriver.Initialize(context, 1, capInv, capLoad, resLoad, true, areaOptimizationLevel, minDriverCurrent);
 	}
 
 	if (outputDriver.invalid) {
 		invalid = true;
+		PROFILE_EVENT(invalid_row_decoder_event);
 		return;
 	}
 
@@ -104,6 +108,7 @@ void RowDecoder::Initialize(int _numRow, double _capLoad, double _resLoad,
 }
 
 void RowDecoder::CalculateArea() {
+	PROFILE_STAGE(row_decoder_profile, area_stage);
 	if (!initialized) {
 		cout << "[Row Decoder Area] Error: Require initialization first!" << endl;
 	} else {
@@ -113,7 +118,7 @@ void RowDecoder::CalculateArea() {
 			width = outputDriver.width;
 		} else {
 			double hNand, wNand;
-			CalculateGateArea(NAND, numNandInput, widthNandN, widthNandP, tech->featureSize*40, *tech, &hNand, &wNand);
+			CalculateGateArea(NAND, numNandInput, widthNandN, widthNandP, context->tech->featureSize*40, context->techView, &hNand, &wNand);
 			height = MAX(hNand, outputDriver.height);
 			width = wNand + outputDriver.width;
 		}
@@ -123,6 +128,7 @@ void RowDecoder::CalculateArea() {
 }
 
 void RowDecoder::CalculateRC() {
+	PROFILE_STAGE(row_decoder_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Row Decoder RC] Error: Require initialization first!" << endl;
 	} else {
@@ -130,12 +136,13 @@ void RowDecoder::CalculateRC() {
 		if (numNandInput == 0) {	/* no circuit needed, use predecoder outputs directly */
 			capNandInput = capNandOutput = 0;
 		} else {
-			CalculateGateCapacitance(NAND, numNandInput, widthNandN, widthNandP, tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech, &capNandInput, &capNandOutput);
+			CalculateGateCapacitance(NAND, numNandInput, widthNandN, widthNandP, context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView, &capNandInput, &capNandOutput);
 		}
 	}
 }
 
 void RowDecoder::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(row_decoder_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Row Decoder Latency] Error: Require initialization first!" << endl;
 	} else {
@@ -153,10 +160,10 @@ void RowDecoder::CalculateLatency(double _rampInput) {
 			double beta;	/* for horowitz calculation */
 			double rampInputForDriver;
 
-			resPullDown = CalculateOnResistance(widthNandN, NMOS, inputParameter->temperature, *tech) * numNandInput;
+			resPullDown = CalculateOnResistance(widthNandN, NMOS, context->techView) * numNandInput;
 			capLoad = capNandOutput + outputDriver.capInput[0];
 			tr = resPullDown * capLoad;
-			gm = CalculateTransconductance(widthNandN, NMOS, *tech);
+			gm = CalculateTransconductance(widthNandN, NMOS, context->techView);
 			beta = 1 / (resPullDown * gm);
 			readLatency = horowitz(tr, beta, rampInput, &rampInputForDriver);
 
@@ -169,6 +176,7 @@ void RowDecoder::CalculateLatency(double _rampInput) {
 }
 
 void RowDecoder::CalculatePower() {
+	PROFILE_STAGE(row_decoder_profile, power_stage);
 	if (!initialized) {
 		cout << "[Row Decoder Power] Error: Require initialization first!" << endl;
 	} else {
@@ -178,11 +186,10 @@ void RowDecoder::CalculatePower() {
 			readDynamicEnergy = writeDynamicEnergy = outputDriver.readDynamicEnergy;
 		} else {
 			/* Leakage power */
-			leakage += CalculateGateLeakage(NAND, numNandInput, widthNandN, widthNandP,
-					inputParameter->temperature, *tech) * tech->vdd;
+			leakage += CalculateGateLeakage(NAND, numNandInput, widthNandN, widthNandP, context->techView) * context->tech->vdd;
 			/* Dynamic energy */
 			double capLoad = capNandOutput + outputDriver.capInput[0];
-			readDynamicEnergy = capLoad * tech->vdd * tech->vdd;
+			readDynamicEnergy = capLoad * context->tech->vdd * context->tech->vdd;
 			readDynamicEnergy += outputDriver.readDynamicEnergy;
 			readDynamicEnergy *= 1;	/* only one row is activated each time */
 			writeDynamicEnergy = readDynamicEnergy;
@@ -196,6 +203,11 @@ void RowDecoder::PrintProperty() {
 	FunctionUnit::PrintProperty();
 }
 
+void RowDecoder::SetContext(SimulationContext *_context) {
+	context = _context;
+	outputDriver.SetContext(_context);
+}
+
 RowDecoder & RowDecoder::operator=(const RowDecoder &rhs) {
 	height = rhs.height;
 	width = rhs.width;
@@ -212,6 +224,7 @@ RowDecoder & RowDecoder::operator=(const RowDecoder &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
 	outputDriver = rhs.outputDriver;
@@ -49,12 +49,13 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _numRow, double _capLoad, double _resLoad,
+	void Initialize(SimulationContext *_context, int _numRow, double _capLoad, double _resLoad,
 			bool _multipleRowPerSet, BufferDesignTarget _areaOptimizationLevel, double _minDriverCurrent);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
 	void CalculatePower();
+	void SetContext(SimulationContext *_context);
 	RowDecoder & operator=(const RowDecoder &);
 
 	/* Properties */
@@ -0,0 +1,225 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "SearchSpace.h"
+#include "formula.h"
+#include "macros.h"
+
+SearchSpace::SearchSpace() {
+	// TODO Auto-generated constructor stub
+	minNumRowMat = 1;
+	maxNumRowMat = 512;
+	minNumColumnMat = 1;
+	maxNumColumnMat = 512;
+	minNumActiveMatPerRow = 1;
+	maxNumActiveMatPerRow = maxNumColumnMat;
+	minNumActiveMatPerColumn = 1;
+	maxNumActiveMatPerColumn = maxNumRowMat;
+	minNumRowSubarray = 1;
+	maxNumRowSubarray = 2;
+	minNumColumnSubarray = 1;
+	maxNumColumnSubarray = 2;
+	minNumActiveSubarrayPerRow = 1;
+	maxNumActiveSubarrayPerRow = maxNumColumnSubarray;
+	minNumActiveSubarrayPerColumn = 1;
+	maxNumActiveSubarrayPerColumn = maxNumRowSubarray;
+	minMuxSenseAmp = 1;
+	maxMuxSenseAmp = 256;
+	minMuxOutputLev1 = 1;
+	maxMuxOutputLev1 = 256;
+	minMuxOutputLev2 = 1;
+	maxMuxOutputLev2 = 256;
+	minNumRowPerSet = 1;
+	maxNumRowPerSet = 1;		/* The associativity before the configuration is read */
+	minAreaOptimizationLevel = latency_first;
+	maxAreaOptimizationLevel = area_first;
+	minLocalWireType = local_aggressive;
+	maxLocalWireType = semi_conservative;
+	minGlobalWireType = semi_aggressive;
+	maxGlobalWireType = global_conservative;
+	minLocalWireRepeaterType = repeated_none;
+	maxLocalWireRepeaterType = repeated_50;		/* The limit is repeated_50 */
+	minGlobalWireRepeaterType = repeated_none;
+	maxGlobalWireRepeaterType = repeated_50;	/* The limit is repeated_50 */
+	minIsLocalWireLowSwing = false;
+	maxIsLocalWireLowSwing = true;
+	minIsGlobalWireLowSwing = false;
+	maxIsGlobalWireLowSwing = true;
+}
+
+SearchSpace::~SearchSpace() {
+	// TODO Auto-generated destructor stub
+}
+
+SearchSpace SearchSpace::Reduced() const {
+	SearchSpace space;
+	space.maxNumRowMat = 64;
+	space.maxNumColumnMat = 64;
+	space.maxNumActiveMatPerRow = space.maxNumColumnMat;
+	space.maxNumActiveMatPerColumn = space.maxNumRowMat;
+	space.maxMuxSenseAmp = 64;
+	space.maxMuxOutputLev1 = 64;
+	space.maxMuxOutputLev2 = 64;
+	space.maxNumRowPerSet = 1;
+	space.minLocalWireType = local_aggressive;
+	space.maxLocalWireType = local_conservative;
+	space.minGlobalWireType = global_aggressive;
+	space.maxGlobalWireType = global_conservative;
+	space.maxLocalWireRepeaterType = repeated_opt;
+	space.maxGlobalWireRepeaterType = repeated_opt;
+	return space;
+}
+
+SearchSpace SearchSpace::WithRowPerSet(int _numRowPerSet) const {
+	SearchSpace space = *this;
+	space.minNumRowPerSet = space.maxNumRowPerSet = _numRowPerSet;
+	return space;
+}
+
+void SearchSpace::GetOrganizations(vector<DesignPoint> &_organizations) const {
+	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+
+	_organizations.clear();
+	ORGANIZATION_FORLOOP(*this) {
+		DesignPoint organization;
+		organization.numRowMat = numRowMat;
+		organization.numColumnMat = numColumnMat;
+		organization.numActiveMatPerRow = numActiveMatPerRow;
+		organization.numActiveMatPerColumn = numActiveMatPerColumn;
+		organization.numRowSubarray = numRowSubarray;
+		organization.numColumnSubarray = numColumnSubarray;
+		organization.numActiveSubarrayPerRow = numActiveSubarrayPerRow;
+		organization.numActiveSubarrayPerColumn = numActiveSubarrayPerColumn;
+		organization.muxSenseAmp = organization.muxOutputLev1 = organization.muxOutputLev2 = 0;
+		organization.numRowPerSet = organization.areaOptimizationLevel = 0;
+		_organizations.push_back(organization);
+	}
+}
+
+long SearchSpace::NumOrganization() const {
+	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+
+	long numOrganization = 0;
+	ORGANIZATION_FORLOOP(*this)
+		numOrganization++;
+	return numOrganization;
+}
+
+long long SearchSpace::NumPeripheralPoint(int _associativity) const {
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;
+
+	long long numPoint = 0;
+	PERIPHERAL_FORLOOP(*this, _associativity)
+		numPoint++;
+	return numPoint;
+}
+
+long long SearchSpace::NumPoint(int _associativity) const {
+	return NumOrganization() * NumPeripheralPoint(_associativity);
+}
+
+long SearchSpace::NumShardItem(long _numItem, int _shardIndex, int _numShard) {
+	if (_numShard <= 0)
+		return _numItem;
+	return (_numItem + _numShard - 1 - _shardIndex) / _numShard;
+}
+
+long SearchSpace::ShardItem(long _index, int _shardIndex, int _numShard) {
+	if (_numShard <= 0)
+		return _index;
+	return _shardIndex + _index * _numShard;
+}
+
+void SearchSpace::GetSpreadOrder(long _numItem, vector<long> &_order) {
+	/* The bit-reversal permutation of the next power of 2, without the items past the end */
+	int numBit = 0;
+	while ((1L << numBit) < _numItem)
+		numBit++;
+	_order.clear();
+	for (long i = 0; i < (1L << numBit); i++) {
+		long item = 0;
+		for (int b = 0; b < numBit; b++)
+			if (i & (1L << b))
+				item |= 1L << (numBit - 1 - b);
+		if (item < _numItem)
+			_order.push_back(item);
+	}
+}
+
+void SearchSpace::PrintCanonical(ostream &outputFile) const {
+	outputFile << "minNumRowMat=" << minNumRowMat << endl;
+	outputFile << "maxNumRowMat=" << maxNumRowMat << endl;
+	outputFile << "minNumColumnMat=" << minNumColumnMat << endl;
+	outputFile << "maxNumColumnMat=" << maxNumColumnMat << endl;
+	outputFile << "minNumActiveMatPerRow=" << minNumActiveMatPerRow << endl;
+	outputFile << "maxNumActiveMatPerRow=" << maxNumActiveMatPerRow << endl;
+	outputFile << "minNumActiveMatPerColumn=" << minNumActiveMatPerColumn << endl;
+	outputFile << "maxNumActiveMatPerColumn=" << maxNumActiveMatPerColumn << endl;
+	outputFile << "minNumRowSubarray=" << minNumRowSubarray << endl;
+	outputFile << "maxNumRowSubarray=" << maxNumRowSubarray << endl;
+	outputFile << "minNumColumnSubarray=" << minNumColumnSubarray << endl;
+	outputFile << "maxNumColumnSubarray=" << maxNumColumnSubarray << endl;
+	outputFile << "minNumActiveSubarrayPerRow=" << minNumActiveSubarrayPerRow << endl;
+	outputFile << "maxNumActiveSubarrayPerRow=" << maxNumActiveSubarrayPerRow << endl;
+	outputFile << "minNumActiveSubarrayPerColumn=" << minNumActiveSubarrayPerColumn << endl;
+	outputFile << "maxNumActiveSubarrayPerColumn=" << maxNumActiveSubarrayPerColumn << endl;
+	outputFile << "minMuxSenseAmp=" << minMuxSenseAmp << endl;
+	outputFile << "maxMuxSenseAmp=" << maxMuxSenseAmp << endl;
+	outputFile << "minMuxOutputLev1=" << minMuxOutputLev1 << endl;
+	outputFile << "maxMuxOutputLev1=" << maxMuxOutputLev1 << endl;
+	outputFile << "minMuxOutputLev2=" << minMuxOutputLev2 << endl;
+	outputFile << "maxMuxOutputLev2=" << maxMuxOutputLev2 << endl;
+	outputFile << "minNumRowPerSet=" << minNumRowPerSet << endl;
+	outputFile << "maxNumRowPerSet=" << maxNumRowPerSet << endl;
+	outputFile << "minAreaOptimizationLevel=" << minAreaOptimizationLevel << endl;
+	outputFile << "maxAreaOptimizationLevel=" << maxAreaOptimizationLevel << endl;
+	outputFile << "minLocalWireType=" << minLocalWireType << endl;
+	outputFile << "maxLocalWireType=" << maxLocalWireType << endl;
+	outputFile << "minGlobalWireType=" << minGlobalWireType << endl;
+	outputFile << "maxGlobalWireType=" << maxGlobalWireType << endl;
+	outputFile << "minLocalWireRepeaterType=" << minLocalWireRepeaterType << endl;
+	outputFile << "maxLocalWireRepeaterType=" << maxLocalWireRepeaterType << endl;
+	outputFile << "minGlobalWireRepeaterType=" << minGlobalWireRepeaterType << endl;
+	outputFile << "maxGlobalWireRepeaterType=" << maxGlobalWireRepeaterType << endl;
+	outputFile << "minIsLocalWireLowSwing=" << minIsLocalWireLowSwing << endl;
+	outputFile << "maxIsLocalWireLowSwing=" << maxIsLocalWireLowSwing << endl;
+	outputFile << "minIsGlobalWireLowSwing=" << minIsGlobalWireLowSwing << endl;
+	outputFile << "maxIsGlobalWireLowSwing=" << maxIsGlobalWireLowSwing << endl;
+}
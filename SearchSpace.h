@@ -0,0 +1,117 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef SEARCHSPACE_H_
+#define SEARCHSPACE_H_
+
+#include <iostream>
+#include <vector>
+#include "typedef.h"
+
+using namespace std;
+
+/* One BIGFOR point, enough to build the bank again */
+struct DesignPoint {
+	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
+	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
+	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
+	int areaOptimizationLevel;
+};
+
+/* The bounds of BIGFOR and of the wire refinement. The configuration sets them once when it is read,
+ * a search takes a copy and the smaller spaces are derived as new values, so a space is never changed
+ * under a running search. The ORGANIZATION_FORLOOP points are the work items of the threads and shards */
+class SearchSpace {
+public:
+	SearchSpace();
+	virtual ~SearchSpace();
+
+	/* Functions */
+	SearchSpace Reduced() const;	/* The smaller space the tags of a cache are searched in */
+	SearchSpace WithRowPerSet(int _numRowPerSet) const;	/* The same space with one number of rows per set */
+	void GetOrganizations(vector<DesignPoint> &_organizations) const;	/* The ORGANIZATION_FORLOOP points in order */
+	long NumOrganization() const;
+	long long NumPeripheralPoint(int _associativity) const;		/* The PERIPHERAL_FORLOOP points of each organization */
+	long long NumPoint(int _associativity) const;	/* The BIGFOR points */
+	static long NumShardItem(long _numItem, int _shardIndex, int _numShard);	/* The items of a shard, every item if _numShard is 0 */
+	static long ShardItem(long _index, int _shardIndex, int _numShard);		/* The item of the _index-th item of a shard */
+	static void GetSpreadOrder(long _numItem, vector<long> &_order);	/* Every item once, each prefix and each contiguous range of
+														the order samples the whole BIGFOR order evenly */
+	void PrintCanonical(ostream &outputFile) const;	/* One bound per line in a fixed order */
+
+	/* Properties */
+	int minNumRowMat;
+	int maxNumRowMat;
+	int minNumColumnMat;
+	int maxNumColumnMat;
+	int minNumActiveMatPerRow;
+	int maxNumActiveMatPerRow;
+	int minNumActiveMatPerColumn;
+	int maxNumActiveMatPerColumn;
+	int minNumRowSubarray;
+	int maxNumRowSubarray;
+	int minNumColumnSubarray;
+	int maxNumColumnSubarray;
+	int minNumActiveSubarrayPerRow;
+	int maxNumActiveSubarrayPerRow;
+	int minNumActiveSubarrayPerColumn;
+	int maxNumActiveSubarrayPerColumn;
+	int minMuxSenseAmp;
+	int maxMuxSenseAmp;
+	int minMuxOutputLev1;
+	int maxMuxOutputLev1;
+	int minMuxOutputLev2;
+	int maxMuxOutputLev2;
+	int minNumRowPerSet;
+	int maxNumRowPerSet;
+	int minAreaOptimizationLevel;	/* This one is actually OptPriority type */
+	int maxAreaOptimizationLevel;	/* This one is actually OptPriority type */
+	int minLocalWireType;			/* This one is actually WireType type */
+	int maxLocalWireType;			/* This one is actually WireType type */
+	int minGlobalWireType;			/* This one is actually WireType type */
+	int maxGlobalWireType;			/* This one is actually WireType type */
+	int minLocalWireRepeaterType;		/* This one is actually WireRepeaterType type */
+	int maxLocalWireRepeaterType;		/* This one is actually WireRepeaterType type */
+	int minGlobalWireRepeaterType;		/* This one is actually WireRepeaterType type */
+	int maxGlobalWireRepeaterType;		/* This one is actually WireRepeaterType type */
+	int minIsLocalWireLowSwing;		/* This one is actually boolean */
+	int maxIsLocalWireLowSwing;		/* This one is actually boolean */
+	int minIsGlobalWireLowSwing;		/* This one is actually boolean */
+	int maxIsGlobalWireLowSwing;		/* This one is actually boolean */
+};
+
+#endif /* SEARCHSPACE_H_ */
@@ -37,7 +37,8 @@
 
 #include "SenseAmp.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 
 SenseAmp::SenseAmp() {
 	// TODO Auto-generated constructor stub
@@ -49,7 +50,9 @@ SenseAmp::~SenseAmp() {
 	// TODO Auto-generated destructor stub
 }
 
-void SenseAmp::Initialize(long long _numColumn, bool _currentSense, double _senseVoltage, double _pitchSenseAmp) {
+void SenseAmp::Initialize(SimulationContext *_context, long long _numColumn, bool _currentSense, double _senseVoltage, double _pitchSenseAmp) {
+	context = _context;
+	PROFILE_STAGE(sense_amp_profile, initialize_stage);
 	if (initialized)
 		cout << "[Sense Amp] Warning: Already initialized!" << endl;
 
@@ -58,15 +61,17 @@ void SenseAmp::Initialize(long long _numColumn, bool _currentSense, double _sens
 	senseVoltage = _senseVoltage;
 	pitchSenseAmp = _pitchSenseAmp;
 
-	if (pitchSenseAmp <= tech->featureSize * 2) {
-		/* too small, cannot do the layout */
+	if (pitchSenseAmp < context->tech->featureSize * 3) {
+		/* too small, cannot do the layout, the transistors cannot even be folded */
 		invalid = true;
+		PROFILE_EVENT(invalid_sense_amp_event);
 	}
 
 	initialized = true;
 }
 
 void SenseAmp::CalculateArea() {
+	PROFILE_STAGE(sense_amp_profile, area_stage);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -74,33 +79,33 @@ void SenseAmp::CalculateArea() {
 	} else {
 		height = width = area = 0;
 		if (currentSense) {	/* current-sensing needs IV converter */
-			area += IV_CONVERTER_AREA * tech->featureSize * tech->featureSize;
+			area += IV_CONVERTER_AREA * context->tech->featureSize * context->tech->featureSize;
 		}
 		/* the following codes are transformed from CACTI 6.5 */
 		double tempHeight = 0;
 		double tempWidth = 0;
 
-		CalculateGateArea(INV, 1, 0, W_SENSE_P * tech->featureSize,
-				pitchSenseAmp, *tech, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
+		CalculateGateArea(INV, 1, 0, W_SENSE_P * context->tech->featureSize,
+				pitchSenseAmp, context->techView, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
 		width = MAX(width, tempWidth);
 		height += 2 * tempHeight;
-		CalculateGateArea(INV, 1, 0, W_SENSE_ISO * tech->featureSize,
-				pitchSenseAmp, *tech, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
+		CalculateGateArea(INV, 1, 0, W_SENSE_ISO * context->tech->featureSize,
+				pitchSenseAmp, context->techView, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
 		width = MAX(width, tempWidth);
 		height += tempHeight;
-		height += 2 * MIN_GAP_BET_SAME_TYPE_DIFFS * tech->featureSize;
+		height += 2 * MIN_GAP_BET_SAME_TYPE_DIFFS * context->tech->featureSize;
 
-		CalculateGateArea(INV, 1, W_SENSE_N * tech->featureSize, 0,
-				pitchSenseAmp, *tech, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
+		CalculateGateArea(INV, 1, W_SENSE_N * context->tech->featureSize, 0,
+				pitchSenseAmp, context->techView, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
 		width = MAX(width, tempWidth);
 		height += 2 * tempHeight;
-		CalculateGateArea(INV, 1, W_SENSE_EN * tech->featureSize, 0,
-				pitchSenseAmp, *tech, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
+		CalculateGateArea(INV, 1, W_SENSE_EN * context->tech->featureSize, 0,
+				pitchSenseAmp, context->techView, &tempWidth, &tempHeight);	/* exchange width and height for senseamp layout */
 		width = MAX(width, tempWidth);
 		height += tempHeight;
-		height += 2 * MIN_GAP_BET_SAME_TYPE_DIFFS * tech->featureSize;
+		height += 2 * MIN_GAP_BET_SAME_TYPE_DIFFS * context->tech->featureSize;
 
-		height += MIN_GAP_BET_P_AND_N_DIFFS * tech->featureSize;
+		height += MIN_GAP_BET_P_AND_N_DIFFS * context->tech->featureSize;
 
 		/* transformation so that width meets the pitch */
 		height = height * width / pitchSenseAmp;
@@ -115,49 +120,52 @@ void SenseAmp::CalculateArea() {
 }
 
 void SenseAmp::CalculateRC() {
+	PROFILE_STAGE(sense_amp_profile, rc_stage);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
 		readLatency = writeLatency = 1e41;
 	} else {
-		capLoad = CalculateGateCap((W_SENSE_P + W_SENSE_N) * tech->featureSize, *tech)
-				+ CalculateDrainCap(W_SENSE_N * tech->featureSize, NMOS, pitchSenseAmp, *tech)
-				+ CalculateDrainCap(W_SENSE_P * tech->featureSize, PMOS, pitchSenseAmp, *tech)
-				+ CalculateDrainCap(W_SENSE_ISO * tech->featureSize, PMOS, pitchSenseAmp, *tech)
-				+ CalculateDrainCap(W_SENSE_MUX * tech->featureSize, NMOS, pitchSenseAmp, *tech);
+		capLoad = CalculateGateCap((W_SENSE_P + W_SENSE_N) * context->tech->featureSize, context->techView)
+				+ CalculateDrainCap(W_SENSE_N * context->tech->featureSize, NMOS, pitchSenseAmp, context->techView)
+				+ CalculateDrainCap(W_SENSE_P * context->tech->featureSize, PMOS, pitchSenseAmp, context->techView)
+				+ CalculateDrainCap(W_SENSE_ISO * context->tech->featureSize, PMOS, pitchSenseAmp, context->techView)
+				+ CalculateDrainCap(W_SENSE_MUX * context->tech->featureSize, NMOS, pitchSenseAmp, context->techView);
 	}
 }
 
 void SenseAmp::CalculateLatency(double _rampInput) {	/* _rampInput is actually no use in SenseAmp */
 	if (!initialized) {
+	PROFILE_STAGE(sense_amp_profile, latency_stage);
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else {
 		readLatency = writeLatency = 0;
 		if (currentSense) {	/* current-sensing needs IV converter */
 			/* all the following values achieved from HSPICE */
-			if (tech->featureSize >= 119e-9)
+			if (context->tech->featureSize >= 119e-9)
 				readLatency += 0.49e-9;		/* 120nm */
-			else if (tech->featureSize >= 89e-9)
+			else if (context->tech->featureSize >= 89e-9)
 				readLatency += 0.53e-9;		/* 90nm */
-			else if (tech->featureSize >= 64e-9)
+			else if (context->tech->featureSize >= 64e-9)
 				readLatency += 0.62e-9;		/* 65nm */
-			else if (tech->featureSize >= 44e-9)
+			else if (context->tech->featureSize >= 44e-9)
 				readLatency += 0.80e-9;		/* 45nm */
-			else if (tech->featureSize >= 31e-9)
+			else if (context->tech->featureSize >= 31e-9)
 				readLatency += 1.07e-9;		/* 32nm */
 			else
 				readLatency += 1.45e-9;     /* below 22nm */
 		}
 
 		/* Voltage sense amplifier */
-		double gm = CalculateTransconductance(W_SENSE_N * tech->featureSize, NMOS, *tech)
-				+ CalculateTransconductance(W_SENSE_P * tech->featureSize, PMOS, *tech);
+		double gm = CalculateTransconductance(W_SENSE_N * context->tech->featureSize, NMOS, context->techView)
+				+ CalculateTransconductance(W_SENSE_P * context->tech->featureSize, PMOS, context->techView);
 		double tau = capLoad / gm;
-		readLatency += tau * log(tech->vdd / senseVoltage);
+		readLatency += tau * log(context->tech->vdd / senseVoltage);
 	}
 }
 
 void SenseAmp::CalculatePower() {
+	PROFILE_STAGE(sense_amp_profile, power_stage);
 	if (!initialized) {
 		cout << "[Sense Amp] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -167,19 +175,19 @@ void SenseAmp::CalculatePower() {
 		leakage = 0;
 		if (currentSense) {	/* current-sensing needs IV converter */
 			/* all the following values achieved from HSPICE */
-			if (tech->featureSize >= 119e-9) {			/* 120nm */
+			if (context->tech->featureSize >= 119e-9) {			/* 120nm */
 				readDynamicEnergy += 8.52e-14;	/* Unit: J */
 				leakage += 1.40e-8;				/* Unit: W */
-			} else if (tech->featureSize >= 89e-9) {	/* 90nm */
+			} else if (context->tech->featureSize >= 89e-9) {	/* 90nm */
 				readDynamicEnergy += 8.72e-14;
 				leakage += 1.87e-8;
-			} else if (tech->featureSize >= 64e-9) {	/* 65nm */
+			} else if (context->tech->featureSize >= 64e-9) {	/* 65nm */
 				readDynamicEnergy += 9.00e-14;
 				leakage += 2.57e-8;
-			} else if (tech->featureSize >= 44e-9) {	/* 45nm */
+			} else if (context->tech->featureSize >= 44e-9) {	/* 45nm */
 				readDynamicEnergy += 10.26e-14;
 				leakage += 4.41e-9;
-			} else if (tech->featureSize >= 31e-9) {	/* 32nm */
+			} else if (context->tech->featureSize >= 31e-9) {	/* 32nm */
 				readDynamicEnergy += 12.56e-14;
 				leakage += 12.54e-8;
 			} else {                                    /* TO-DO, need calibration below 22nm */
@@ -189,10 +197,9 @@ void SenseAmp::CalculatePower() {
 		}
 
 		/* Voltage sense amplifier */
-		readDynamicEnergy += capLoad * tech->vdd * tech->vdd;
-		double idleCurrent =  CalculateGateLeakage(INV, 1, W_SENSE_EN * tech->featureSize, 0,
-				inputParameter->temperature, *tech) * tech->vdd;
-		leakage += idleCurrent * tech->vdd;
+		readDynamicEnergy += capLoad * context->tech->vdd * context->tech->vdd;
+		double idleCurrent =  CalculateGateLeakage(INV, 1, W_SENSE_EN * context->tech->featureSize, 0, context->techView) * context->tech->vdd;
+		leakage += idleCurrent * context->tech->vdd;
 
 		readDynamicEnergy *= numColumn;
 		leakage *= numColumn;
@@ -220,6 +227,7 @@ SenseAmp & SenseAmp::operator=(const SenseAmp &rhs) {
 	cellSetEnergy = rhs.cellSetEnergy;
 	cellResetEnergy = rhs.cellResetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
 	invalid = rhs.invalid;
 	numColumn = rhs.numColumn;
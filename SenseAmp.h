@@ -47,7 +47,7 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(long long _numColumn, bool _currentSense, double _senseVoltage /* Unit: V */, double _pitchSenseAmp);
+	void Initialize(SimulationContext *_context, long long _numColumn, bool _currentSense, double _senseVoltage /* Unit: V */, double _pitchSenseAmp);
 	void CalculateArea();
 	void CalculateRC();
 	void CalculateLatency(double _rampInput);
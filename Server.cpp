@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Server.h"
+#include "SimulationContext.h"
+#include "Simulator.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+Server::Server() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	cache = NULL;
+	numQuery = 0;
+	listenSocket = -1;
+}
+
+Server::~Server() {
+	// TODO Auto-generated destructor stub
+	if (listenSocket >= 0) {
+		close(listenSocket);
+		unlink(socketPath.c_str());
+	}
+}
+
+void Server::Initialize(const string &_socketPath) {
+	socketPath = _socketPath;
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path)) {
+		cout << "[Server] Error: The socket path " << socketPath << " is too long!" << endl;
+		return;
+	}
+	strcpy(address.sun_path, socketPath.c_str());
+
+	listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenSocket < 0) {
+		cout << "[Server] Error: Cannot create the socket!" << endl;
+		return;
+	}
+	unlink(socketPath.c_str());
+	if (bind(listenSocket, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listenSocket, 16) < 0) {
+		cout << "[Server] Error: Cannot listen on " << socketPath << "!" << endl;
+		close(listenSocket);
+		listenSocket = -1;
+		return;
+	}
+
+	initialized = true;
+}
+
+void Server::Run(ThreadPool *pool) {
+	if (!initialized) {
+		cout << "[Server] Error: Require initialization first!" << endl;
+		return;
+	}
+
+	signal(SIGPIPE, SIG_IGN);	/* A client that leaves early must not stop the server */
+	bool running = true;
+	while (running) {
+		int connection = accept(listenSocket, NULL, NULL);
+		if (connection < 0)
+			continue;
+		running = Serve(connection, pool);
+	}
+}
+
+bool Server::Serve(int _connection, ThreadPool *pool) {
+	FILE *input = fdopen(_connection, "r");
+	FILE *output = fdopen(dup(_connection), "w");
+	bool running = true;
+	char *line = NULL;
+	size_t lineSize = 0;
+	ssize_t length;
+
+	string section;		/* The section being read: CONFIG, CELL or none */
+	string inputText, cellText;
+	while ((length = getline(&line, &lineSize, input)) >= 0) {
+		string command(line, length);
+		command.erase(command.find_last_not_of("\r\n") + 1);
+
+		if (command == "CONFIG" || command == "CELL") {
+			if (command == "CONFIG") {
+				inputText.clear();
+				cellText.clear();
+			}
+			section = command;
+		} else if (command == "END") {
+			fputs(Evaluate(inputText, cellText, pool).c_str(), output);
+			fflush(output);
+			section.clear();
+		} else if (section == "CONFIG") {
+			inputText += command + "\n";
+		} else if (section == "CELL") {
+			cellText += command + "\n";
+		} else if (command == "SHUTDOWN") {
+			fputs("Shutdown\n", output);
+			running = false;
+			break;
+		} else if (!command.empty()) {
+			fputs(("Error,0,Unknown command " + command + "\n").c_str(), output);
+			fflush(output);
+		}
+	}
+
+	free(line);
+	fclose(output);
+	fclose(input);
+	return running;
+}
+
+string Server::Evaluate(const string &_inputText, const string &_cellText, ThreadPool *pool) {
+	stringstream record;
+	numQuery++;
+
+	if (_cellText.empty()) {
+		InputParameter inputParameter;
+		inputParameter.ReadInputParameterFromText(_inputText);
+		FILE *cellFile = fopen(inputParameter.fileMemCell.c_str(), "r");
+		if (!cellFile) {
+			record << "Not Found,0," << inputParameter.fileMemCell << endl;
+			return record.str();
+		}
+		fclose(cellFile);
+	}
+
+	SimulationContext *context = new SimulationContext();
+	string error;
+	if (!context->InitializeFromText(_inputText, _cellText, &library, &error)) {
+		/* The same check as nvsim_create(), one query must not stop the server for the others */
+		record << "Error,0," << error << endl;
+		delete context;
+		return record.str();
+	}
+
+	Simulator simulator;
+	simulator.verbose = false;
+	simulator.Initialize(context);
+
+	string cacheKey;
+	CacheEntry cacheEntry;
+	if (cache)
+		cacheKey = ResultCache::Key(*context->inputParameter, *context->cell);
+	if (cache && cache->Find(cacheKey, &cacheEntry)) {
+		record << cacheEntry.record;
+	} else {
+		stringstream exploration;
+		if (simulator.Run(pool, &exploration)) {
+			simulator.PrintToCsvFile(record);
+			cacheEntry.record = record.str();
+			cacheEntry.exploration = exploration.str();
+			if (cache)
+				cache->Store(cacheKey, cacheEntry);
+		} else {
+			record << "Not Supported,0" << endl;
+		}
+	}
+	if (!cacheEntry.exploration.empty()) {
+		ofstream explorationFile(simulator.OutputFileName().c_str(), ofstream::app);
+		explorationFile << cacheEntry.exploration;
+		explorationFile.close();
+	}
+
+	delete context;
+	return record.str();
+}
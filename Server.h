@@ -0,0 +1,84 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+#include <stdio.h>
+#include <string>
+#include "ThreadPool.h"
+#include "ModelLibrary.h"
+#include "ResultCache.h"
+
+using namespace std;
+
+/* Answers the queries of other programs on a UNIX domain socket. A query is a configuration,
+ * and optionally a cell, in the .cfg and .cell formats:
+ *
+ *     CONFIG
+ *     <.cfg lines>
+ *     CELL
+ *     <.cell lines>		(the cell file of the configuration is read without this section)
+ *     END
+ *
+ * and the answer is a single line, the CSV record of Simulator::PrintToCsvFile. "SHUTDOWN"
+ * stops the server. The technology, wire and subarray models of the queries stay in a
+ * ModelLibrary, so the repeated and forced-organization queries do not build them again. */
+class Server {
+public:
+	Server();
+	virtual ~Server();
+
+	/* Functions */
+	void Initialize(const string &_socketPath);	/* Create the socket, an existing file at the path is replaced */
+	void Run(ThreadPool *pool);		/* Serve the connections one at a time until a SHUTDOWN */
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	string socketPath;
+	ModelLibrary library;
+	ResultCache *cache;	/* The results of the earlier runs, NULL if not cached */
+	long long numQuery;	/* Number of queries answered so far */
+
+private:
+	bool Serve(int _connection, ThreadPool *pool);	/* False after a SHUTDOWN */
+	string Evaluate(const string &_inputText, const string &_cellText, ThreadPool *pool);
+
+	int listenSocket;
+};
+
+#endif /* SERVER_H_ */
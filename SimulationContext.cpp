@@ -0,0 +1,216 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "SimulationContext.h"
+#include "macros.h"
+
+SimulationContext::SimulationContext() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	sharedModel = false;
+	libraryModel = false;
+	inputParameter = NULL;
+	tech = NULL;
+	cell = NULL;
+	wireLibrary = NULL;
+	localWire = NULL;
+	globalWire = NULL;
+	subarrayCache = new SubArrayCache();
+	profiler = NULL;
+}
+
+SimulationContext::~SimulationContext() {
+	// TODO Auto-generated destructor stub
+	if (!sharedModel) {
+		if (inputParameter)
+			delete inputParameter;
+		if (cell)
+			delete cell;
+		if (profiler)
+			delete profiler;
+	}
+	if (!sharedModel && !libraryModel) {
+		if (tech)
+			delete tech;
+		if (wireLibrary)
+			delete wireLibrary;
+		delete subarrayCache;
+	}
+}
+
+bool SimulationContext::Initialize(const string & inputFile, ModelLibrary *_library, string *_error) {
+	if (initialized)
+		cout << "[SimulationContext] Warning: Already initialized!" << endl;
+
+	inputParameter = new InputParameter();
+	inputParameter->ReadInputParameterFromFile(inputFile);
+
+	cell = new MemCell();
+	cell->ReadCellFromFile(inputParameter->fileMemCell);
+
+//	cell->CellScaling(inputParameter->processNode);
+
+	if (!CheckModel(_error))
+		return false;
+	LoadModel(_library, inputParameter->fileMemCell);
+	initialized = true;
+	return true;
+}
+
+bool SimulationContext::InitializeFromText(const string & inputText, const string & cellText, ModelLibrary *_library, string *_error) {
+	if (initialized)
+		cout << "[SimulationContext] Warning: Already initialized!" << endl;
+
+	inputParameter = new InputParameter();
+	inputParameter->ReadInputParameterFromText(inputText);
+
+	cell = new MemCell();
+	if (cellText.empty())
+		cell->ReadCellFromFile(inputParameter->fileMemCell);
+	else
+		cell->ReadCellFromText(cellText);
+
+	if (!CheckModel(_error))
+		return false;
+	LoadModel(_library, cellText.empty() ? inputParameter->fileMemCell : cellText);
+	initialized = true;
+	return true;
+}
+
+bool SimulationContext::CheckModel(string *_error) {
+	/* The technology and the wire models would stop the process on these, and the subarrays could not sense */
+	const SearchSpace &space = inputParameter->searchSpace;
+	string error;
+	if (inputParameter->temperature < 300 || inputParameter->temperature > 400)
+		error = "Temperature is out of range";
+	else if ((cell->memCellType == DRAM || cell->memCellType == eDRAM) && !inputParameter->internalSensing)
+		error = "DRAM does not support external sense amplifiers";
+	else if ((space.minLocalWireRepeaterType == space.maxLocalWireRepeaterType && space.minLocalWireRepeaterType != repeated_none
+			&& space.minIsLocalWireLowSwing == space.maxIsLocalWireLowSwing && space.minIsLocalWireLowSwing)
+			|| (space.minGlobalWireRepeaterType == space.maxGlobalWireRepeaterType && space.minGlobalWireRepeaterType != repeated_none
+			&& space.minIsGlobalWireLowSwing == space.maxIsGlobalWireLowSwing && space.minIsGlobalWireLowSwing))
+		error = "Low swing is not supported for repeated wires";	/* The basic wires of INITIAL_BASIC_WIRE */
+	if (error.empty())
+		return true;
+	if (_error)
+		*_error = error;
+	return false;
+}
+
+void SimulationContext::LoadModel(ModelLibrary *_library, const string & _cell) {
+	if (_library) {
+		SimulationContext *model = _library->GetModel(*this, _cell);
+		libraryModel = true;
+		delete subarrayCache;
+		tech = model->tech;
+		techView = model->techView;
+		wireLibrary = model->wireLibrary;
+		subarrayCache = model->subarrayCache;
+	} else {
+		InitializeTechnology();
+		wireLibrary = new WireLibrary();
+		wireLibrary->Initialize(this);
+	}
+}
+
+void SimulationContext::InitializeModel(const InputParameter &_inputParameter, const MemCell &_cell) {
+	inputParameter = new InputParameter(_inputParameter);
+	cell = new MemCell(_cell);
+	InitializeTechnology();
+	wireLibrary = new WireLibrary();
+	wireLibrary->Initialize(this);
+	initialized = true;
+}
+
+void SimulationContext::InitializeTechnology() {
+	tech = new Technology();
+	tech->Initialize(inputParameter->processNode, inputParameter->deviceRoadmap);
+
+	Technology techHigh;
+	double alpha = 0;
+	if (inputParameter->processNode > 200){
+		// TO-DO: technology node > 200 nm
+	} else if (inputParameter->processNode > 120) { // 120 nm < technology node <= 200 nm
+		techHigh.Initialize(200, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 120.0) / 60;
+	} else if (inputParameter->processNode > 90) { // 90 nm < technology node <= 120 nm
+		techHigh.Initialize(120, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 90.0) / 30;
+	} else if (inputParameter->processNode > 65) { // 65 nm < technology node <= 90 nm
+		techHigh.Initialize(90, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 65.0) / 25;
+	} else if (inputParameter->processNode > 45) { // 45 nm < technology node <= 65 nm
+		techHigh.Initialize(65, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 45.0) / 20;
+	} else if (inputParameter->processNode >= 32) { // 32 nm < technology node <= 45 nm
+		techHigh.Initialize(45, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 32.0) / 13;
+	} else if (inputParameter->processNode >= 22) { // 22 nm < technology node <= 32 nm
+		techHigh.Initialize(32, inputParameter->deviceRoadmap);
+		alpha = (inputParameter->processNode - 22.0) / 10;
+	} else {
+		//TO-DO: technology node < 22 nm
+	}
+
+	tech->InterpolateWith(techHigh, alpha);
+	techView.Initialize(*tech, inputParameter->temperature);
+}
+
+void SimulationContext::InitializeWith(SimulationContext *_parent) {
+	sharedModel = true;
+	inputParameter = _parent->inputParameter;
+	tech = _parent->tech;
+	techView = _parent->techView;
+	cell = _parent->cell;
+	wireLibrary = _parent->wireLibrary;
+	localWire = _parent->localWire;
+	globalWire = _parent->globalWire;
+	delete subarrayCache;
+	subarrayCache = _parent->subarrayCache;
+	profiler = _parent->profiler;
+	initialized = true;
+}
+
+void SimulationContext::SetLocalWire(WireType _wireType, WireRepeaterType _wireRepeaterType, bool _isLowSwing) {
+	localWire = wireLibrary->GetWire(inputParameter->processNode, _wireType, _wireRepeaterType,
+			inputParameter->temperature, _isLowSwing);
+}
+
+void SimulationContext::SetGlobalWire(WireType _wireType, WireRepeaterType _wireRepeaterType, bool _isLowSwing) {
+	globalWire = wireLibrary->GetWire(inputParameter->processNode, _wireType, _wireRepeaterType,
+			inputParameter->temperature, _isLowSwing);
+}
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef SIMULATIONCONTEXT_H_
+#define SIMULATIONCONTEXT_H_
+
+#include <string>
+#include "InputParameter.h"
+#include "Technology.h"
+#include "TechView.h"
+#include "MemCell.h"
+#include "Wire.h"
+#include "WireLibrary.h"
+#include "SubArrayCache.h"
+#include "Profiler.h"
+#include "ModelLibrary.h"
+
+/* Everything a simulation reads: the configuration, the technology, the cell and the wire models.
+ * It is passed to Bank::Initialize and from there down to every FunctionUnit. */
+class SimulationContext {
+public:
+	SimulationContext();
+	virtual ~SimulationContext();
+
+	/* Functions */
+	bool Initialize(const std::string & inputFile, ModelLibrary *_library = NULL, std::string *_error = NULL);	/* Load the configuration, the technology
+											and the memory cell. The technology, wire and subarray models are taken from _library if it is given.
+											False if the models cannot be built for the configuration, _error tells why */
+	bool InitializeFromText(const std::string & inputText, const std::string & cellText, ModelLibrary *_library = NULL,
+			std::string *_error = NULL);	/* The same from the file contents, the cell file of the configuration is read if cellText is empty */
+	void InitializeModel(const InputParameter &_inputParameter, const MemCell &_cell);	/* A model context of a ModelLibrary */
+	void InitializeWith(SimulationContext *_parent);	/* Share the models, the wire library, the subarray cache and the profiler of the parent */
+	void SetLocalWire(WireType _wireType, WireRepeaterType _wireRepeaterType, bool _isLowSwing);
+	void SetGlobalWire(WireType _wireType, WireRepeaterType _wireRepeaterType, bool _isLowSwing);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	bool sharedModel;	/* inputParameter, tech, cell, wireLibrary, subarrayCache and profiler belong to the parent context */
+	bool libraryModel;	/* tech, wireLibrary and subarrayCache belong to a ModelLibrary */
+	InputParameter *inputParameter;
+	Technology *tech;
+	TechView techView;	/* The tech parameters at the configured temperature, for the formulas */
+	MemCell *cell;
+	WireLibrary *wireLibrary;	/* Every wire variant used by this context */
+	const Wire *localWire;	/* The wire type of local interconnects (for example, wire in mat), owned by wireLibrary */
+	const Wire *globalWire;	/* The wire type of global interconnects (for example, the ones that connect mats), owned by wireLibrary */
+	SubArrayCache *subarrayCache;	/* The subarrays built with this context so far */
+	Profiler *profiler;		/* Counts the events and times the calculations, NULL if not profiled */
+
+private:
+	bool CheckModel(std::string *_error);	/* The configurations the models cannot be built for, before any of them is */
+	void LoadModel(ModelLibrary *_library, const std::string & _cell);	/* Take or build tech, wireLibrary and subarrayCache */
+	void InitializeTechnology();	/* Build tech and techView for the configured process node and temperature */
+};
+
+#endif /* SIMULATIONCONTEXT_H_ */
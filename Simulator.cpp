@@ -0,0 +1,811 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "Simulator.h"
+#include "SimulationContext.h"
+#include "Explorer.h"
+#include "WireRefiner.h"
+#include "ParetoFrontier.h"
+#include "ResultCache.h"
+#include "formula.h"
+#include "macros.h"
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <math.h>
+#include <stdio.h>
+
+#define SHARD_MAGIC	"NVSim shard"
+
+static void WriteDesign(ostream &_file, const DesignPoint &_design) {
+	_file << " " << _design.numRowMat << " " << _design.numColumnMat << " " << _design.numActiveMatPerRow << " " << _design.numActiveMatPerColumn
+			<< " " << _design.numRowSubarray << " " << _design.numColumnSubarray << " " << _design.numActiveSubarrayPerRow << " " << _design.numActiveSubarrayPerColumn
+			<< " " << _design.muxSenseAmp << " " << _design.muxOutputLev1 << " " << _design.muxOutputLev2 << " " << _design.numRowPerSet
+			<< " " << _design.areaOptimizationLevel;
+}
+
+static void ReadDesign(istream &_file, DesignPoint *_design) {
+	_file >> _design->numRowMat >> _design->numColumnMat >> _design->numActiveMatPerRow >> _design->numActiveMatPerColumn
+			>> _design->numRowSubarray >> _design->numColumnSubarray >> _design->numActiveSubarrayPerRow >> _design->numActiveSubarrayPerColumn
+			>> _design->muxSenseAmp >> _design->muxOutputLev1 >> _design->muxOutputLev2 >> _design->numRowPerSet
+			>> _design->areaOptimizationLevel;
+}
+
+static long ParseItem(const string &_line, long *_size) {
+	long index;
+	if (sscanf(_line.c_str(), "Item %ld %ld", &index, _size) != 2)
+		return -1;
+	return index;
+}
+
+Simulator::Simulator() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	verbose = true;
+	context = NULL;
+	numSolution = 0;
+	numTagSolution = 0;
+	numTopK = 0;
+	numShard = 0;
+	shardIndex = 0;
+	progress = NULL;
+}
+
+Simulator::~Simulator() {
+	// TODO Auto-generated destructor stub
+}
+
+void Simulator::Initialize(SimulationContext *_context) {
+	context = _context;
+	loadedParameter = *context->inputParameter;
+	tagContext.InitializeWith(context);
+	tagContext.inputParameter = &tagParameter;
+	for (int i = 0; i < (int)full_exploration; i++) {
+		bestDataResults[i].Initialize(context);
+		bestDataResults[i].optimizationTarget = (OptimizationTarget)i;
+		bestTagResults[i].Initialize(&tagContext);
+		bestTagResults[i].optimizationTarget = (OptimizationTarget)i;
+	}
+	initialized = true;
+}
+
+bool Simulator::Run(ThreadPool *pool, ostream *outputFile) {
+	if (!initialized) {
+		cout << "[Simulator] Error: Require initialization first!" << endl;
+		return false;
+	}
+	if (context->inputParameter->optimizationTarget == full_exploration && !outputFile) {
+		cout << "[Simulator] Error: The exploration requires an output file!" << endl;
+		return false;
+	}
+	if (numShard > 0 && !outputFile) {
+		cout << "[Simulator] Error: A shard requires an output file!" << endl;
+		return false;
+	}
+	if (progress && progress->timeBudget > 0 && (numShard > 0 || (context->inputParameter->optimizationTarget == full_exploration
+			&& !context->inputParameter->isPruningEnabled))) {
+		cout << "[Simulator] Error: A time budget requires a single run that does not write every design!" << endl;
+		return false;
+	}
+
+	string key;
+	if (numShard > 0)
+		key = ShardKey();
+	if (!Prepare())
+		return false;
+	if (numShard > 0)
+		*outputFile << SHARD_MAGIC << endl << "Shard " << shardIndex << " " << numShard << " " << key << endl;
+
+	bool isCache = context->inputParameter->designTarget == cache;
+	bool isFullExploration = context->inputParameter->optimizationTarget == full_exploration && !context->inputParameter->isPruningEnabled;
+	if (isCache && isFullExploration) {
+		/* Every row of the data exploration is written with the refined tags, so they come first */
+		ExploreTag(pool);
+		if (numTagSolution == 0) {
+			if (numShard > 0)
+				WriteShard(*outputFile);
+			return true;	/* No valid solutions for tags */
+		}
+	}
+
+	PrepareData();
+	dataExplorer.shardIndex = shardIndex;
+	dataExplorer.numShard = numShard;
+	ostream *rows = isFullExploration ? outputFile : NULL;
+	Result *rowTags = isCache && isFullExploration ? bestTagResults : NULL;
+	ParetoFrontier *frontier = NULL;
+	if (!isFullExploration && (context->inputParameter->optimizationTarget == full_exploration || context->inputParameter->isConstraintApplied))
+		frontier = &dataFrontier;
+
+	if (progress) {
+		long long numPoint = dataSpace.NumPoint(context->inputParameter->associativity);
+		if (isCache && !isFullExploration)
+			numPoint += tagSpace.NumPoint(context->inputParameter->associativity);
+		tagExplorer.progress = isCache && !isFullExploration ? progress : NULL;
+		dataExplorer.progress = progress;
+		progress->Start(numPoint);
+	}
+
+	if (isCache && !isFullExploration) {
+		/* The tags and the data do not depend on each other until the report, so both explorations share
+		 * one pass of the pool and the workers never wait for the end of the smaller one */
+		long numTagItem = tagExplorer.Start(pool, bestTagResults, false, NULL, NULL, NULL);
+		long numDataItem = dataExplorer.Start(pool, bestDataResults, false, rows, rowTags, frontier);
+		ExplorerPair pair;
+		pair.Initialize(&tagExplorer, numTagItem, &dataExplorer, numDataItem);
+		pair.interleaved = progress && progress->timeBudget > 0;
+		pair.Run(pool);
+		numTagSolution = tagExplorer.Finish(bestTagResults);
+		numSolution = dataExplorer.Finish(numTagSolution > 0 ? bestDataResults : NULL);
+		if (progress)
+			progress->Stop();
+		if (numTagSolution == 0) {
+			if (numShard > 0)
+				WriteShard(*outputFile);
+			return true;	/* No valid solutions for tags */
+		}
+		RefineTag(pool);
+	} else if (!isCache || numTagSolution > 0) {
+		numSolution = dataExplorer.Explore(pool, bestDataResults, false, rows, rowTags, frontier);
+		if (progress)
+			progress->Stop();
+	}
+
+	if (numShard > 0)
+		WriteShard(*outputFile);
+	else
+		Finish(pool, outputFile);
+	return true;
+}
+
+bool Simulator::Merge(ThreadPool *pool, vector<istream *> &shardFiles, ostream *outputFile) {
+	if (!initialized) {
+		cout << "[Simulator] Error: Require initialization first!" << endl;
+		return false;
+	}
+	if (context->inputParameter->optimizationTarget == full_exploration && !outputFile) {
+		cout << "[Simulator] Error: The exploration requires an output file!" << endl;
+		return false;
+	}
+
+	/* Every shard of this configuration and model version has to be there, exactly once */
+	string key = ShardKey();
+	if ((int)shardFiles.size() != numShard) {
+		cout << "[Simulator] Error: " << numShard << " shards are required, " << shardFiles.size() << " are given!" << endl;
+		return false;
+	}
+	for (int s = 0; s < numShard; s++) {
+		string magic, header, shardKey;
+		int index = -1, number = 0;
+		getline(*shardFiles[s], magic);
+		*shardFiles[s] >> header >> index >> number >> shardKey;
+		shardFiles[s]->ignore(numeric_limits<streamsize>::max(), '\n');
+		if (magic != SHARD_MAGIC || header != "Shard" || index != s || number != numShard || shardKey != key) {
+			cout << "[Simulator] Error: The file of shard " << s << " does not belong to this configuration and version!" << endl;
+			return false;
+		}
+	}
+
+	if (!Prepare())
+		return false;
+	if (context->inputParameter->designTarget == cache) {
+		ExploreTag(pool);
+		if (numTagSolution == 0)
+			return true;	/* No valid solutions for tags */
+	}
+
+	PrepareData();
+	if (!ReadShards(shardFiles, outputFile))
+		return false;
+	Finish(pool, outputFile);
+	return true;
+}
+
+bool Simulator::Prepare() {
+	if (verbose)
+		context->cell->PrintCell();
+
+	if (!ApplyConstraint())
+		return false;
+	if (numShard > 0 && context->inputParameter->topK > 1) {
+		cout << "[Simulator] Error: The best designs of a sharded run cannot be merged!" << endl;
+		return false;
+	}
+
+	long blockSize;
+
+	numSolution = 0;
+	numTagSolution = 0;
+
+	if (verbose)
+		context->inputParameter->PrintInputParameter(context->cell->memCellType);
+
+	/* the tag array is designed in its own context */
+	if (context->inputParameter->designTarget == cache) {
+		tagParameter = *context->inputParameter;
+		tagSpace = context->inputParameter->searchSpace.Reduced();
+		SimulationContext *context = &tagContext;	/* for the macros */
+		/* calculate the tag configuration */
+		int numDataSet = context->inputParameter->capacity * 8 / context->inputParameter->wordWidth / context->inputParameter->associativity;
+		int numIndexBit = (int)(log2(numDataSet) + 0.1);
+		int numOffsetBit = (int)(log2(context->inputParameter->wordWidth / 8) + 0.1);
+		INITIAL_BASIC_WIRE(tagSpace);
+		/* Simulate tag */
+		blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
+		blockSize += 2;		/* add dirty bits and valid bits */
+		tagExplorer.Initialize(context, tagSpace, tag, 0 /* derived from the block size of each design */, blockSize, context->inputParameter->associativity);
+		tagExplorer.boundTarget = context->inputParameter->optimizationTarget;	/* The tags are not constrained */
+	}
+	return true;
+}
+
+void Simulator::ExploreTag(ThreadPool *pool) {
+	numTagSolution = tagExplorer.Explore(pool, bestTagResults, false, NULL, NULL, NULL);
+	if (numTagSolution > 0)
+		RefineTag(pool);
+}
+
+void Simulator::RefineTag(ThreadPool *pool) {
+	WireRefiner tagRefiner;
+	tagRefiner.Initialize(&tagContext, tagSpace, tag);
+	tagRefiner.refineTarget = tagParameter.optimizationTarget;
+	tagRefiner.RefineLocalWire(pool, bestTagResults, NULL, NULL);
+	tagRefiner.RefineGlobalWire(pool, bestTagResults, NULL, NULL);
+	if (tagParameter.optimizationTarget == full_exploration && !tagParameter.isPruningEnabled)
+		for (int i = 0; i < (int)full_exploration; i++)
+			bestTagResults[i].materialize();	/* The data workers write their breakdown with each row */
+}
+
+void Simulator::PrepareData() {
+	long long capacity;
+	long blockSize;
+	int associativity;
+
+	GetDataBankSize(&capacity, &blockSize, &associativity);
+	for (int i = 0; i < (int)full_exploration; i++) {
+		/* The tags are not constrained, the floorplan is of the data bank */
+		bestDataResults[i].limitHeight = context->inputParameter->maxBankHeight;
+		bestDataResults[i].limitWidth = context->inputParameter->maxBankWidth;
+		bestDataResults[i].limitAspectRatio = context->inputParameter->maxAspectRatio;
+	}
+	dataSpace = context->inputParameter->searchSpace;
+	if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode == normal_access_mode) {
+		/* Normal access does not allow one set be distributed into multiple rows
+		 * otherwise, the row activation has to be delayed until the hit signals arrive.
+		 */
+		dataSpace = dataSpace.WithRowPerSet(1);
+	}
+
+	INITIAL_BASIC_WIRE(dataSpace);
+	dataExplorer.Initialize(context, dataSpace, data, capacity, blockSize, associativity);
+	if (!context->inputParameter->isConstraintApplied)
+		dataExplorer.boundTarget = context->inputParameter->optimizationTarget;	/* Only the target is printed, bound the others away */
+	else
+		dataExplorer.boundTarget = full_exploration;
+	dataFrontier.Clear();
+	for (int i = 0; i < (int)full_exploration; i++)
+		dataTopK[i].Initialize(context->inputParameter->topK);
+	dataExplorer.topK = context->inputParameter->topK > 1 ? dataTopK : NULL;
+}
+
+void Simulator::Finish(ThreadPool *pool, ostream *outputFile) {
+	if (numSolution > 0) {
+		WireRefiner dataRefiner;
+		dataRefiner.Initialize(context, dataSpace, data);
+		dataRefiner.refineTarget = dataExplorer.boundTarget;
+		if (context->inputParameter->optimizationTarget == full_exploration && !context->inputParameter->isPruningEnabled) {
+			Result *tagResults = context->inputParameter->designTarget == cache ? bestTagResults : NULL;
+			dataRefiner.RefineLocalWire(pool, bestDataResults, outputFile, tagResults);
+			dataRefiner.RefineGlobalWire(pool, bestDataResults, outputFile, tagResults);
+		} else {
+			dataRefiner.RefineLocalWire(pool, bestDataResults, NULL, NULL);
+			dataRefiner.RefineGlobalWire(pool, bestDataResults, NULL, NULL);
+		}
+		if (dataExplorer.topK && outputFile)
+			WriteTopK(pool, *outputFile);
+	}
+
+	if (context->inputParameter->optimizationTarget == full_exploration && context->inputParameter->isPruningEnabled) {
+		/* pruning is enabled */
+		Result **** pruningResults;
+		/* pruningResults[x][y][z] points to the result which is optimized for x, with constraint on y with z overhead */
+		pruningResults = new Result***[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
+		for (int i = 0; i < (int)full_exploration; i++) {
+			pruningResults[i] = new Result**[(int)full_exploration];
+			for (int j = 0; j < (int)full_exploration; j++) {
+				pruningResults[i][j] = new Result*[3];		/* 10%, 20%, and 30% overhead */
+				for (int k = 0; k < 3; k++) {
+					pruningResults[i][j][k] = new Result;
+					pruningResults[i][j][k]->Initialize(context);
+				}
+			}
+		}
+
+		/* assign the constraints */
+		for (int i = 0; i < (int)full_exploration; i++)
+			for (int j = 0; j < (int)full_exploration; j++)
+				for (int k = 0; k < 3; k++) {
+					pruningResults[i][j][k]->optimizationTarget = (OptimizationTarget)i;
+					pruningResults[i][j][k]->limitHeight = bestDataResults[i].limitHeight;
+					pruningResults[i][j][k]->limitWidth = bestDataResults[i].limitWidth;
+					pruningResults[i][j][k]->limitAspectRatio = bestDataResults[i].limitAspectRatio;
+					switch ((OptimizationTarget)j) {
+					case read_latency_optimized:
+						pruningResults[i][j][k]->limitReadLatency = bestDataResults[j].record.readLatency * (1 + (k + 1.0) / 10);
+						break;
+					case write_latency_optimized:
+						pruningResults[i][j][k]->limitWriteLatency = bestDataResults[j].record.writeLatency * (1 + (k + 1.0) / 10);
+						break;
+					case read_energy_optimized:
+						pruningResults[i][j][k]->limitReadDynamicEnergy = bestDataResults[j].record.readDynamicEnergy * (1 + (k + 1.0) / 10);
+						break;
+					case write_energy_optimized:
+						pruningResults[i][j][k]->limitWriteDynamicEnergy = bestDataResults[j].record.writeDynamicEnergy * (1 + (k + 1.0) / 10);
+						break;
+					case read_edp_optimized:
+						pruningResults[i][j][k]->limitReadEdp = bestDataResults[j].record.readLatency * bestDataResults[j].record.readDynamicEnergy * (1 + (k + 1.0) / 10);
+						break;
+					case write_edp_optimized:
+						pruningResults[i][j][k]->limitWriteEdp = bestDataResults[j].record.writeLatency * bestDataResults[j].record.writeDynamicEnergy * (1 + (k + 1.0) / 10);
+						break;
+					case area_optimized:
+						pruningResults[i][j][k]->limitArea = bestDataResults[j].record.area * (1 + (k + 1.0) / 10);
+						break;
+					case leakage_optimized:
+						pruningResults[i][j][k]->limitLeakage = bestDataResults[j].record.leakage * (1 + (k + 1.0) / 10);
+						break;
+					default:
+						/* nothing should happen here */
+						cout << "Warning: should not happen" << endl;
+					}
+				}
+
+		for (int i = 0; i < (int)full_exploration; i++) {
+			if (context->inputParameter->designTarget == cache) {
+				bestDataResults[i].printAsCacheToCsvFile(bestTagResults[i], context->inputParameter->cacheAccessMode, *outputFile);
+			} else {
+				bestDataResults[i].printToCsvFile(*outputFile);
+				*outputFile << endl;
+			}
+		}
+
+		/* Every constrained optimum is on the Pareto frontier of the exploration, which used the basic wires.
+		 * Only the winners are built again, each distinct design is written once */
+		INITIAL_BASIC_WIRE(dataSpace);
+		Result tempResult;
+		tempResult.Initialize(context);
+		set<long long> prunedDesign;
+		for (int i = 0; i < (int)full_exploration; i++)
+			for (int j = 0; j < (int)full_exploration; j++)
+				for (int k = 0; k < 3; k++) {
+					const ParetoPoint *point = dataFrontier.FindBest(*pruningResults[i][j][k]);
+					if (point == NULL)
+						continue;
+					dataExplorer.Materialize(*point, &tempResult);
+					pruningResults[i][j][k]->compareAndUpdate(tempResult);
+					if (pruningResults[i][j][k]->sequence < 0 || !prunedDesign.insert(point->sequence).second)
+						continue;
+					if (context->inputParameter->designTarget == cache) {
+						pruningResults[i][j][k]->printAsCacheToCsvFile(bestTagResults[i], context->inputParameter->cacheAccessMode, *outputFile);
+					} else {
+						pruningResults[i][j][k]->printToCsvFile(*outputFile);
+						*outputFile << endl;
+					}
+				}
+		if (verbose)
+			cout << "Pruning done: " << dataFrontier.numPoint << " designs on the Pareto frontier, "
+					<< prunedDesign.size() << " of them are constrained optima" << endl;
+
+		/* delete */
+		for (int i = 0; i < (int)full_exploration; i++) {
+			for (int j = 0; j < (int)full_exploration; j++) {
+				for (int k = 0; k < 3; k++)
+					delete pruningResults[i][j][k];
+				delete [] pruningResults[i][j];
+			}
+			delete [] pruningResults[i];
+		}
+	}
+
+	/* If design constraint is applied */
+	if (context->inputParameter->optimizationTarget != full_exploration && context->inputParameter->isConstraintApplied) {
+		double allowedDataReadLatency = bestDataResults[read_latency_optimized].record.readLatency * (context->inputParameter->readLatencyConstraint + 1);
+		double allowedDataWriteLatency = bestDataResults[write_latency_optimized].record.writeLatency * (context->inputParameter->writeLatencyConstraint + 1);
+		double allowedDataReadDynamicEnergy = bestDataResults[read_energy_optimized].record.readDynamicEnergy * (context->inputParameter->readDynamicEnergyConstraint + 1);
+		double allowedDataWriteDynamicEnergy = bestDataResults[write_energy_optimized].record.writeDynamicEnergy * (context->inputParameter->writeDynamicEnergyConstraint + 1);
+		double allowedDataLeakage = bestDataResults[leakage_optimized].record.leakage * (context->inputParameter->leakageConstraint + 1);
+		double allowedDataArea = bestDataResults[area_optimized].record.area * (context->inputParameter->areaConstraint + 1);
+		double allowedDataReadEdp = bestDataResults[read_edp_optimized].record.readLatency
+				* bestDataResults[read_edp_optimized].record.readDynamicEnergy * (context->inputParameter->readEdpConstraint + 1);
+		double allowedDataWriteEdp = bestDataResults[write_edp_optimized].record.writeLatency
+				* bestDataResults[write_edp_optimized].record.writeDynamicEnergy * (context->inputParameter->writeEdpConstraint + 1);
+		for (int i = 0; i < (int)full_exploration; i++) {
+			APPLY_LIMIT(bestDataResults[i]);
+		}
+
+		/* The constrained optimum is on the Pareto frontier of the first pass, which used the same basic wires,
+		 * so there is no need to sweep again. The limits are the same in every bestDataResults[i] */
+		INITIAL_BASIC_WIRE(dataSpace);
+		numSolution = dataFrontier.CountFeasible(bestDataResults[0]);
+		Result tempResult;
+		tempResult.Initialize(context);
+		for (int i = 0; i < (int)full_exploration; i++) {
+			const ParetoPoint *point = dataFrontier.FindBest(bestDataResults[i]);
+			if (point) {
+				dataExplorer.Materialize(*point, &tempResult);
+				bestDataResults[i].compareAndUpdate(tempResult);
+			}
+		}
+	}
+
+}
+
+void Simulator::WriteTopK(ThreadPool *pool, ostream &outputFile) {
+	/* The designs were ranked with the basic wires, and each of them gets the wires the refinement
+	 * would give it as the best design. The rows keep the rank, so the first one is the reported design */
+	OptimizationTarget target = context->inputParameter->optimizationTarget;
+	vector<TopKPoint> points;
+	dataTopK[target].GetPoints(points);
+	WireRefiner refiner;
+	refiner.Initialize(context, dataSpace, data);
+	refiner.refineTarget = target;
+	Result results[(int)full_exploration];
+	for (int i = 0; i < (int)full_exploration; i++) {
+		results[i].Initialize(context);
+		results[i].optimizationTarget = (OptimizationTarget)i;
+	}
+	/* The wires are refined under the same floorplan limits as the best design */
+	results[target].limitHeight = bestDataResults[target].limitHeight;
+	results[target].limitWidth = bestDataResults[target].limitWidth;
+	results[target].limitAspectRatio = bestDataResults[target].limitAspectRatio;
+	numTopK = 0;
+	for (int i = 0; i < (int)points.size(); i++) {
+		INITIAL_BASIC_WIRE(dataSpace);
+		results[target].reset();
+		dataExplorer.Evaluate(points[i].design, &results[target]);
+		results[target].sequence = points[i].sequence;
+		refiner.RefineLocalWire(pool, results, NULL, NULL);
+		refiner.RefineGlobalWire(pool, results, NULL, NULL);
+		if (!results[target].checkShape(results[target].record.height, results[target].record.width))
+			continue;
+		numTopK++;
+		if (context->inputParameter->designTarget == cache) {
+			results[target].printAsCacheToCsvFile(bestTagResults[target], context->inputParameter->cacheAccessMode, outputFile);
+		} else {
+			results[target].printToCsvFile(outputFile);
+			outputFile << endl;
+		}
+	}
+	INITIAL_BASIC_WIRE(dataSpace);
+}
+
+string Simulator::ShardKey() {
+	return ResultCache::Hash(ResultCache::Key(loadedParameter, *context->cell));
+}
+
+void Simulator::WriteShard(ostream &shardFile) {
+	shardFile << setprecision(17);	/* The objectives are read back exactly */
+	shardFile << "Solution " << numSolution << endl;
+	for (int i = 0; i < (int)full_exploration; i++) {
+		if (bestDataResults[i].sequence < 0)
+			continue;
+		shardFile << "Best " << i << " " << bestDataResults[i].sequence;
+		WriteDesign(shardFile, bestDataResults[i].record.design);
+		shardFile << endl;
+	}
+	vector<ParetoPoint> points;
+	dataFrontier.GetPoints(points);
+	for (int i = 0; i < (int)points.size(); i++) {
+		shardFile << "Point " << points[i].sequence;
+		WriteDesign(shardFile, points[i].design);
+		for (int j = 0; j < (int)num_objective; j++)
+			shardFile << " " << points[i].objective[j];
+		shardFile << endl;
+	}
+	shardFile << "End" << endl;
+}
+
+bool Simulator::ReadShards(vector<istream *> &shardFiles, ostream *outputFile) {
+	/* The rows of an exploration come first. Work item k is in shard k % numShard, so the rows
+	 * are merged in the serial order by always taking the smallest pending item */
+	vector<string> line(numShard);
+	vector<long> item(numShard), size(numShard);
+	for (int s = 0; s < numShard; s++) {
+		getline(*shardFiles[s], line[s]);
+		item[s] = ParseItem(line[s], &size[s]);
+	}
+	while (true) {
+		int next = -1;
+		for (int s = 0; s < numShard; s++)
+			if (item[s] >= 0 && (next < 0 || item[s] < item[next]))
+				next = s;
+		if (next < 0)
+			break;
+		string rows(size[next], '\0');
+		shardFiles[next]->read(&rows[0], size[next]);
+		if (outputFile)
+			*outputFile << rows;
+		getline(*shardFiles[next], line[next]);
+		item[next] = ParseItem(line[next], &size[next]);
+	}
+
+	/* Then the best designs and the frontier of each shard, built and merged as the workers of one run are */
+	Result tempResult;
+	tempResult.Initialize(context);
+	for (int s = 0; s < numShard; s++) {
+		bool complete = false;
+		do {
+			istringstream fields(line[s]);
+			string tag;
+			fields >> tag;
+			if (tag == "Solution") {
+				long long numShardSolution;
+				fields >> numShardSolution;
+				numSolution += numShardSolution;
+			} else if (tag == "Best") {
+				int target = -1;
+				ParetoPoint point;
+				fields >> target >> point.sequence;
+				ReadDesign(fields, &point.design);
+				if (target < 0 || target >= (int)full_exploration)
+					break;
+				dataExplorer.Materialize(point, &tempResult);
+				bestDataResults[target].compareAndUpdate(tempResult);
+			} else if (tag == "Point") {
+				ParetoPoint point;
+				fields >> point.sequence;
+				ReadDesign(fields, &point.design);
+				for (int j = 0; j < (int)num_objective; j++)
+					fields >> point.objective[j];
+				dataFrontier.Insert(point);
+			} else if (tag == "End") {
+				complete = true;
+			} else {
+				break;
+			}
+			if (fields.fail())
+				break;
+		} while (!complete && getline(*shardFiles[s], line[s]));
+		if (!complete) {
+			cout << "[Simulator] Error: The file of shard " << s << " is incomplete!" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+void Simulator::Print() {
+	if (progress && progress->Expired())
+		cout << "The time budget of " << progress->timeBudget << "s expired after " << progress->NumVisited() << " of "
+				<< progress->numPoint << " design points, the designs below are the best of them" << endl << endl;
+
+	if (context->inputParameter->designTarget == cache && numTagSolution == 0) {
+		cout << "No valid solutions for tags." << endl;
+		cout << endl << "Finished!" << endl;
+		return;
+	}
+
+	if (context->inputParameter->optimizationTarget != full_exploration) {
+		if (numSolution > 0) {
+			if (context->inputParameter->designTarget == cache)
+				bestDataResults[context->inputParameter->optimizationTarget].printAsCache(bestTagResults[context->inputParameter->optimizationTarget], context->inputParameter->cacheAccessMode);
+			else
+				bestDataResults[context->inputParameter->optimizationTarget].print();
+			if (context->inputParameter->topK > 1)
+				cout << endl << OutputFileName() << " generated successfully with the " << numTopK
+						<< " best designs!" << endl;
+		} else {
+			cout << "No valid solutions." << endl;
+		}
+		cout << endl << "Finished!" << endl;
+	} else {
+		cout << endl << OutputFileName() << " generated successfully!" << endl;
+		if (context->inputParameter->isPruningEnabled) {
+			cout << "The results are pruned" << endl;
+		} else {
+			int solutionMultiplier = 1;
+			if (context->inputParameter->designTarget == cache)
+				solutionMultiplier = 8;
+			cout << numSolution * solutionMultiplier << " solutions in total" << endl;
+		}
+	}
+}
+
+void Simulator::PrintToCsvFile(ostream &outputFile) {
+	OptimizationTarget target = context->inputParameter->optimizationTarget;
+	if ((context->inputParameter->designTarget == cache && numTagSolution == 0) || numSolution == 0) {
+		outputFile << "No Solution,0" << endl;
+	} else if (target == full_exploration) {
+		int solutionMultiplier = 1;
+		if (context->inputParameter->designTarget == cache && !context->inputParameter->isPruningEnabled)
+			solutionMultiplier = 8;
+		outputFile << "Explored," << numSolution * solutionMultiplier << "," << OutputFileName() << endl;
+	} else {
+		/* A bounded search only counts the designs that beat the incumbent of their thread, so the count
+		 * depends on the number of threads and is left out */
+		outputFile << "Solved,";
+		if (dataExplorer.boundTarget == full_exploration)
+			outputFile << numSolution;
+		outputFile << ",";
+		if (context->inputParameter->designTarget == cache) {
+			bestDataResults[target].printAsCacheToCsvFile(bestTagResults[target], context->inputParameter->cacheAccessMode, outputFile);
+		} else {
+			bestDataResults[target].printToCsvFile(outputFile);
+			outputFile << endl;
+		}
+	}
+}
+
+void Simulator::GetDataBankSize(long long *_capacity, long *_blockSize, int *_associativity) {
+	/* adjust cache data array parameters according to the access mode */
+	*_capacity = (long long)context->inputParameter->capacity * 8;
+	*_blockSize = context->inputParameter->wordWidth;
+	*_associativity = context->inputParameter->associativity;
+	if (context->inputParameter->designTarget == cache) {
+		switch (context->inputParameter->cacheAccessMode) {
+		case sequential_access_mode:
+			/* already knows which way to access */
+			*_associativity = 1;
+			break;
+		case fast_access_mode:
+			/* load the entire set as a single word */
+			*_blockSize *= *_associativity;
+			*_associativity = 1;
+			break;
+		default:	/* Normal, see Run() for the rows per set */
+			break;
+		}
+	}
+
+	/* adjust block size is it is SLC NAND flash or DRAM memory chip */
+	if (context->inputParameter->designTarget == RAM_chip && (context->cell->memCellType == SLCNAND || context->cell->memCellType == DRAM)) {
+		*_blockSize = context->inputParameter->pageSize;
+		*_associativity = 1;
+	}
+}
+
+bool Simulator::Evaluate(const DesignPoint &_design, Result *_result) {
+	if (!initialized) {
+		cout << "[Simulator] Error: Require initialization first!" << endl;
+		return false;
+	}
+
+	/* The rules of BIGFOR that the bank does not check itself */
+	int dimension[] = {_design.numRowMat, _design.numColumnMat, _design.numActiveMatPerRow, _design.numActiveMatPerColumn,
+			_design.numRowSubarray, _design.numColumnSubarray, _design.numActiveSubarrayPerRow, _design.numActiveSubarrayPerColumn,
+			_design.muxSenseAmp, _design.muxOutputLev1, _design.muxOutputLev2, _design.numRowPerSet};
+	for (int i = 0; i < (int)(sizeof(dimension) / sizeof(int)); i++)
+		if (dimension[i] <= 0 || !isPow2(dimension[i]))
+			return false;
+	if (_design.numActiveMatPerRow > _design.numColumnMat || _design.numActiveMatPerColumn > _design.numRowMat
+			|| _design.numActiveSubarrayPerRow > _design.numColumnSubarray || _design.numActiveSubarrayPerColumn > _design.numRowSubarray)
+		return false;
+	if (_design.numRowPerSet > context->inputParameter->associativity)
+		return false;
+	if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode == normal_access_mode
+			&& _design.numRowPerSet > 1)
+		return false;
+	if (_design.areaOptimizationLevel < (int)latency_first || _design.areaOptimizationLevel > (int)area_first)
+		return false;
+
+	long long capacity;
+	long blockSize;
+	int associativity;
+	GetDataBankSize(&capacity, &blockSize, &associativity);
+	Explorer explorer;
+	explorer.Initialize(context, context->inputParameter->searchSpace, data, capacity, blockSize, associativity);
+	return explorer.Evaluate(_design, _result);
+}
+
+string Simulator::OutputFileName() {
+	stringstream temp;
+	temp << context->inputParameter->outputFilePrefix << "_" << context->inputParameter->capacity / 1024 << "K_" << context->inputParameter->wordWidth
+			<< "_" << context->inputParameter->associativity;
+	if (context->inputParameter->internalSensing)
+		temp << "_IN";
+	else
+		temp << "_EX";
+	if (context->cell->readMode)
+		temp << "_VOL";
+	else
+		temp << "_CUR";
+	temp << ".csv";
+	return temp.str();
+}
+
+bool Simulator::ApplyConstraint() {
+	/* Check functions that are not yet implemented */
+	if (context->inputParameter->designTarget == CAM_chip) {
+		cout << "[ERROR] CAM model is still under development" << endl;
+		return false;
+	}
+	if (context->cell->memCellType == DRAM) {
+		cout << "[ERROR] DRAM model is still under development" << endl;
+		return false;
+	}
+	if (context->cell->memCellType == eDRAM) {
+		cout << "[Warning] Embedded DRAM model is still under development" << endl;
+		//return false;
+	}
+	if (context->cell->memCellType == MLCNAND) {
+		cout << "[ERROR] MLC NAND flash model is still under development" << endl;
+		return false;
+	}
+
+	if (context->inputParameter->designTarget != cache && context->inputParameter->associativity > 1) {
+		cout << "[WARNING] Associativity setting is ignored for non-cache designs" << endl;
+		context->inputParameter->associativity = 1;
+	}
+
+	if (!isPow2(context->inputParameter->associativity)) {
+		cout << "[ERROR] The associativity value has to be a power of 2 in this version" << endl;
+		return false;
+	}
+
+	if (context->inputParameter->routingMode == h_tree && context->inputParameter->internalSensing == false) {
+		cout << "[ERROR] H-tree does not support external sensing scheme in this version" << endl;
+		return false;
+	}
+/*
+	if (context->inputParameter->globalWireRepeaterType != repeated_none && context->inputParameter->internalSensing == false) {
+		cout << "[ERROR] Repeated global wire does not support external sensing scheme" << endl;
+		return false;
+	}
+*/
+
+	if (context->inputParameter->topK < 1) {
+		cout << "[ERROR] The number of the best designs to write has to be at least 1" << endl;
+		return false;
+	}
+	if (context->inputParameter->topK > 1 && (context->inputParameter->optimizationTarget == full_exploration || context->inputParameter->isConstraintApplied)) {
+		cout << "[ERROR] The best designs can only be written for an optimization target without constraints" << endl;
+		return false;
+	}
+	if (context->inputParameter->maxBankHeight <= 0 || context->inputParameter->maxBankWidth <= 0) {
+		cout << "[ERROR] The maximum height and width of the bank have to be positive" << endl;
+		return false;
+	}
+	if (context->inputParameter->maxAspectRatio < 1) {
+		cout << "[ERROR] The maximum aspect ratio is the longer side over the shorter one, it cannot be below 1" << endl;
+		return false;
+	}
+
+	/* TO-DO: more rules to add here */
+	return true;
+}
+
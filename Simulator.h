@@ -0,0 +1,113 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Result.h"
+#include "InputParameter.h"
+#include "ParetoFrontier.h"
+#include "SearchSpace.h"
+#include "Progress.h"
+#include "Explorer.h"
+#include "TopKCollector.h"
+#include "ThreadPool.h"
+#include "SimulationContext.h"
+#include "typedef.h"
+
+using namespace std;
+
+/* One run of NVSim on a loaded context: the tag and data explorations, the wire
+ * refinement, the pruning or the constraints of the configuration, and the report */
+class Simulator {
+public:
+	Simulator();
+	virtual ~Simulator();
+
+	/* Functions */
+	void Initialize(SimulationContext *_context);
+	bool Run(ThreadPool *pool, ostream *outputFile);	/* False if the configuration is not supported. outputFile
+														receives the CSV of an exploration and is required for it */
+	bool Merge(ThreadPool *pool, vector<istream *> &shardFiles, ostream *outputFile);	/* Finish the run from the files of
+														all the shards instead of exploring, as Run() would */
+	void Print();		/* The report of the run */
+	void PrintToCsvFile(ostream &outputFile);	/* The outcome of the run as a single CSV record */
+	string OutputFileName();	/* The CSV file an exploration is appended to */
+	bool ApplyConstraint();		/* Check and adjust the configuration, false if it is not supported */
+	void GetDataBankSize(long long *_capacity, long *_blockSize, int *_associativity);	/* The data bank of the configuration */
+	bool Evaluate(const DesignPoint &_design, Result *_result);	/* Build one data design with the current wires of the context,
+															false if it is not valid. Requires ApplyConstraint() first */
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	bool verbose;		/* Print the cell, the configuration and the pruning summary during the run */
+	SimulationContext *context;
+	InputParameter loadedParameter;	/* The configuration as loaded */
+	Result bestDataResults[(int)full_exploration];	/* for cache data array, memory array */
+	Result bestTagResults[(int)full_exploration];	/* for cache tag array only */
+	long long numSolution;		/* Number of valid data designs */
+	long long numTagSolution;	/* Number of valid tag designs, for cache only */
+	int numTopK;		/* Number of the best designs written by WriteTopK(), the others do not fit the floorplan limits */
+	int numShard;		/* If it is not 0, Run() only explores the data work items of shard shardIndex and writes */
+	int shardIndex;		/* a shard file to outputFile instead: its exploration rows, best designs and frontier */
+	Progress *progress;	/* Tracks the explorations of Run() and bounds them if it has a time budget, NULL if not tracked */
+
+private:
+	bool Prepare();		/* Check the configuration and set up the tag explorer, false if it is not supported */
+	void ExploreTag(ThreadPool *pool);	/* The tag exploration on its own, before the data */
+	void RefineTag(ThreadPool *pool);	/* The wire refinement of the tags */
+	void PrepareData();		/* The data explorer, the basic wires and the data search space */
+	void Finish(ThreadPool *pool, ostream *outputFile);	/* The wire refinement, the pruning and the constraints */
+	void WriteTopK(ThreadPool *pool, ostream &outputFile);	/* The k best data designs of the target, each refined as the best one is */
+	string ShardKey();		/* Identifies the configuration, the cell and the model version */
+	void WriteShard(ostream &shardFile);
+	bool ReadShards(vector<istream *> &shardFiles, ostream *outputFile);
+
+	SearchSpace dataSpace;		/* The search space of the configuration, as the data array is explored */
+	SearchSpace tagSpace;		/* The reduced search space of the tags */
+	InputParameter tagParameter;	/* The configuration of the tags */
+	SimulationContext tagContext;	/* Shares the models of context, with tagParameter and its own wires */
+	Explorer tagExplorer;
+	Explorer dataExplorer;
+	ParetoFrontier dataFrontier;	/* Only kept when the exploration is pruned or constrained */
+	TopKCollector dataTopK[(int)full_exploration];	/* Only filled when more than the best design is written */
+};
+
+#endif /* SIMULATOR_H_ */
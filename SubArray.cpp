@@ -37,7 +37,8 @@
 
 #include "SubArray.h"
 #include "formula.h"
-#include "global.h"
+#include "SimulationContext.h"
+#include "macros.h"
 #include "constant.h"
 #include <math.h>
 
@@ -45,15 +46,18 @@ SubArray::SubArray() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
 	invalid = false;
+	invalidScope = design_scope;
 }
 
 SubArray::~SubArray() {
 	// TODO Auto-generated destructor stub
 }
 
-void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
+void SubArray::Initialize(SimulationContext *_context, long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
 		int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 		BufferDesignTarget _areaOptimizationLevel) {
+	context = _context;
+	PROFILE_STAGE(subarray_profile, initialize_stage);
 	if (initialized)
 		cout << "[Subarray] Warning: Already initialized!" << endl;
 
@@ -70,72 +74,86 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 	double maxWordlineCurrent = 0;
 	double maxBitlineCurrent = 0;
 
-	/* Check if the configuration is legal */
-	if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode != sequential_access_mode) {
+	/* Check if the configuration is legal, the area optimization level is not used until the decoders */
+	if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode != sequential_access_mode) {
 		/* In these cases, each column should hold part of data in all the ways */
-		if (numColumn < inputParameter->associativity) {
+		if (numColumn < context->inputParameter->associativity) {
 			invalid = true;
+			invalidScope = area_level_scope;
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
 	}
 
-	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+	if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 		if (muxSenseAmp > 1) {
 			/* DRAM does not allow muxed bitline because of its destructive readout */
 			invalid = true;
+			invalidScope = organization_scope;	/* the mux degree before the sense amp only grows in the exploration */
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
 	}
 
-	if (cell->memCellType == SLCNAND) {
-		if (numRow < inputParameter->flashBlockSize / inputParameter->pageSize) {
+	if (context->cell->memCellType == SLCNAND) {
+		if (numRow < context->inputParameter->flashBlockSize / context->inputParameter->pageSize) {
 			/* SLC NAND does not have enough rows to hold the page count */
 			invalid = true;
+			invalidScope = mux_scope;	/* numRow is smaller with a larger mux */
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
 		if (internalSenseAmp && muxSenseAmp < 2) {
 			/* There is no way to put the sense amp */
 			invalid = true;
+			invalidScope = area_level_scope;
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
 	}
 
-	if (cell->memCellType == memristor || cell->memCellType == FBRAM) {
+	if (context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
 		if (internalSenseAmp && muxSenseAmp < 2) {
 			/* There is no way to put the sense amp */
 			invalid = true;
+			invalidScope = area_level_scope;
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
 	}
 
-	if (cell->memCellType == FBRAM) {
-		if (cell->resistanceOff / cell->resistanceOn < numRow / BITLINE_LEAKAGE_TOLERANCE) {
+	if (context->cell->memCellType == FBRAM) {
+		if (context->cell->resistanceOff / context->cell->resistanceOn < numRow / BITLINE_LEAKAGE_TOLERANCE) {
 			/* bitline too long */
 			invalid = true;
+			invalidScope = area_level_scope;
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
-		maxBitlineCurrent = MAX(cell->resetCurrent, cell->setCurrent) + cell->leakageCurrentAccessDevice * (numRow - 1);
+		maxBitlineCurrent = MAX(context->cell->resetCurrent, context->cell->setCurrent) + context->cell->leakageCurrentAccessDevice * (numRow - 1);
 	}
 
-	if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor) {
-		if (cell->accessType == CMOS_access){
-			if (tech->currentOnNmos[inputParameter->temperature - 300]
-									/ tech->currentOffNmos[inputParameter->temperature - 300] < numRow / BITLINE_LEAKAGE_TOLERANCE) {
+	if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor) {
+		if (context->cell->accessType == CMOS_access){
+			if (context->techView.currentOnNmos
+									/ context->techView.currentOffNmos < numRow / BITLINE_LEAKAGE_TOLERANCE) {
 				/* bitline too long */
 				invalid = true;
+				invalidScope = area_level_scope;
+				PROFILE_EVENT(invalid_subarray_event);
 				initialized = true;
 				return;
 			}
-			maxBitlineCurrent = MAX(cell->resetCurrent, cell->setCurrent) + cell->leakageCurrentAccessDevice * (numRow - 1);
+			maxBitlineCurrent = MAX(context->cell->resetCurrent, context->cell->setCurrent) + context->cell->leakageCurrentAccessDevice * (numRow - 1);
 		} else { //non-CMOS access
-		//	if (!cell->readFloating) { // conventional half select read scheme
-		//		if ((2 * cell->resistanceOnAtHalfReadVoltage / (numRow - 1)) < (cell->resistanceOffAtReadVoltage / BITLINE_LEAKAGE_TOLERANCE)){
+		//	if (!context->cell->readFloating) { // conventional half select read scheme
+		//		if ((2 * context->cell->resistanceOnAtHalfReadVoltage / (numRow - 1)) < (context->cell->resistanceOffAtReadVoltage / BITLINE_LEAKAGE_TOLERANCE)){
 		//			/* bitline too long */
 		//			invalid = true;
 		//			initialized = true;
@@ -145,8 +163,8 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		//		double r, c; // number of rows and columns in a memristor array of which wordline voltage is to be calculated
 		//		r = numRow;
 		//		c = numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-		//		double equResistanceOn = cell->GetMemristance((c - 1) / (r + c - 1)); //Solved Wordline Voltage is (c-1)/(r+c-1) * Vread
-		//		if (((c - 1) / (r + c - 1) * equResistanceOn / (numRow - 1)) < (cell->resistanceOffAtReadVoltage / BITLINE_LEAKAGE_TOLERANCE)){
+		//		double equResistanceOn = context->cell->GetMemristance((c - 1) / (r + c - 1)); //Solved Wordline Voltage is (c-1)/(r+c-1) * Vread
+		//		if (((c - 1) / (r + c - 1) * equResistanceOn / (numRow - 1)) < (context->cell->resistanceOffAtReadVoltage / BITLINE_LEAKAGE_TOLERANCE)){
 		//			/* bitline too long */
 		//			invalid = true;
 		//			initialized = true;
@@ -155,272 +173,298 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 		//	}
 			/* Write half select problem limit the array size */
 			double resetCurrent;
-			if (cell->resetCurrent == 0) {
-				resetCurrent = (fabs (cell->resetVoltage) - cell->voltageDropAccessDevice) / cell->resistanceOnAtResetVoltage;
+			if (context->cell->resetCurrent == 0) {
+				resetCurrent = (fabs (context->cell->resetVoltage) - context->cell->voltageDropAccessDevice) / context->cell->resistanceOnAtResetVoltage;
 			} else
-				resetCurrent = cell->resetCurrent;
+				resetCurrent = context->cell->resetCurrent;
 			int numSelectedColumnPerRow = numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-			if (cell->accessType == none_access) {
-				maxWordlineCurrent = resetCurrent * numSelectedColumnPerRow + resetCurrent * cell->resistanceOnAtResetVoltage
-						/ 2 / cell->resistanceOnAtHalfResetVoltage * (numColumn - numSelectedColumnPerRow);
+			if (context->cell->accessType == none_access) {
+				maxWordlineCurrent = resetCurrent * numSelectedColumnPerRow + resetCurrent * context->cell->resistanceOnAtResetVoltage
+						/ 2 / context->cell->resistanceOnAtHalfResetVoltage * (numColumn - numSelectedColumnPerRow);
 			} else { //diode or BJT
-				maxWordlineCurrent = resetCurrent * numSelectedColumnPerRow + cell->leakageCurrentAccessDevice
+				maxWordlineCurrent = resetCurrent * numSelectedColumnPerRow + context->cell->leakageCurrentAccessDevice
 						* (numColumn - numSelectedColumnPerRow);
 			}
-			double minWordlineDriverWidth = maxWordlineCurrent / tech->currentOnNmos[inputParameter->temperature - 300];
-			if (minWordlineDriverWidth > inputParameter->maxNmosSize * tech->featureSize) {
+			double minWordlineDriverWidth = maxWordlineCurrent / context->techView.currentOnNmos;
+			if (minWordlineDriverWidth > context->inputParameter->maxNmosSize * context->tech->featureSize) {
 				invalid = true;
+				invalidScope = mux_scope;	/* numColumn is larger with a larger mux */
+				PROFILE_EVENT(invalid_subarray_event);
 				return;
 			}
-			if (cell->accessType == none_access) {
-				maxBitlineCurrent = resetCurrent + resetCurrent * cell->resistanceOnAtResetVoltage / 2
-						/ cell->resistanceOnAtHalfResetVoltage * (numRow - 1);
+			if (context->cell->accessType == none_access) {
+				maxBitlineCurrent = resetCurrent + resetCurrent * context->cell->resistanceOnAtResetVoltage / 2
+						/ context->cell->resistanceOnAtHalfResetVoltage * (numRow - 1);
 			} else { //diode or BJT
-				maxBitlineCurrent = resetCurrent + cell->leakageCurrentAccessDevice * (numRow - 1);
+				maxBitlineCurrent = resetCurrent + context->cell->leakageCurrentAccessDevice * (numRow - 1);
 			}
 		}
 	}
 
-	double minBitlineMuxWidth = maxBitlineCurrent / tech->currentOnNmos[inputParameter->temperature - 300];
-	minBitlineMuxWidth = MAX(MIN_NMOS_SIZE * tech->featureSize, minBitlineMuxWidth);
-	if (minBitlineMuxWidth > inputParameter->maxNmosSize * tech->featureSize) {
+	double minBitlineMuxWidth = maxBitlineCurrent / context->techView.currentOnNmos;
+	minBitlineMuxWidth = MAX(MIN_NMOS_SIZE * context->tech->featureSize, minBitlineMuxWidth);
+	if (minBitlineMuxWidth > context->inputParameter->maxNmosSize * context->tech->featureSize) {
 		invalid = true;
+		invalidScope = area_level_scope;
+		PROFILE_EVENT(invalid_subarray_event);
 		return;
 	}
 
 	if (internalSenseAmp) {
-		if (cell->memCellType == SRAM || cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		if (context->cell->memCellType == SRAM || context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 			/* SRAM, DRAM, and eDRAM all use voltage sensing */
 			voltageSense = true;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-			voltageSense = cell->readMode;
+		} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
+			voltageSense = context->cell->readMode;
 		} else {/* NAND flash */
 			voltageSense = true;
 		}
-	} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
-		cout << "[Subarray] Error: DRAM does not support external sense amplifiers!" << endl;
-		exit(-1);
+	} else if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
+		/* DRAM does not support external sense amplifiers, SimulationContext rejects the configuration */
+		invalid = true;
+		invalidScope = organization_scope;
+		PROFILE_EVENT(invalid_subarray_event);
+		return;
 	}
 
-	if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
-		senseVoltage = tech->vdd / 2 * cell->capDRAMCell / (cell->capDRAMCell + capBitline);
-		if (senseVoltage < cell->minSenseVoltage) {		/* Bitline is too long */
+	if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
+		senseVoltage = context->tech->vdd / 2 * context->cell->capDRAMCell / (context->cell->capDRAMCell + capBitline);
+		if (senseVoltage < context->cell->minSenseVoltage) {		/* Bitline is too long */
 			invalid = true;
+			PROFILE_EVENT(invalid_subarray_event);
 			initialized = true;
 			return;
 		}
-	} else if (cell->memCellType == SLCNAND){
+	} else if (context->cell->memCellType == SLCNAND){
 		/* suppose the reference voltage is 0.5Vdd, the initial bitline voltage is 0.6Vdd
 		 * if the bitline drops to 0.4Vdd, the senseamp can tell which data is stored */
-		senseVoltage = MAX(cell->minSenseVoltage, 0.2 * tech->vdd);
+		senseVoltage = MAX(context->cell->minSenseVoltage, 0.2 * context->tech->vdd);
 	} else {
 		/* TO-DO: different memory technology might have different values here */
-		senseVoltage = cell->minSenseVoltage;
+		senseVoltage = context->cell->minSenseVoltage;
 	}
 
 	/* Derived parameters */
 	numSenseAmp = numColumn / muxSenseAmp;
-	lenWordline = (double)numColumn * cell->widthInFeatureSize * tech->featureSize;
-	lenBitline = (double)numRow * cell->heightInFeatureSize * tech->featureSize;
+	lenWordline = (double)numColumn * context->cell->widthInFeatureSize * context->tech->featureSize;
+	lenBitline = (double)numRow * context->cell->heightInFeatureSize * context->tech->featureSize;
 	/* Add stitching overhead if necessary */
-	if (cell->stitching) {
-		lenWordline += ((numColumn - 1) / cell->stitching + 1) * STITCHING_OVERHEAD * tech->featureSize;
+	if (context->cell->stitching) {
+		lenWordline += ((numColumn - 1) / context->cell->stitching + 1) * STITCHING_OVERHEAD * context->tech->featureSize;
 	}
 	/* Add select transistors into the length calculation */
-	if (cell->memCellType == SLCNAND) {
-		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+	if (context->cell->memCellType == SLCNAND) {
+		int pageCount = context->inputParameter->flashBlockSize / context->inputParameter->pageSize;
 		/* Two select transistor including contacts have total length of 5F */
-		lenBitline += (numRow / pageCount) * 5 * tech->featureSize;
+		lenBitline += (numRow / pageCount) * 5 * context->tech->featureSize;
 	}
 	/* Calculate wire resistance/capacitance */
-	capWordline = lenWordline * localWire->capWirePerUnit;
-	resWordline = lenWordline * localWire->resWirePerUnit;
-	capBitline = lenBitline * localWire->capWirePerUnit;
-	resBitline = lenBitline * localWire->resWirePerUnit;
+	capWordline = lenWordline * context->localWire->capWirePerUnit;
+	resWordline = lenWordline * context->localWire->resWirePerUnit;
+	capBitline = lenBitline * context->localWire->capWirePerUnit;
+	resBitline = lenBitline * context->localWire->resWirePerUnit;
 
 	/* Caclulate the load resistance and capacitance for Mux Decoders */
 	double capMuxLoad, resMuxLoad;
         resMuxLoad = resWordline;
-        capMuxLoad = CalculateGateCap(minBitlineMuxWidth, *tech) * numColumn;
+        capMuxLoad = CalculateGateCap(minBitlineMuxWidth, context->techView) * numColumn;
         capMuxLoad += capWordline;
 
 	/* Add transistor resistance/capacitance */
-	if (cell->memCellType == SRAM) {
+	if (context->cell->memCellType == SRAM) {
 		/* SRAM has two access transistors */
-		resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * tech->featureSize, NMOS, inputParameter->temperature, *tech);
-		capCellAccess = CalculateDrainCap(cell->widthAccessCMOS * tech->featureSize, NMOS, cell->widthInFeatureSize * tech->featureSize, *tech);
-		capWordline += 2 * CalculateGateCap(cell->widthAccessCMOS * tech->featureSize, *tech) * numColumn;
+		resCellAccess = CalculateOnResistance(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->techView);
+		capCellAccess = CalculateDrainCap(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->cell->widthInFeatureSize * context->tech->featureSize, context->techView);
+		capWordline += 2 * CalculateGateCap(context->cell->widthAccessCMOS * context->tech->featureSize, context->techView) * numColumn;
 		capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
-		voltagePrecharge = tech->vdd / 2;	/* SRAM read voltage is always half of vdd */
-	} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		voltagePrecharge = context->tech->vdd / 2;	/* SRAM read voltage is always half of vdd */
+	} else if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 		/* DRAM and eDRAM only has one access transistors */
-		resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * tech->featureSize, NMOS, inputParameter->temperature, *tech);
-		capCellAccess = CalculateDrainCap(cell->widthAccessCMOS * tech->featureSize, NMOS, cell->widthInFeatureSize * tech->featureSize, *tech);
-		capWordline += CalculateGateCap(cell->widthAccessCMOS * tech->featureSize, *tech) * numColumn;
+		resCellAccess = CalculateOnResistance(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->techView);
+		capCellAccess = CalculateDrainCap(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->cell->widthInFeatureSize * context->tech->featureSize, context->techView);
+		capWordline += CalculateGateCap(context->cell->widthAccessCMOS * context->tech->featureSize, context->techView) * numColumn;
 		capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
-		voltagePrecharge = tech->vdd / 2;	/* DRAM read voltage is always half of vdd */
-	} else if (cell->memCellType == FBRAM){ /* Floating Body RAM */
+		voltagePrecharge = context->tech->vdd / 2;	/* DRAM read voltage is always half of vdd */
+	} else if (context->cell->memCellType == FBRAM){ /* Floating Body RAM */
 		resCellAccess = 0;
-		capCellAccess = CalculateFBRAMDrainCap(cell->widthSOIDevice * tech->featureSize, *tech);
-		capWordline += CalculateFBRAMGateCap(cell->widthSOIDevice * tech->featureSize, cell->gateOxThicknessFactor, *tech) * numColumn;
+		capCellAccess = CalculateFBRAMDrainCap(context->cell->widthSOIDevice * context->tech->featureSize, context->techView);
+		capWordline += CalculateFBRAMGateCap(context->cell->widthSOIDevice * context->tech->featureSize, context->cell->gateOxThicknessFactor, context->techView) * numColumn;
 		capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
-		resMemCellOff = cell->resistanceOff;
-		resMemCellOn = cell->resistanceOn;
-		if (cell->readMode) {						/* voltage-sensing */
-			if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
-				voltageMemCellOff = cell->readCurrent * resMemCellOff;
-				voltageMemCellOn = cell->readCurrent * resMemCellOn;
+		resMemCellOff = context->cell->resistanceOff;
+		resMemCellOn = context->cell->resistanceOn;
+		if (context->cell->readMode) {						/* voltage-sensing */
+			if (context->cell->readVoltage == 0) {  /* Current-in voltage sensing */
+				voltageMemCellOff = context->cell->readCurrent * resMemCellOff;
+				voltageMemCellOn = context->cell->readCurrent * resMemCellOn;
 				voltagePrecharge = (voltageMemCellOff + voltageMemCellOn) / 2;
-				voltagePrecharge = MIN(tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
+				voltagePrecharge = MIN(context->tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
 				if ((voltagePrecharge - voltageMemCellOn) <= senseVoltage) {
 					cout <<"Error[Subarray]: Read current too large or too small that no reasonable precharge voltage existing" <<endl;
 					invalid = true;
+					invalidScope = organization_scope;	/* depends on the cell only */
+					PROFILE_EVENT(invalid_subarray_event);
 					return;
 				}
 			} else {   /*Voltage-divider sensing */
 				resInSerialForSenseAmp = sqrt(resMemCellOn * resMemCellOff);
 				resEquivalentOn = resMemCellOn * resInSerialForSenseAmp / (resMemCellOn + resInSerialForSenseAmp);
 				resEquivalentOff = resMemCellOff * resInSerialForSenseAmp / (resMemCellOff + resInSerialForSenseAmp);
-				voltageMemCellOff = cell->readVoltage * resMemCellOff / (resMemCellOff + resInSerialForSenseAmp);
-				voltageMemCellOn = cell->readVoltage * resMemCellOn / (resMemCellOn + resInSerialForSenseAmp);
+				voltageMemCellOff = context->cell->readVoltage * resMemCellOff / (resMemCellOff + resInSerialForSenseAmp);
+				voltageMemCellOn = context->cell->readVoltage * resMemCellOn / (resMemCellOn + resInSerialForSenseAmp);
 				voltagePrecharge = (voltageMemCellOff + voltageMemCellOn) / 2;
-				voltagePrecharge = MIN(tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
+				voltagePrecharge = MIN(context->tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
 				if ((voltagePrecharge - voltageMemCellOn) <= senseVoltage) {
 					cout <<"Error[Subarray]: Read Voltage too large or too small that no reasonable precharge voltage existing" <<endl;
 					invalid = true;
+					invalidScope = organization_scope;	/* depends on the cell only */
+					PROFILE_EVENT(invalid_subarray_event);
 					return;
 				}
 			}
 		}
-	} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor) {
+	} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor) {
 		/* MRAM, PCRAM, and memristor have three types of access devices: CMOS, BJT, and diode */
-		if (cell->accessType == CMOS_access) {
-			resCellAccess = CalculateOnResistance(cell->widthAccessCMOS * tech->featureSize, NMOS, inputParameter->temperature, *tech);
-			capCellAccess = CalculateDrainCap(cell->widthAccessCMOS * tech->featureSize, NMOS, cell->widthInFeatureSize * tech->featureSize, *tech);
-			capWordline += CalculateGateCap(cell->widthAccessCMOS * tech->featureSize, *tech) * numColumn;
+		if (context->cell->accessType == CMOS_access) {
+			resCellAccess = CalculateOnResistance(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->techView);
+			capCellAccess = CalculateDrainCap(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->cell->widthInFeatureSize * context->tech->featureSize, context->techView);
+			capWordline += CalculateGateCap(context->cell->widthAccessCMOS * context->tech->featureSize, context->techView) * numColumn;
 			capBitline  += capCellAccess * numRow / 2;	/* Due to shared contact */
-		} else if (cell->accessType == BJT_access) {
+		} else if (context->cell->accessType == BJT_access) {
 			// TO-DO
-	/*	} else if (cell->accessType == diode_access){
-			if (cell->readVoltage == 0) {
-				resCellAccess = cell->voltageDropAccessDevice / cell->readCurrent;
+	/*	} else if (context->cell->accessType == diode_access){
+			if (context->cell->readVoltage == 0) {
+				resCellAccess = context->cell->voltageDropAccessDevice / context->cell->readCurrent;
 			} else {
-				if (cell->readMode == false) {
-					resCellAccess = cell->voltageDropAccessDevice / (cell->readVoltage
-							- cell->voltageDropAccessDevice) * cell->resistanceOn;
+				if (context->cell->readMode == false) {
+					resCellAccess = context->cell->voltageDropAccessDevice / (context->cell->readVoltage
+							- context->cell->voltageDropAccessDevice) * context->cell->resistanceOn;
 				} else {
 					cout<<"Error[Subarray]: Diode access do not support voltage-input voltage sensing" <<endl;
 					exit(-1);
 				}
 			}
-			capCellAccess = MAX(cell->capacitanceOn, cell->capacitanceOff);
-			capWordline += MAX(cell->capacitanceOff, cell->capacitanceOn) * numColumn;
-			capBitline += MAX(cell->capacitanceOff, cell->capacitanceOn) * numRow;      */
+			capCellAccess = MAX(context->cell->capacitanceOn, context->cell->capacitanceOff);
+			capWordline += MAX(context->cell->capacitanceOff, context->cell->capacitanceOn) * numColumn;
+			capBitline += MAX(context->cell->capacitanceOff, context->cell->capacitanceOn) * numRow;      */
 		} else { // none_access || diode_access
 			resCellAccess = 0;
-			capCellAccess = MAX(cell->capacitanceOn, cell->capacitanceOff);
-			capWordline += MAX(cell->capacitanceOff, cell->capacitanceOn) * numColumn;  //TO-DO: choose the right capacitance
-			capBitline += MAX(cell->capacitanceOff, cell->capacitanceOn) * numRow;      //TO-DO: choose the right capacitance
+			capCellAccess = MAX(context->cell->capacitanceOn, context->cell->capacitanceOff);
+			capWordline += MAX(context->cell->capacitanceOff, context->cell->capacitanceOn) * numColumn;  //TO-DO: choose the right capacitance
+			capBitline += MAX(context->cell->capacitanceOff, context->cell->capacitanceOn) * numRow;      //TO-DO: choose the right capacitance
 		}
-		resMemCellOff = resCellAccess + cell->resistanceOff;
-		resMemCellOn = resCellAccess + cell->resistanceOn;
-		if (cell->readMode) {						/* voltage-sensing */
-			if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
-				voltageMemCellOff = cell->readCurrent * resMemCellOff;
-				voltageMemCellOn = cell->readCurrent * resMemCellOn;
+		resMemCellOff = resCellAccess + context->cell->resistanceOff;
+		resMemCellOn = resCellAccess + context->cell->resistanceOn;
+		if (context->cell->readMode) {						/* voltage-sensing */
+			if (context->cell->readVoltage == 0) {  /* Current-in voltage sensing */
+				voltageMemCellOff = context->cell->readCurrent * resMemCellOff;
+				voltageMemCellOn = context->cell->readCurrent * resMemCellOn;
 				voltagePrecharge = (voltageMemCellOff + voltageMemCellOn) / 2;
-				voltagePrecharge = MIN(tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
+				voltagePrecharge = MIN(context->tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
 				if ((voltagePrecharge - voltageMemCellOn) <= senseVoltage) {
 					cout <<"Error[Subarray]: Read current too large or too small that no reasonable precharge voltage existing" <<endl;
 					invalid = true;
+					invalidScope = organization_scope;	/* depends on the cell only */
+					PROFILE_EVENT(invalid_subarray_event);
 					return;
 				}
 			} else {   /*Voltage-in voltage sensing */
 				resInSerialForSenseAmp = sqrt(resMemCellOn * resMemCellOff);
 				resEquivalentOn = resMemCellOn * resInSerialForSenseAmp / (resMemCellOn + resInSerialForSenseAmp);
 				resEquivalentOff = resMemCellOff * resInSerialForSenseAmp / (resMemCellOff + resInSerialForSenseAmp);
-				voltageMemCellOff = cell->readVoltage * resMemCellOff / (resMemCellOff + resInSerialForSenseAmp);
-				voltageMemCellOn = cell->readVoltage * resMemCellOn / (resMemCellOn + resInSerialForSenseAmp);
+				voltageMemCellOff = context->cell->readVoltage * resMemCellOff / (resMemCellOff + resInSerialForSenseAmp);
+				voltageMemCellOn = context->cell->readVoltage * resMemCellOn / (resMemCellOn + resInSerialForSenseAmp);
 				voltagePrecharge = (voltageMemCellOff + voltageMemCellOn) / 2;
-				voltagePrecharge = MIN(tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
+				voltagePrecharge = MIN(context->tech->vdd, voltagePrecharge);  /* TO-DO: we can have charge bump to increase SA working point */
 				if ((voltagePrecharge - voltageMemCellOn) <= senseVoltage) {
 					cout <<"Error[Subarray]: Read Voltage too large or too small that no reasonable precharge voltage existing" <<endl;
 					invalid = true;
+					invalidScope = organization_scope;	/* depends on the cell only */
+					PROFILE_EVENT(invalid_subarray_event);
 					return;
 				}
 			}
 		}
-	} else if (cell->memCellType == SLCNAND) {
+	} else if (context->cell->memCellType == SLCNAND) {
 		/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
-		int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+		int pageCount = context->inputParameter->flashBlockSize / context->inputParameter->pageSize;
 		int stringLength = pageCount + 2;
-		resCellAccess = CalculateOnResistance(tech->featureSize, NMOS, inputParameter->temperature, *tech) * stringLength;
-		capCellAccess = CalculateDrainCap(tech->featureSize, NMOS, cell->widthInFeatureSize * tech->featureSize, *tech);
+		resCellAccess = CalculateOnResistance(context->tech->featureSize, NMOS, context->techView) * stringLength;
+		capCellAccess = CalculateDrainCap(context->tech->featureSize, NMOS, context->cell->widthInFeatureSize * context->tech->featureSize, context->techView);
 		/* The capacitance of each cell at the gate terminal is the series of C_control_gate | C_floating_gate */
-		capWordline += CalculateGateCap(tech->featureSize, *tech) * numColumn * cell->gateCouplingRatio / (cell->gateCouplingRatio + 1);
+		capWordline += CalculateGateCap(context->tech->featureSize, context->techView) * numColumn * context->cell->gateCouplingRatio / (context->cell->gateCouplingRatio + 1);
 		capBitline  += capCellAccess * (numRow / pageCount) / 2;	/* 2 is due to shared contact and the effective row count is numRow/pageCount */
-		voltagePrecharge = tech->vdd * 0.6;	/* SLC NAND flash bitline precharge voltage is assumed to 0.6Vdd */
+		voltagePrecharge = context->tech->vdd * 0.6;	/* SLC NAND flash bitline precharge voltage is assumed to 0.6Vdd */
 	} else {	/* MLC NAND flash */
 		// TO-DO
 	}
 
 	/* Initialize sub-component */
 
-	precharger.Initialize(tech->vdd, numColumn, capBitline, resBitline);
+	precharger.Initialize(context, context->tech->vdd, numColumn, capBitline, resBitline);
 	precharger.CalculateRC();
 
-	rowDecoder.Initialize(numRow, capWordline, resWordline, multipleRowPerSet, areaOptimizationLevel, maxWordlineCurrent);
+	rowDecoder.Initialize(context, numRow, capWordline, resWordline, multipleRowPerSet, areaOptimizationLevel, maxWordlineCurrent);
 	if (rowDecoder.invalid) {
 		invalid = true;
+		PROFILE_EVENT(invalid_subarray_event);
 		return;
 	}
 	rowDecoder.CalculateRC();
 
 	if (!invalid) {
-		bitlineMuxDecoder.Initialize(muxSenseAmp, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
-		if (bitlineMuxDecoder.invalid)
+		bitlineMuxDecoder.Initialize(context, muxSenseAmp, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
+		if (bitlineMuxDecoder.invalid) {
 			invalid = true;
-		else
+			PROFILE_EVENT(invalid_subarray_event);
+		} else {
 			bitlineMuxDecoder.CalculateRC();
+		}
 	}
 
 	if (!invalid) {
-		senseAmpMuxLev1Decoder.Initialize(muxOutputLev1, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
-		if (senseAmpMuxLev1Decoder.invalid)
+		senseAmpMuxLev1Decoder.Initialize(context, muxOutputLev1, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
+		if (senseAmpMuxLev1Decoder.invalid) {
 			invalid = true;
-		else
+			PROFILE_EVENT(invalid_subarray_event);
+		} else {
 			senseAmpMuxLev1Decoder.CalculateRC();
+		}
 	}
 
 	if (!invalid) {
-		senseAmpMuxLev2Decoder.Initialize(muxOutputLev2, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
-		if (senseAmpMuxLev2Decoder.invalid)
+		senseAmpMuxLev2Decoder.Initialize(context, muxOutputLev2, capMuxLoad, resMuxLoad /* TO-DO: need to fix */, false, areaOptimizationLevel, 0);
+		if (senseAmpMuxLev2Decoder.invalid) {
 			invalid = true;
-		else
+			PROFILE_EVENT(invalid_subarray_event);
+		} else {
 			senseAmpMuxLev2Decoder.CalculateRC();
+		}
 	}
 
-	senseAmpMuxLev2.Initialize(muxOutputLev2, numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2, 0, 0 /* TO-DO: need to fix */, maxBitlineCurrent);
+	senseAmpMuxLev2.Initialize(context, muxOutputLev2, numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2, 0, 0 /* TO-DO: need to fix */, maxBitlineCurrent);
 	senseAmpMuxLev2.CalculateRC();
 
-	senseAmpMuxLev1.Initialize(muxOutputLev1, numColumn / muxSenseAmp / muxOutputLev1,
+	senseAmpMuxLev1.Initialize(context, muxOutputLev1, numColumn / muxSenseAmp / muxOutputLev1,
 			senseAmpMuxLev2.capForPreviousDelayCalculation, senseAmpMuxLev2.capForPreviousPowerCalculation, maxBitlineCurrent);
 	senseAmpMuxLev1.CalculateRC();
 
 	if (internalSenseAmp) {
 		if (!invalid) {
-			senseAmp.Initialize(numSenseAmp, !voltageSense, senseVoltage, lenWordline / numColumn * muxSenseAmp);
-			if (senseAmp.invalid)
+			senseAmp.Initialize(context, numSenseAmp, !voltageSense, senseVoltage, lenWordline / numColumn * muxSenseAmp);
+			if (senseAmp.invalid) {
 				invalid = true;
-			else
+				invalidScope = area_level_scope;	/* the pitch does not depend on the area optimization level */
+				PROFILE_EVENT(invalid_subarray_event);
+			} else {
 				senseAmp.CalculateRC();
+			}
 		}
 		if (!invalid) {
-			bitlineMux.Initialize(muxSenseAmp, numColumn / muxSenseAmp, senseAmp.capLoad, senseAmp.capLoad, maxBitlineCurrent);
+			bitlineMux.Initialize(context, muxSenseAmp, numColumn / muxSenseAmp, senseAmp.capLoad, senseAmp.capLoad, maxBitlineCurrent);
 		}
 	} else {
 		if (!invalid) {
-			bitlineMux.Initialize(muxSenseAmp, numColumn / muxSenseAmp,
+			bitlineMux.Initialize(context, muxSenseAmp, numColumn / muxSenseAmp,
 					senseAmpMuxLev1.capForPreviousDelayCalculation, senseAmpMuxLev1.capForPreviousPowerCalculation, maxBitlineCurrent);
 		}
 	}
@@ -433,6 +477,7 @@ void SubArray::Initialize(long long _numRow, long long _numColumn, bool _multipl
 }
 
 void SubArray::CalculateArea() {
+	PROFILE_STAGE(subarray_profile, area_stage);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -494,6 +539,7 @@ void SubArray::CalculateArea() {
 }
 
 void SubArray::CalculateLatency(double _rampInput) {
+	PROFILE_STAGE(subarray_profile, latency_stage);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -514,14 +560,13 @@ void SubArray::CalculateLatency(double _rampInput) {
 		double tauChargeLatency = resPassTransistor * (capPassTransistor + capBitline) + resBitline * capBitline / 2;
 		chargeLatency = horowitz(tauChargeLatency, 0, 1e20, NULL);
 
-		if (cell->memCellType == SRAM) {
+		if (context->cell->memCellType == SRAM) {
 			/* Codes below calculate the bitline latency */
-			double resPullDown = CalculateOnResistance(cell->widthSRAMCellNMOS * tech->featureSize, NMOS,
-					inputParameter->temperature, *tech);
+			double resPullDown = CalculateOnResistance(context->cell->widthSRAMCellNMOS * context->tech->featureSize, NMOS, context->techView);
 			double tau = (resCellAccess + resPullDown) * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
 					+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
 			tau *= log(voltagePrecharge / (voltagePrecharge - senseVoltage / 2));	/* one signal raises and the other drops, so senseVoltage/2 is enough */
-			double gm = CalculateTransconductance(cell->widthAccessCMOS * tech->featureSize, NMOS, *tech);
+			double gm = CalculateTransconductance(context->cell->widthAccessCMOS * context->tech->featureSize, NMOS, context->techView);
 			double beta = 1 / (resPullDown * gm);
 			double bitlineRamp = 0;
 			bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
@@ -538,9 +583,9 @@ void SubArray::CalculateLatency(double _rampInput) {
 					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
 			/* assume symmetric read/write for SRAM bitline delay */
 			writeLatency = readLatency;
-		} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
-			double cap = (capCellAccess + cell->capDRAMCell) * (capBitline + bitlineMux.capForPreviousDelayCalculation)
-					/ (capCellAccess + cell->capDRAMCell + capBitline + bitlineMux.capForPreviousDelayCalculation);
+		} else if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
+			double cap = (capCellAccess + context->cell->capDRAMCell) * (capBitline + bitlineMux.capForPreviousDelayCalculation)
+					/ (capCellAccess + context->cell->capDRAMCell + capBitline + bitlineMux.capForPreviousDelayCalculation);
 			double res = resBitline + resCellAccess;
 			double tau = 2.3 * res * cap;
 			double bitlineRamp = 0;
@@ -553,14 +598,14 @@ void SubArray::CalculateLatency(double _rampInput) {
 					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
 			/* assume symmetric read/write for DRAM/eDRAM bitline delay */
 			writeLatency = readLatency;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
+		} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
 			double bitlineRamp = 0;
-			if (cell->readMode == false) {	/* current-sensing */
+			if (context->cell->readMode == false) {	/* current-sensing */
 				/* Use ICCAD 2009 model */
 				double tau = resBitline * capBitline / 2 * (resMemCellOff + resBitline / 3) / (resMemCellOff + resBitline);
 				bitlineDelay = horowitz(tau, 0, rowDecoder.rampOutput, &bitlineRamp);
 			} else {						/* voltage-sensing */
-				if (cell->readVoltage == 0) {  /* Current-in voltage sensing */
+				if (context->cell->readVoltage == 0) {  /* Current-in voltage sensing */
 					double tau = resMemCellOn * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
 							+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2); /* time constant of LRS */
 					bitlineDelayOn = tau * log((voltagePrecharge - voltageMemCellOn)/(voltagePrecharge - voltageMemCellOn - senseVoltage));  /* BitlineDelay of HRS */
@@ -591,47 +636,47 @@ void SubArray::CalculateLatency(double _rampInput) {
 			readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
 					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
 
-			if (cell->memCellType == PCRAM) {
-				if (inputParameter->writeScheme == write_and_verify) {
+			if (context->cell->memCellType == PCRAM) {
+				if (context->inputParameter->writeScheme == write_and_verify) {
 					/*TO-DO: write and verify programming */
 				} else {
 					writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);	/* TO-DO: why not directly use precharger latency? */
-					resetLatency = writeLatency + cell->resetPulse;
-					setLatency = writeLatency + cell->setPulse;
-					writeLatency += MAX(cell->resetPulse, cell->setPulse);
+					resetLatency = writeLatency + context->cell->resetPulse;
+					setLatency = writeLatency + context->cell->setPulse;
+					writeLatency += MAX(context->cell->resetPulse, context->cell->setPulse);
 				}
-			} else if (cell->memCellType == FBRAM) {
+			} else if (context->cell->memCellType == FBRAM) {
 				writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
-				resetLatency = writeLatency + cell->resetPulse;
-				setLatency = writeLatency + cell->setPulse;
-				writeLatency += MAX(cell->resetPulse, cell->setPulse);
+				resetLatency = writeLatency + context->cell->resetPulse;
+				setLatency = writeLatency + context->cell->setPulse;
+				writeLatency += MAX(context->cell->resetPulse, context->cell->setPulse);
 			} else { //memristor and MRAM
-				if (cell->accessType == diode_access || cell->accessType == none_access) {
-					if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set)
+				if (context->cell->accessType == diode_access || context->cell->accessType == none_access) {
+					if (context->inputParameter->writeScheme == erase_before_reset || context->inputParameter->writeScheme == erase_before_set)
 						writeLatency = MAX(rowDecoder.writeLatency, chargeLatency);
 					else
 						writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
 					writeLatency += chargeLatency;
-					writeLatency += cell->resetPulse + cell->setPulse;
+					writeLatency += context->cell->resetPulse + context->cell->setPulse;
 				} else { // CMOS or Bipolar access
 					writeLatency = MAX(rowDecoder.writeLatency, columnDecoderLatency + chargeLatency);
-					resetLatency = writeLatency + cell->resetPulse;
-					setLatency = writeLatency + cell->setPulse;
-					writeLatency += MAX(cell->resetPulse, cell->setPulse);
+					resetLatency = writeLatency + context->cell->resetPulse;
+					setLatency = writeLatency + context->cell->setPulse;
+					writeLatency += MAX(context->cell->resetPulse, context->cell->setPulse);
 				}
 			}
-		} else if (cell->memCellType == SLCNAND) {
+		} else if (context->cell->memCellType == SLCNAND) {
 			/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
-			int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+			int pageCount = context->inputParameter->flashBlockSize / context->inputParameter->pageSize;
 			int stringLength = pageCount + 2;
 			/* Codes below calculate the bitline latency */
-			double resPullDown = CalculateOnResistance(tech->featureSize, NMOS, inputParameter->temperature, *tech)
+			double resPullDown = CalculateOnResistance(context->tech->featureSize, NMOS, context->techView)
 					* stringLength;
 			double tau = resPullDown * (capCellAccess + capBitline + bitlineMux.capForPreviousDelayCalculation)
 					+ resBitline * (bitlineMux.capForPreviousDelayCalculation + capBitline / 2);
 			/* in one case the bitline is unchanged, and in the other case the bitline drops from 0.6V to 0.4V */
 			tau *= log((voltagePrecharge)/ (voltagePrecharge - senseVoltage));
-			double gm = CalculateTransconductance(tech->featureSize, NMOS, *tech);	/* minimum size transistor */
+			double gm = CalculateTransconductance(context->tech->featureSize, NMOS, context->techView);	/* minimum size transistor */
 			double beta = 1 / (resPullDown * gm);
 			double bitlineRamp = 0;
 			bitlineDelay = horowitz(tau, beta, rowDecoder.rampOutput, &bitlineRamp);
@@ -649,9 +694,9 @@ void SubArray::CalculateLatency(double _rampInput) {
 			readLatency = decoderLatency + bitlineDelay + bitlineMux.readLatency + senseAmp.readLatency
 					+ senseAmpMuxLev1.readLatency + senseAmpMuxLev2.readLatency;
 			/* calculate the erase time, a.k.a. reset here */
-			resetLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashEraseTime;
+			resetLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + context->cell->flashEraseTime;
 			/* calculate the programming time, a.k.a. set here */
-			setLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + cell->flashProgramTime;
+			setLatency = MAX(rowDecoder.readLatency, columnDecoderLatency + chargeLatency) + context->cell->flashProgramTime;
 			/* use the programming latency as the write latency for SLC NAND*/
 			writeLatency = setLatency;
 		} else {	/* MLC NAND */
@@ -661,6 +706,7 @@ void SubArray::CalculateLatency(double _rampInput) {
 }
 
 void SubArray::CalculatePower() {
+	PROFILE_STAGE(subarray_profile, power_stage);
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else if (invalid) {
@@ -678,30 +724,29 @@ void SubArray::CalculatePower() {
 		senseAmpMuxLev1.CalculatePower();
 		senseAmpMuxLev2.CalculatePower();
 
-		if (cell->memCellType == SRAM) {
+		if (context->cell->memCellType == SRAM) {
 			/* Codes below calculate the SRAM bitline power */
 			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
 					* voltagePrecharge * voltagePrecharge * numColumn;
 			writeDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
 					* voltagePrecharge * voltagePrecharge * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
-			leakage = CalculateGateLeakage(INV, 1, cell->widthSRAMCellNMOS * tech->featureSize,
-					cell->widthSRAMCellPMOS * tech->featureSize, inputParameter->temperature, *tech)
-					* tech->vdd * 2;	/* two inverters per SRAM cell */
-			leakage += CalculateGateLeakage(INV, 1, cell->widthAccessCMOS * tech->featureSize, 0,
-					inputParameter->temperature, *tech) * tech->vdd;	/* two accesses NMOS, but combined as one with vdd crossed */
+			leakage = CalculateGateLeakage(INV, 1, context->cell->widthSRAMCellNMOS * context->tech->featureSize,
+					context->cell->widthSRAMCellPMOS * context->tech->featureSize, context->techView)
+					* context->tech->vdd * 2;	/* two inverters per SRAM cell */
+			leakage += CalculateGateLeakage(INV, 1, context->cell->widthAccessCMOS * context->tech->featureSize, 0, context->techView) * context->tech->vdd;	/* two accesses NMOS, but combined as one with vdd crossed */
 			leakage *= numRow * numColumn;
-		} else if (cell->memCellType == DRAM || cell->memCellType == eDRAM) {
+		} else if (context->cell->memCellType == DRAM || context->cell->memCellType == eDRAM) {
 			/* Codes below calculate the DRAM bitline power */
-			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * senseVoltage * tech->vdd * numColumn;
-			double writeVoltage = cell->resetVoltage;	/* should also equal to setVoltage, for DRAM, it is Vdd */
+			readDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * senseVoltage * context->tech->vdd * numColumn;
+			double writeVoltage = context->cell->resetVoltage;	/* should also equal to setVoltage, for DRAM, it is Vdd */
 			writeDynamicEnergy = (capBitline + bitlineMux.capForPreviousPowerCalculation) * writeVoltage * writeVoltage * numColumn;
 			leakage = readDynamicEnergy / DRAM_REFRESH_PERIOD * numRow;
-		} else if (cell->memCellType == MRAM || cell->memCellType == PCRAM || cell->memCellType == memristor || cell->memCellType == FBRAM) {
-			if (cell->readMode == false) {	/* current-sensing */
+		} else if (context->cell->memCellType == MRAM || context->cell->memCellType == PCRAM || context->cell->memCellType == memristor || context->cell->memCellType == FBRAM) {
+			if (context->cell->readMode == false) {	/* current-sensing */
 				/* Use ICCAD 2009 model */
 				double resBitlineMux = bitlineMux.resNMOSPassTransistor;
-				double vpreMin = cell->readVoltage * resBitlineMux / (resBitlineMux + resBitline +resMemCellOn);
-				double vpreMax = cell->readVoltage * (resBitlineMux + resBitline) / (resBitlineMux + resBitline + resMemCellOn);
+				double vpreMin = context->cell->readVoltage * resBitlineMux / (resBitlineMux + resBitline +resMemCellOn);
+				double vpreMax = context->cell->readVoltage * (resBitlineMux + resBitline) / (resBitlineMux + resBitline + resMemCellOn);
 				readDynamicEnergy = capCellAccess * vpreMax * vpreMax + bitlineMux.capForPreviousPowerCalculation
 						* vpreMin * vpreMin + capBitline * (vpreMax * vpreMax + vpreMin * vpreMin + vpreMax * vpreMin) / 3;
 				readDynamicEnergy *= numColumn;
@@ -710,29 +755,29 @@ void SubArray::CalculatePower() {
 						(voltagePrecharge * voltagePrecharge - voltageMemCellOn * voltageMemCellOn ) * numColumn;
 			}
 
-			if (cell->readPower == 0) 
-				cellReadEnergy = 2 * cell->CalculateReadPower() * senseAmp.readLatency; /* x2 is because of the reference cell */
+			if (context->cell->readPower == 0) 
+				cellReadEnergy = 2 * context->cell->CalculateReadPower(context->tech->vdd) * senseAmp.readLatency; /* x2 is because of the reference cell */
 			else
-				cellReadEnergy = 2 * cell->readPower * senseAmp.readLatency;
+				cellReadEnergy = 2 * context->cell->readPower * senseAmp.readLatency;
 			cellReadEnergy *= numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 
 			/* Ignore the dynamic transition during the SET/RESET operation */
 			/* Assume that the cell resistance keeps high for worst-case power estimation */
-			cell->CalculateWriteEnergy();
+			context->cell->CalculateWriteEnergy(context->tech->vdd);
 
-			double resetEnergyPerBit = cell->resetEnergy;
-			double setEnergyPerBit = cell->setEnergy;
-			if (cell->setMode)
-				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->setVoltage * cell->setVoltage;
+			double resetEnergyPerBit = context->cell->resetEnergy;
+			double setEnergyPerBit = context->cell->setEnergy;
+			if (context->cell->setMode)
+				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * context->cell->setVoltage * context->cell->setVoltage;
 			else
-				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
-			if (cell->resetMode)
-				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * cell->resetVoltage * cell->resetVoltage;
+				setEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * context->tech->vdd * context->tech->vdd;
+			if (context->cell->resetMode)
+				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * context->cell->resetVoltage * context->cell->resetVoltage;
 			else
-				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * tech->vdd * tech->vdd;
+				resetEnergyPerBit += (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation) * context->tech->vdd * context->tech->vdd;
 
-			if (cell->memCellType == PCRAM) { //PCRAM write energy
-				if (inputParameter->writeScheme == write_and_verify) {
+			if (context->cell->memCellType == PCRAM) { //PCRAM write energy
+				if (context->inputParameter->writeScheme == write_and_verify) {
 					/*TO-DO: write and verify programming */
 				} else {
 					cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
@@ -741,15 +786,15 @@ void SubArray::CalculatePower() {
 					cellSetEnergy /= SHAPER_EFFICIENCY_CONSERVATIVE;  /* Due to the shaper inefficiency */
 					writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
 				}
-			} else if (cell->memCellType == FBRAM){ //FBRAM write energy
+			} else if (context->cell->memCellType == FBRAM){ //FBRAM write energy
 				cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 				cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 				cellResetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
 				cellSetEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;  /* Due to the shaper inefficiency */
 				writeDynamicEnergy = MAX(cellResetEnergy, cellSetEnergy);
 			} else { //MRAM and memristor write energy
-				if (cell->accessType == diode_access || cell->accessType == none_access) {
-					if (inputParameter->writeScheme == erase_before_reset || inputParameter->writeScheme == erase_before_set) {
+				if (context->cell->accessType == diode_access || context->cell->accessType == none_access) {
+					if (context->inputParameter->writeScheme == erase_before_reset || context->inputParameter->writeScheme == erase_before_set) {
 						cellResetEnergy = resetEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 						cellSetEnergy = setEnergyPerBit * numColumn / muxSenseAmp / muxOutputLev1 / muxOutputLev2;
 						writeDynamicEnergy = cellResetEnergy + cellSetEnergy;	/* TO-DO: bug here, did you consider the write pattern? */
@@ -768,9 +813,9 @@ void SubArray::CalculatePower() {
 				writeDynamicEnergy /= SHAPER_EFFICIENCY_AGGRESSIVE;
 			}
 			leakage = 0;                       //TO-DO: cell leaks during read/write operation
-		} else if (cell->memCellType == SLCNAND) {
+		} else if (context->cell->memCellType == SLCNAND) {
 			/* Calculate the NAND flash string length, which is the page count per block plus 2 (two select transistors) */
-			int pageCount = inputParameter->flashBlockSize / inputParameter->pageSize;
+			int pageCount = context->inputParameter->flashBlockSize / context->inputParameter->pageSize;
 			int stringLength = pageCount + 2;
 
 			/* === READ energy === */
@@ -783,50 +828,50 @@ void SubArray::CalculatePower() {
 			 */
 			rowDecoder.resetDynamicEnergy = rowDecoder.readDynamicEnergy;
 			rowDecoder.setDynamicEnergy = rowDecoder.readDynamicEnergy;
-			double actualWordlineReadEnergy = rowDecoder.readDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashPassVoltage * cell->flashPassVoltage;	/* approximate calculate, the wordline is charged to Vpass instead of Vdd */
+			double actualWordlineReadEnergy = rowDecoder.readDynamicEnergy / context->tech->vdd / context->tech->vdd
+					* context->cell->flashPassVoltage * context->cell->flashPassVoltage;	/* approximate calculate, the wordline is charged to Vpass instead of Vdd */
 			actualWordlineReadEnergy = actualWordlineReadEnergy * (numRow / pageCount * stringLength - 1);	/* except the selected wordline itself */
 			rowDecoder.readDynamicEnergy = actualWordlineReadEnergy;	/* update the correct value */
 
 			/* === Programming (SET) energy === */
 			/* first calculate the source line energy (charged to Vdd), which is a part of "bitline" in this scenario */
 			setDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* cell->flashProgramVoltage * cell->flashProgramVoltage * numColumn;
+					* context->cell->flashProgramVoltage * context->cell->flashProgramVoltage * numColumn;
 			/* add tunneling current */
 			/* originally it should be multiplied by numColumn/muxSenseAmp/muxOutputLev1/muxOutputLev2,
 			 * but it is multiplied by numColumn here because all the unselected bitlines also need to precharge to Vdd
 			 */
-			setDynamicEnergy += DELTA_V_TH * TUNNEL_CURRENT_FLOW * cell->area
-					* tech->featureSize * tech->featureSize * cell->flashProgramTime * numColumn;
+			setDynamicEnergy += DELTA_V_TH * TUNNEL_CURRENT_FLOW * context->cell->area
+					* context->tech->featureSize * context->tech->featureSize * context->cell->flashProgramTime * numColumn;
 			/* in programming, the SSL is precharged to Vdd, which is equal to the original value calculated
 			 * from row decoder
 			 */
 			double actualWordlineSetEnergy = rowDecoder.setDynamicEnergy;
 			/* however, the unselected wordlines in the same block have to precharge to Vpass */
-			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashPassVoltage * cell->flashPassVoltage * (numRow / pageCount * stringLength - 1);
+			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / context->tech->vdd / context->tech->vdd
+					* context->cell->flashPassVoltage * context->cell->flashPassVoltage * (numRow / pageCount * stringLength - 1);
 			/* And the selected wordline is precharged to Vpgm */
-			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / tech->vdd / tech->vdd
-					* cell->flashProgramVoltage * cell->flashProgramVoltage;
+			actualWordlineSetEnergy += rowDecoder.setDynamicEnergy / context->tech->vdd / context->tech->vdd
+					* context->cell->flashProgramVoltage * context->cell->flashProgramVoltage;
 			rowDecoder.setDynamicEnergy = actualWordlineSetEnergy;	/* update the correct value */
 
 			/* === Erase (RESET) energy === */
 			/* in erase, all the bitlines (selected or unselected) and the sourceline are precharged to Vera-Vbi */
 
 			resetDynamicEnergy = (capCellAccess + capBitline + bitlineMux.capForPreviousPowerCalculation)
-					* (cell->flashEraseVoltage - tech->buildInPotential) * (cell->flashEraseVoltage - tech->buildInPotential);
+					* (context->cell->flashEraseVoltage - context->tech->buildInPotential) * (context->cell->flashEraseVoltage - context->tech->buildInPotential);
 			resetDynamicEnergy *= (numColumn + 1);	/* plus 1 is due to the source line */
 			/* the p-well shared by the selected block is precharged to Vera */
-			double wellJunctionCap = tech->capJunction * cell->area * tech->featureSize * tech->featureSize;
-			wellJunctionCap *= inputParameter->flashBlockSize;	/* one block shares the same well */
-			resetDynamicEnergy += wellJunctionCap * cell->flashEraseVoltage * cell->flashEraseVoltage;
+			double wellJunctionCap = context->tech->capJunction * context->cell->area * context->tech->featureSize * context->tech->featureSize;
+			wellJunctionCap *= context->inputParameter->flashBlockSize;	/* one block shares the same well */
+			resetDynamicEnergy += wellJunctionCap * context->cell->flashEraseVoltage * context->cell->flashEraseVoltage;
 			/* in erase, all the wordlines, SSL, and GSL in unselected block are precharged to Vera * beta
 			 * in selected block, SSL and GSL are precharged to Vera * beta
 			 * here beta is fixed at 0.8
 			 */
 			double beta = 0.8;
-			double actualWordlineResetEnergy = rowDecoder.resetDynamicEnergy / tech->vdd / tech->vdd
-					* (cell->flashEraseVoltage * beta) * (cell->flashEraseVoltage * beta);
+			double actualWordlineResetEnergy = rowDecoder.resetDynamicEnergy / context->tech->vdd / context->tech->vdd
+					* (context->cell->flashEraseVoltage * beta) * (context->cell->flashEraseVoltage * beta);
 			actualWordlineResetEnergy *= (numRow / pageCount * stringLength - pageCount);
 			rowDecoder.resetDynamicEnergy = actualWordlineResetEnergy;
 
@@ -840,12 +885,12 @@ void SubArray::CalculatePower() {
 			/* TO-DO */
 		}
 
-		if (inputParameter->designTarget == cache && inputParameter->cacheAccessMode != sequential_access_mode) {
-			cellResetEnergy /= inputParameter->associativity;
-			cellSetEnergy /= inputParameter->associativity;
-			writeDynamicEnergy /= inputParameter->associativity;
-			resetDynamicEnergy /= inputParameter->associativity;
-			setDynamicEnergy /= inputParameter->associativity;
+		if (context->inputParameter->designTarget == cache && context->inputParameter->cacheAccessMode != sequential_access_mode) {
+			cellResetEnergy /= context->inputParameter->associativity;
+			cellSetEnergy /= context->inputParameter->associativity;
+			writeDynamicEnergy /= context->inputParameter->associativity;
+			resetDynamicEnergy /= context->inputParameter->associativity;
+			setDynamicEnergy /= context->inputParameter->associativity;
 		}
 
 		readDynamicEnergy += cellReadEnergy + rowDecoder.readDynamicEnergy + bitlineMuxDecoder.readDynamicEnergy + senseAmpMuxLev1Decoder.readDynamicEnergy
@@ -862,7 +907,7 @@ void SubArray::CalculatePower() {
 				+ senseAmpMuxLev2Decoder.writeDynamicEnergy + bitlineMux.writeDynamicEnergy
 				+ senseAmp.writeDynamicEnergy + senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
 
-		if (cell->accessType == diode_access || cell->accessType == none_access) {
+		if (context->cell->accessType == diode_access || context->cell->accessType == none_access) {
 			writeDynamicEnergy += bitlineMux.writeDynamicEnergy + senseAmp.writeDynamicEnergy
 					+ senseAmpMuxLev1.writeDynamicEnergy + senseAmpMuxLev2.writeDynamicEnergy;
 		}
@@ -885,6 +930,19 @@ void SubArray::PrintProperty() {
 	cout << "columnDecoderLatency: " << columnDecoderLatency*1e12 << "ps" << endl;
 }
 
+void SubArray::SetContext(SimulationContext *_context) {
+	context = _context;
+	rowDecoder.SetContext(_context);
+	bitlineMuxDecoder.SetContext(_context);
+	bitlineMux.SetContext(_context);
+	senseAmpMuxLev1Decoder.SetContext(_context);
+	senseAmpMuxLev1.SetContext(_context);
+	senseAmpMuxLev2Decoder.SetContext(_context);
+	senseAmpMuxLev2.SetContext(_context);
+	precharger.SetContext(_context);
+	senseAmp.SetContext(_context);
+}
+
 SubArray & SubArray::operator=(const SubArray &rhs) {
 	height = rhs.height;
 	width = rhs.width;
@@ -901,7 +959,10 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 	cellResetEnergy = rhs.cellResetEnergy;
 	cellSetEnergy = rhs.cellSetEnergy;
 	leakage = rhs.leakage;
+	context = rhs.context;
 	initialized = rhs.initialized;
+	invalid = rhs.invalid;
+	invalidScope = rhs.invalidScope;
 	numRow = rhs.numRow;
 	numColumn = rhs.numColumn;
 	multipleRowPerSet = rhs.multipleRowPerSet;
@@ -914,6 +975,7 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 
 	voltageSense = rhs.voltageSense;
 	senseVoltage = rhs.senseVoltage;
+	voltagePrecharge = rhs.voltagePrecharge;
 	numSenseAmp = rhs.numSenseAmp;
 	lenWordline = rhs.lenWordline;
 	lenBitline = rhs.lenBitline;
@@ -933,6 +995,8 @@ SubArray & SubArray::operator=(const SubArray &rhs) {
 	resEquivalentOff = rhs.resEquivalentOff;
 	resMemCellOff = rhs.resMemCellOff;
 	resMemCellOn = rhs.resMemCellOn;
+	voltageMemCellOff = rhs.voltageMemCellOff;
+	voltageMemCellOn = rhs.voltageMemCellOn;
 
 	rowDecoder = rhs.rowDecoder;
 	bitlineMuxDecoder = rhs.bitlineMuxDecoder;
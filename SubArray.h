@@ -52,18 +52,20 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
+	void Initialize(SimulationContext *_context, long long _numRow, long long _numColumn, bool _multipleRowPerSet, bool _split,
 			int _muxSenseAmp, bool _internalSenseAmp, int _muxOutputLev1, int _muxOutputLev2,
 			BufferDesignTarget _areaOptimizationLevel);
 	void CalculateArea();
 	//void CalculateRC();
 	void CalculateLatency(double _rampInput);
 	void CalculatePower();
+	void SetContext(SimulationContext *_context);
 	SubArray & operator=(const SubArray &);
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
 	bool invalid;		/* Indicate that the current configuration is not valid, pass down to all the sub-components */
+	InvalidScope invalidScope;	/* The other designs that are invalid for the same reason */
 	bool internalSenseAmp; /* Indicate whether sense amp is within subarray */
 	long long numRow;			/* Number of rows */
 	long long numColumn;		/* Number of columns */
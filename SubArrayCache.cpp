@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "SubArrayCache.h"
+#include "constant.h"
+
+bool SubArrayKey::operator<(const SubArrayKey &rhs) const {
+	if (numRow != rhs.numRow)
+		return numRow < rhs.numRow;
+	if (numColumn != rhs.numColumn)
+		return numColumn < rhs.numColumn;
+	if (multipleRowPerSet != rhs.multipleRowPerSet)
+		return multipleRowPerSet < rhs.multipleRowPerSet;
+	if (split != rhs.split)
+		return split < rhs.split;
+	if (muxSenseAmp != rhs.muxSenseAmp)
+		return muxSenseAmp < rhs.muxSenseAmp;
+	if (internalSenseAmp != rhs.internalSenseAmp)
+		return internalSenseAmp < rhs.internalSenseAmp;
+	if (muxOutputLev1 != rhs.muxOutputLev1)
+		return muxOutputLev1 < rhs.muxOutputLev1;
+	if (muxOutputLev2 != rhs.muxOutputLev2)
+		return muxOutputLev2 < rhs.muxOutputLev2;
+	if (areaOptimizationLevel != rhs.areaOptimizationLevel)
+		return areaOptimizationLevel < rhs.areaOptimizationLevel;
+	if (localWireType != rhs.localWireType)
+		return localWireType < rhs.localWireType;
+	if (localWireRepeaterType != rhs.localWireRepeaterType)
+		return localWireRepeaterType < rhs.localWireRepeaterType;
+	if (isLocalWireLowSwing != rhs.isLocalWireLowSwing)
+		return isLocalWireLowSwing < rhs.isLocalWireLowSwing;
+	return rampInput < rhs.rampInput;
+}
+
+SubArrayCache::SubArrayCache() {
+	// TODO Auto-generated constructor stub
+	numHit = 0;
+	numMiss = 0;
+}
+
+SubArrayCache::~SubArrayCache() {
+	// TODO Auto-generated destructor stub
+	Clear();
+}
+
+bool SubArrayCache::LoadInitialized(const SubArrayKey &_key, SubArray *_subarray) {
+	return Load(initializedSubarray, _key, _subarray);
+}
+
+void SubArrayCache::StoreInitialized(const SubArrayKey &_key, const SubArray &_subarray) {
+	Store(initializedSubarray, _key, _subarray);
+}
+
+bool SubArrayCache::LoadEvaluated(const SubArrayKey &_key, SubArray *_subarray) {
+	return Load(evaluatedSubarray, _key, _subarray);
+}
+
+void SubArrayCache::StoreEvaluated(const SubArrayKey &_key, const SubArray &_subarray) {
+	Store(evaluatedSubarray, _key, _subarray);
+}
+
+void SubArrayCache::Clear() {
+	lock_guard<mutex> guard(lock);
+	for (SubArrayMap::iterator it = initializedSubarray.begin(); it != initializedSubarray.end(); it++)
+		delete it->second;
+	for (SubArrayMap::iterator it = evaluatedSubarray.begin(); it != evaluatedSubarray.end(); it++)
+		delete it->second;
+	initializedSubarray.clear();
+	evaluatedSubarray.clear();
+}
+
+bool SubArrayCache::Load(SubArrayMap &_map, const SubArrayKey &_key, SubArray *_subarray) {
+	SubArray *cached = NULL;
+	{
+		lock_guard<mutex> guard(lock);
+		SubArrayMap::iterator it = _map.find(_key);
+		if (it != _map.end()) {
+			cached = it->second;
+			numHit++;
+		} else {
+			numMiss++;
+		}
+	}
+	if (cached == NULL)
+		return false;
+	/* The entry is never changed once stored, so it can be copied without the lock */
+	*_subarray = *cached;
+	return true;
+}
+
+void SubArrayCache::Store(SubArrayMap &_map, const SubArrayKey &_key, const SubArray &_subarray) {
+	SubArray *cached = new SubArray;
+	*cached = _subarray;
+	lock_guard<mutex> guard(lock);
+	if (_map.size() >= MAX_SUBARRAY_CACHE_ENTRY || !_map.insert(SubArrayMap::value_type(_key, cached)).second) {
+		/* The cache is full, or another worker has stored the same subarray in the meantime */
+		delete cached;
+	}
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef SUBARRAYCACHE_H_
+#define SUBARRAYCACHE_H_
+
+#include <map>
+#include <mutex>
+#include "SubArray.h"
+#include "typedef.h"
+
+/* Everything a SubArray depends on besides its context. The configuration, technology
+ * and cell are fixed for a context, so only the local wire needs to be part of the key */
+struct SubArrayKey {
+	long long numRow;
+	long long numColumn;
+	bool multipleRowPerSet;
+	bool split;
+	int muxSenseAmp;
+	bool internalSenseAmp;
+	int muxOutputLev1;
+	int muxOutputLev2;
+	BufferDesignTarget areaOptimizationLevel;
+	WireType localWireType;
+	WireRepeaterType localWireRepeaterType;
+	bool isLocalWireLowSwing;
+	double rampInput;	/* Only used by the evaluated subarrays */
+
+	bool operator<(const SubArrayKey &rhs) const;
+};
+
+/* Subarrays that have already been built, keyed by their geometry. Many BIGFOR points
+ * differ only in the mat organization and share the same subarray, so Mat copies the
+ * cached one instead of building and evaluating it again. It is safe to use from the
+ * exploration workers; the cached subarrays are never modified or removed. */
+class SubArrayCache {
+public:
+	SubArrayCache();
+	virtual ~SubArrayCache();
+
+	/* Functions */
+	bool LoadInitialized(const SubArrayKey &_key, SubArray *_subarray);	/* Initialized and area calculated */
+	void StoreInitialized(const SubArrayKey &_key, const SubArray &_subarray);
+	bool LoadEvaluated(const SubArrayKey &_key, SubArray *_subarray);		/* Latency and power calculated as well */
+	void StoreEvaluated(const SubArrayKey &_key, const SubArray &_subarray);
+	void Clear();
+
+	/* Properties */
+	long long numHit;		/* Number of subarrays that are copied from the cache */
+	long long numMiss;		/* Number of subarrays that have to be calculated */
+
+private:
+	typedef map<SubArrayKey, SubArray *> SubArrayMap;
+
+	bool Load(SubArrayMap &_map, const SubArrayKey &_key, SubArray *_subarray);
+	void Store(SubArrayMap &_map, const SubArrayKey &_key, const SubArray &_subarray);
+
+	mutex lock;
+	SubArrayMap initializedSubarray;
+	SubArrayMap evaluatedSubarray;
+};
+
+#endif /* SUBARRAYCACHE_H_ */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "TechView.h"
+#include "formula.h"
+#include <stdlib.h>
+
+TechView::TechView() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+}
+
+TechView::~TechView() {
+	// TODO Auto-generated destructor stub
+}
+
+void TechView::Initialize(const Technology &_tech, int _temperature) {
+	int tempIndex = _temperature - 300;
+	if ((tempIndex > 100) || (tempIndex < 0)) {
+		cout<<"Error: Temperature is out of range"<<endl;
+		exit(-1);
+	}
+
+	temperature = _temperature;
+	featureSize = _tech.featureSize;
+	vdd = _tech.vdd;
+	/* Keep the evaluation order of the formulas, so the results do not change in the last bit */
+	capGate = _tech.capIdealGate + _tech.capOverlap + 3 * _tech.capFringe;
+	capGatePolywire = _tech.phyGateLength * _tech.capPolywire;
+	capJunction = _tech.capJunction;
+	capSidewall = _tech.capSidewall;
+	capDrainToChannel = _tech.capDrainToChannel;
+	resistanceOnFactor = _tech.effectiveResistanceMultiplier * _tech.vdd;
+	currentOnNmos = _tech.currentOnNmos[tempIndex];
+	currentOnPmos = _tech.currentOnPmos[tempIndex];
+	currentOffNmos = _tech.currentOffNmos[tempIndex];
+	currentOffPmos = _tech.currentOffPmos[tempIndex];
+	transconductanceNmos = (_tech.effectiveElectronMobility * _tech.capOx) / 2;
+	transconductancePmos = (_tech.effectiveHoleMobility * _tech.capOx) / 2;
+	vsatNmos = MIN(_tech.vdsatNmos, _tech.vdd - _tech.vth);
+	vsatPmos = MIN(_tech.vdsatPmos, _tech.vdd - _tech.vth);
+	phyGateLength = _tech.phyGateLength;
+	capIdealGate = _tech.capIdealGate;
+	capOverlap = _tech.capOverlap;
+	capFringe = _tech.capFringe;
+	capPolywire = _tech.capPolywire;
+
+	initialized = true;
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef TECHVIEW_H_
+#define TECHVIEW_H_
+
+#include "Technology.h"
+
+/* The device parameters that the formulas read, taken from a Technology at one temperature.
+ * It is small enough to stay in cache, and it is passed to the formulas by reference. */
+class TechView {
+public:
+	TechView();
+	virtual ~TechView();
+
+	/* Functions */
+	void Initialize(const Technology &_tech, int _temperature);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	int temperature;	/* Unit: K */
+	double featureSize;	/* Process feature size, Unit: m */
+	double vdd;			/* Supply voltage, Unit: V */
+	double capGate;		/* capIdealGate + capOverlap + 3 * capFringe, Unit: F/m */
+	double capGatePolywire;	/* phyGateLength * capPolywire, Unit: F */
+	double capJunction;		/* Junction bottom capacitance, Cj0, Unit: F/m^2 */
+	double capSidewall;		/* Junction sidewall capacitance, Cjsw, Unit: F/m */
+	double capDrainToChannel;	/* Junction drain to channel capacitance, Cjswg, Unit: F/m */
+	double resistanceOnFactor;	/* effectiveResistanceMultiplier * vdd, Unit: V */
+	double currentOnNmos;	/* NMOS saturation current at the temperature, Unit: A/m */
+	double currentOnPmos;	/* PMOS saturation current at the temperature, Unit: A/m */
+	double currentOffNmos;	/* NMOS off current at the temperature, Unit: A/m */
+	double currentOffPmos;	/* PMOS off current at the temperature, Unit: A/m */
+	double transconductanceNmos;	/* effectiveElectronMobility * capOx / 2, Unit: F/V/s */
+	double transconductancePmos;	/* effectiveHoleMobility * capOx / 2, Unit: F/V/s */
+	double vsatNmos;		/* MIN(vdsatNmos, vdd - vth), Unit: V */
+	double vsatPmos;		/* MIN(vdsatPmos, vdd - vth), Unit: V */
+	double phyGateLength;	/* Physical gate length, Unit: m */
+	double capIdealGate;	/* Ideal gate capacitance, Unit: F/m */
+	double capOverlap;		/* Overlap capacitance, Cover in MASTAR, Unit: F/m */
+	double capFringe;		/* Fringe capacitance, Unit: F/m */
+	double capPolywire;		/* Poly wire capacitance, Unit: F/m */
+};
+
+#endif /* TECHVIEW_H_ */
@@ -1330,7 +1330,7 @@ void Technology::PrintProperty() {
 	cout << "TO-DO" << endl;
 }
 
-void Technology::InterpolateWith(Technology rhs, double _alpha) {
+void Technology::InterpolateWith(const Technology &rhs, double _alpha) {
 	if (featureSizeInNano != rhs.featureSizeInNano) {
 		vdd = (1 - _alpha) * vdd + _alpha * rhs.vdd;
 		vth = (1 - _alpha) * vth + _alpha * rhs.vth;
@@ -51,7 +51,7 @@ public:
 	/* Functions */
 	void PrintProperty();
 	void Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap);
-	void InterpolateWith(Technology rhs, double _alpha);
+	void InterpolateWith(const Technology &rhs, double _alpha);
 
 	/* Properties */
 	bool initialized;	/* Initialization flag */
@@ -0,0 +1,155 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "ThreadPool.h"
+
+#include <iostream>
+
+#include <thread>
+
+ThreadPool::ThreadPool() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	numThread = 1;
+	task = NULL;
+}
+
+ThreadPool::~ThreadPool() {
+	// TODO Auto-generated destructor stub
+	for (int i = 0; i < (int)ranges.size(); i++)
+		delete ranges[i];
+}
+
+void ThreadPool::Initialize(int _numThread) {
+	if (initialized) {
+		/* reload the new input, clear the previous setting */
+		for (int i = 0; i < (int)ranges.size(); i++)
+			delete ranges[i];
+		ranges.clear();
+	}
+
+	numThread = _numThread > 0 ? _numThread : DefaultNumThread();
+	for (int i = 0; i < numThread; i++)
+		ranges.push_back(new WorkRange);
+
+	initialized = true;
+}
+
+int ThreadPool::DefaultNumThread() {
+	int hardwareThread = (int)thread::hardware_concurrency();
+	return hardwareThread > 0 ? hardwareThread : 1;
+}
+
+void ThreadPool::Run(ParallelTask *_task, long _numTask) {
+	if (!initialized) {
+		cout << "[ThreadPool] Error: Require initialization first!" << endl;
+		return;
+	}
+
+	task = _task;
+
+	/* Static partition first, the stealing balances the load afterwards */
+	for (int i = 0; i < numThread; i++) {
+		ranges[i]->head = _numTask * i / numThread;
+		ranges[i]->tail = _numTask * (i + 1) / numThread;
+	}
+
+	vector<thread> helpers;
+	for (int i = 1; i < numThread; i++)
+		helpers.push_back(thread(&ThreadPool::Work, this, i));
+	Work(0);
+	for (int i = 0; i < (int)helpers.size(); i++)
+		helpers[i].join();
+
+	task = NULL;
+}
+
+void ThreadPool::Work(int _workerId) {
+	WorkRange *range = ranges[_workerId];
+	while (true) {
+		long index;
+		range->lock.lock();
+		if (range->head < range->tail)
+			index = range->head++;
+		else
+			index = -1;
+		range->lock.unlock();
+
+		if (index >= 0)
+			task->Execute(index, _workerId);
+		else if (!Steal(_workerId))
+			break;
+	}
+}
+
+bool ThreadPool::Steal(int _workerId) {
+	/* Rob the victim with the most remaining work, retry until every range is drained */
+	while (true) {
+		int victim = -1;
+		long maxRemaining = 0;
+		for (int i = 1; i < numThread; i++) {
+			int candidate = (_workerId + i) % numThread;
+			ranges[candidate]->lock.lock();
+			long remaining = ranges[candidate]->tail - ranges[candidate]->head;
+			ranges[candidate]->lock.unlock();
+			if (remaining > maxRemaining) {
+				maxRemaining = remaining;
+				victim = candidate;
+			}
+		}
+		if (victim < 0)
+			return false;
+
+		long head, tail;
+		ranges[victim]->lock.lock();
+		tail = ranges[victim]->tail;
+		head = ranges[victim]->head;
+		if (tail > head) {
+			ranges[victim]->tail = tail - (tail - head + 1) / 2;
+			head = ranges[victim]->tail;
+		}
+		ranges[victim]->lock.unlock();
+
+		if (tail > head) {
+			ranges[_workerId]->lock.lock();
+			ranges[_workerId]->head = head;
+			ranges[_workerId]->tail = tail;
+			ranges[_workerId]->lock.unlock();
+			return true;
+		}
+	}
+}
@@ -35,13 +35,49 @@
 *******************************************************************************/
 
 
-#include "InputParameter.h"
-#include "Technology.h"
-#include "MemCell.h"
-#include "Wire.h"
-
-extern InputParameter *inputParameter;
-extern Technology *tech;
-extern MemCell *cell;
-extern Wire *localWire;		/* The wire type of local interconnects (for example, wire in mat) */
-extern Wire *globalWire;	/* The wire type of global interconnects (for example, the ones that connect mats) */
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/* A unit of parallel work, Execute() is called once for every task index */
+class ParallelTask {
+public:
+	virtual ~ParallelTask() {}
+	virtual void Execute(long _index, int _workerId) = 0;
+};
+
+class ThreadPool {
+public:
+	ThreadPool();
+	virtual ~ThreadPool();
+
+	/* Functions */
+	void Initialize(int _numThread);
+	void Run(ParallelTask *_task, long _numTask);	/* Blocks until all the tasks are finished */
+	static int DefaultNumThread();
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	int numThread;		/* Number of workers, the calling thread is always worker 0 */
+
+private:
+	/* Each worker owns a contiguous range [head, tail) of task indices.
+	 * The owner takes tasks from the head, idle workers steal the upper half from the tail. */
+	struct WorkRange {
+		mutex lock;
+		long head;
+		long tail;
+	};
+
+	void Work(int _workerId);
+	bool Steal(int _workerId);
+
+	ParallelTask *task;
+	vector<WorkRange *> ranges;
+};
+
+#endif /* THREADPOOL_H_ */
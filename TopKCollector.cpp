@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "TopKCollector.h"
+#include <algorithm>
+
+static bool Worse(const TopKPoint &lhs, const TopKPoint &rhs) {
+	return lhs.Better(rhs);		/* A max-heap of this order has the worst point on top */
+}
+
+TopKCollector::TopKCollector() {
+	// TODO Auto-generated constructor stub
+	k = 0;
+}
+
+TopKCollector::~TopKCollector() {
+	// TODO Auto-generated destructor stub
+}
+
+void TopKCollector::Initialize(int _k) {
+	k = _k;
+	heap.clear();
+	heap.reserve(k);
+}
+
+bool TopKCollector::Offer(const TopKPoint &_point) {
+	if ((int)heap.size() < k) {
+		heap.push_back(_point);
+		push_heap(heap.begin(), heap.end(), Worse);
+		return true;
+	}
+	if (k == 0 || !_point.Better(heap[0]))
+		return false;
+	pop_heap(heap.begin(), heap.end(), Worse);
+	heap.back() = _point;
+	push_heap(heap.begin(), heap.end(), Worse);
+	return true;
+}
+
+void TopKCollector::Merge(const TopKCollector &_collector) {
+	for (int i = 0; i < (int)_collector.heap.size(); i++)
+		Offer(_collector.heap[i]);
+}
+
+double TopKCollector::Threshold() const {
+	if ((int)heap.size() < k || k == 0)
+		return 1e41;
+	return heap[0].value;
+}
+
+void TopKCollector::GetPoints(vector<TopKPoint> &_points) const {
+	_points = heap;
+	sort_heap(_points.begin(), _points.end(), Worse);
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef TOPKCOLLECTOR_H_
+#define TOPKCOLLECTOR_H_
+
+#include <vector>
+#include "SearchSpace.h"
+#include "typedef.h"
+
+using namespace std;
+
+struct TopKPoint {
+	double value;			/* The value of the optimization target */
+	long long sequence;		/* The position of the design in the BIGFOR order */
+	DesignPoint design;
+
+	/* The order of the results: the smaller value first, and on a tie the design the serial BIGFOR meets first */
+	bool Better(const TopKPoint &rhs) const { return value < rhs.value || (value == rhs.value && sequence < rhs.sequence); }
+};
+
+/* The k best designs of one optimization target. They are kept in a binary heap with the worst of them
+ * on top, so a design is compared with the worst one and replaces it in O(log k). Every exploration
+ * thread fills its own collector and the collectors are merged at the end; because the ties are broken
+ * by the BIGFOR order, the k designs do not depend on the number of threads. */
+class TopKCollector {
+public:
+	TopKCollector();
+	virtual ~TopKCollector();
+
+	/* Functions */
+	void Initialize(int _k);	/* Also drops the designs collected so far */
+	bool Offer(const TopKPoint &_point);	/* Return false if the point is not among the k best so far */
+	void Merge(const TopKCollector &_collector);
+	double Threshold() const;	/* The value a design has to beat or tie to get in, 1e41 until k designs are collected */
+	void GetPoints(vector<TopKPoint> &_points) const;	/* The best first */
+	int Size() const { return (int)heap.size(); }
+
+	/* Properties */
+	int k;
+
+private:
+	vector<TopKPoint> heap;		/* The worst point is heap[0] */
+};
+
+#endif /* TOPKCOLLECTOR_H_ */
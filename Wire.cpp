@@ -36,7 +36,7 @@
 
 
 #include "Wire.h"
-#include "global.h"
+#include "SimulationContext.h"
 #include "formula.h"
 #include "constant.h"
 #include <math.h>
@@ -44,6 +44,7 @@
 Wire::Wire() {
 	// TODO Auto-generated constructor stub
 	initialized = false;
+	context = NULL;
 	senseAmp = NULL;
 }
 
@@ -53,8 +54,9 @@ Wire::~Wire() {
 		delete senseAmp;
 }
 
-void Wire::Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
+void Wire::Initialize(SimulationContext *_context, int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
 		int _temperature, bool _isLowSwing) {
+	context = _context;
 	if (initialized) {
 		/* reload the new input, clear the previous setting */
 		initialized = false;
@@ -510,8 +512,8 @@ void Wire::Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterTy
 			findPenalizedRepeater(penalty);
 		}
 		/* calculate repeated wire pitch */
-		CalculateGateArea(INV, 1, repeaterSize * MIN_NMOS_SIZE * tech->featureSize,
-				repeaterSize * MIN_NMOS_SIZE * tech->featureSize * tech->pnSizeRatio, 1e41, *tech,
+		CalculateGateArea(INV, 1, repeaterSize * MIN_NMOS_SIZE * context->tech->featureSize,
+				repeaterSize * MIN_NMOS_SIZE * context->tech->featureSize * context->tech->pnSizeRatio, 1e41, context->techView,
 				&repeaterHeight, &repeaterWidth);
 		if (repeaterWidth < repeaterHeight) {
 			double temp = repeaterWidth;
@@ -521,19 +523,26 @@ void Wire::Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterTy
 		repeatedWirePitch = wirePitch + repeaterWidth;
 	}
 
+	if (isLowSwing) {
+		/* The receiver is the same for every wire length, build it once so that the wire stays read-only afterwards */
+		senseAmp = new SenseAmp;
+		senseAmp->Initialize(context, 1, false, context->cell->minSenseVoltage, 1 /* for test */);
+		senseAmp->CalculateRC();
+	}
+
 	initialized =true;
 }
 
 
-void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *dynamicEnergy, double *leakagePower) {
+void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *dynamicEnergy, double *leakagePower) const {
 	if (!initialized) {
 		cout << "[Wire] Error: Require initialization first!" << endl;
 	} else {
 		if (isLowSwing) {
 			/* When it is low-swing */
 			if (wireRepeaterType == repeated_none) {
-				double widthNmos = MIN_NMOS_SIZE * tech->featureSize;
-				double widthPmos = widthNmos * tech->pnSizeRatio;
+				double widthNmos = MIN_NMOS_SIZE * context->tech->featureSize;
+				double widthPmos = widthNmos * context->tech->pnSizeRatio;
 				double capInput, capOutput;
 				double tr;
 				double gm;
@@ -546,17 +555,17 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				double rampInput;
 
 				/* Calculate rampInput */
-				CalculateGateCapacitance(INV, 1, widthNmos, widthPmos, tech->featureSize * MAX_TRANSISTOR_HEIGHT, *tech, &capInput, &capOutput);
+				CalculateGateCapacitance(INV, 1, widthNmos, widthPmos, context->tech->featureSize * MAX_TRANSISTOR_HEIGHT, context->techView, &capInput, &capOutput);
 				capLoad = capInput + capOutput;
-				resPullUp = CalculateOnResistance(widthNmos, NMOS, inputParameter->temperature, *tech);
-				resPullUp = CalculateOnResistance(widthPmos, PMOS, inputParameter->temperature, *tech);
+				resPullUp = CalculateOnResistance(widthNmos, NMOS, context->techView);
+				resPullUp = CalculateOnResistance(widthPmos, PMOS, context->techView);
 				tr = resPullUp * capLoad;
-				gm = CalculateTransconductance(widthPmos, PMOS, *tech);
+				gm = CalculateTransconductance(widthPmos, PMOS, context->techView);
 				beta = 1 / (resPullUp * gm);
 				horowitz(tr, beta, 1e20, &riseTime);
-				resPullDown = CalculateOnResistance(widthNmos, NMOS, inputParameter->temperature, *tech);
+				resPullDown = CalculateOnResistance(widthNmos, NMOS, context->techView);
 				tr = resPullDown * capLoad;
-				gm = CalculateTransconductance(widthNmos, NMOS, *tech);
+				gm = CalculateTransconductance(widthNmos, NMOS, context->techView);
 				beta = 1 / (resPullDown * gm);
 				horowitz(tr, beta, riseTime, &fallTime);
 				rampInput = fallTime;
@@ -574,23 +583,23 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				double resWire = resWirePerUnit * wireLength;
 				double resDriver = ((-8) * delayFO4 / ( log(0.5) * capWire)) / RES_ADJ;
 				double widthNmosDriver = resPullDown * widthNmos / resDriver;
-				widthNmosDriver = MIN(widthNmosDriver, MAX_NMOS_SIZE * tech->featureSize);
-				widthNmosDriver = MAX(widthNmosDriver, MIN_NMOS_SIZE * tech->featureSize);
+				widthNmosDriver = MIN(widthNmosDriver, MAX_NMOS_SIZE * context->tech->featureSize);
+				widthNmosDriver = MAX(widthNmosDriver, MIN_NMOS_SIZE * context->tech->featureSize);
 
 				if(resWire * capWire > 8 * delayFO4)
 				{
-					widthNmosDriver = inputParameter->maxNmosSize * tech->featureSize;
+					widthNmosDriver = context->inputParameter->maxNmosSize * context->tech->featureSize;
 				}
 
 				// size the inverter appropriately to minimize the transmitter delay
 				// Note - In order to minimize leakage, we are not adding a set of inverters to
 				// bring down delay. Instead, we are sizing the single gate
 				// based on the logical effort.
-				CalculateGateCapacitance(INV, 1, widthNmosDriver, 0, tech->featureSize*40, *tech, &capGateDriver, &temp);
-				CalculateGateCapacitance(INV, 1, 2 * widthNmos, 2 * widthPmos, tech->featureSize*40, *tech, &capInput, &capOutput);
-				double stageEffort   = sqrt(((2 + tech->pnSizeRatio) / (1 + tech->pnSizeRatio)) * capGateDriver / capInput);
-				double reqCin  = (((2 + tech->pnSizeRatio) / (1 + tech->pnSizeRatio)) * capGateDriver) / stageEffort;
-				CalculateGateCapacitance(INV, 1, widthNmos, widthPmos, tech->featureSize*40, *tech, &capInput, &capOutput);
+				CalculateGateCapacitance(INV, 1, widthNmosDriver, 0, context->tech->featureSize*40, context->techView, &capGateDriver, &temp);
+				CalculateGateCapacitance(INV, 1, 2 * widthNmos, 2 * widthPmos, context->tech->featureSize*40, context->techView, &capInput, &capOutput);
+				double stageEffort   = sqrt(((2 + context->tech->pnSizeRatio) / (1 + context->tech->pnSizeRatio)) * capGateDriver / capInput);
+				double reqCin  = (((2 + context->tech->pnSizeRatio) / (1 + context->tech->pnSizeRatio)) * capGateDriver) / stageEffort;
+				CalculateGateCapacitance(INV, 1, widthNmos, widthPmos, context->tech->featureSize*40, context->techView, &capInput, &capOutput);
 				double sizeInverter = reqCin / capInput;
 				sizeInverter = MAX(sizeInverter, 1);
 
@@ -598,12 +607,12 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				resPullDown *= 2;
 				beta = 1 / (resPullDown * gm);
 				double capNandInput, capNandOutput;
-				CalculateGateCapacitance(NAND, 2, 2 * widthNmos, widthPmos, tech->featureSize*40, *tech, &capNandInput, &capNandOutput);
-				CalculateGateCapacitance(INV, 1, sizeInverter * widthNmos, sizeInverter * widthPmos, tech->featureSize*40, *tech, &capInput, &capOutput);
+				CalculateGateCapacitance(NAND, 2, 2 * widthNmos, widthPmos, context->tech->featureSize*40, context->techView, &capNandInput, &capNandOutput);
+				CalculateGateCapacitance(INV, 1, sizeInverter * widthNmos, sizeInverter * widthPmos, context->tech->featureSize*40, context->techView, &capInput, &capOutput);
 				capLoad = capNandOutput + capInput;
 				tr = resPullDown * capLoad;
 				*(delay) = horowitz(tr, beta, rampInput, &temp);
-				*(dynamicEnergy) = capLoad * tech->vdd * tech->vdd;
+				*(dynamicEnergy) = capLoad * context->tech->vdd * context->tech->vdd;
 				rampInput = temp; /* for the next stage */
 
 				/* Inverter *(delay):
@@ -611,23 +620,19 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				 *    * the gate capacitance of the final stage nmos
 				 *    * transistor which in turn depends on nsize
 				 *    */
-				resPullDown = CalculateOnResistance(sizeInverter * widthNmos, NMOS, inputParameter->temperature, *tech);
-				gm = CalculateTransconductance(widthNmos, NMOS, *tech);
+				resPullDown = CalculateOnResistance(sizeInverter * widthNmos, NMOS, context->techView);
+				gm = CalculateTransconductance(widthNmos, NMOS, context->techView);
 				beta = 1 / (resPullDown * gm);
 				capLoad = capOutput + capGateDriver;
 				tr = resPullDown * capLoad;
 				*(delay) += horowitz(tr, beta, rampInput, &temp);
-				*(dynamicEnergy) += capLoad * tech->vdd * tech->vdd;
+				*(dynamicEnergy) += capLoad * context->tech->vdd * context->tech->vdd;
 				rampInput = temp; /* for the next stage */
 
-				*(leakagePower) = 2 * tech->vdd * CalculateGateLeakage(INV, 1, sizeInverter * widthNmos, sizeInverter * widthPmos, inputParameter->temperature, *tech);
-				*(leakagePower) += 2 * tech->vdd * CalculateGateLeakage(NAND, 2, 2 * widthNmos, widthPmos, inputParameter->temperature, *tech);
+				*(leakagePower) = 2 * context->tech->vdd * CalculateGateLeakage(INV, 1, sizeInverter * widthNmos, sizeInverter * widthPmos, context->techView);
+				*(leakagePower) += 2 * context->tech->vdd * CalculateGateLeakage(NAND, 2, 2 * widthNmos, widthPmos, context->techView);
 				*(leakagePower) *= 2;
 
-				senseAmp = new SenseAmp;
-				senseAmp->Initialize(1, false, cell->minSenseVoltage, 1 /* for test */);
-				senseAmp->CalculateRC();
-
 				/* nmos *(delay) + wire *(delay) */
 				/*
 				 * 			   * NOTE: nmos is used as both pull up and pull down transistor
@@ -635,10 +640,10 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				 *			   * resistance of nmos is less than pmos
 				 *			   * (for a detailed graph ref: On-Chip Wires: Scaling and Efficiency)
 			   */
-				double drainCapDriver = CalculateDrainCap(widthNmosDriver, NMOS, tech->featureSize*40, *tech);
+				double drainCapDriver = CalculateDrainCap(widthNmosDriver, NMOS, context->tech->featureSize*40, context->techView);
 				capLoad = capWire + drainCapDriver * 2 + senseAmp->capLoad;
-				resPullDown = CalculateOnResistance(widthNmosDriver, NMOS, inputParameter->temperature, *tech);
-				gm = CalculateTransconductance(widthNmosDriver, NMOS, *tech);
+				resPullDown = CalculateOnResistance(widthNmosDriver, NMOS, context->techView);
+				gm = CalculateTransconductance(widthNmosDriver, NMOS, context->techView);
 				beta = 1 / (resPullDown * gm);
 				tr = resPullDown * RES_ADJ *(capWire + drainCapDriver * 2) + capWire * resWire / 2 + (resPullDown + resWire) * senseAmp->capLoad;
 				if (delay)
@@ -648,7 +653,7 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 					*(dynamicEnergy) *=2;
 				}
 				if (leakagePower)
-					*(leakagePower) += 4 * tech->vdd * CalculateGateLeakage(INV, 1, widthNmosDriver, 0, inputParameter->temperature, *tech);
+					*(leakagePower) += 4 * context->tech->vdd * CalculateGateLeakage(INV, 1, widthNmosDriver, 0, context->techView);
 
 				/* SA *(delay) and power */
 				if (delay)
@@ -668,7 +673,7 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 				if (delay)
 					*(delay) = 2.3 * resWirePerUnit * capWirePerUnit * _wireLength * _wireLength / 2;
 				if (dynamicEnergy)
-					*(dynamicEnergy) = capWirePerUnit * _wireLength * tech->vdd * tech->vdd;
+					*(dynamicEnergy) = capWirePerUnit * _wireLength * context->tech->vdd * context->tech->vdd;
 				if (leakagePower)
 					*(leakagePower) = 0;
 			} else {		/* with repeaters */
@@ -685,13 +690,13 @@ void Wire::CalculateLatencyAndPower(double _wireLength, double *delay, double *d
 
 void Wire::findOptimalRepeater() {
 	/* Use minimum sized inverter */
-	double nmosSize = MIN_NMOS_SIZE * tech->featureSize;
-	double pmosSize = nmosSize * tech->pnSizeRatio;
-	double inputCap = CalculateGateCap(nmosSize, *tech) + CalculateGateCap(pmosSize, *tech);
-	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, *tech)
-			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, *tech);
-	double outputRes = CalculateOnResistance(nmosSize, NMOS, inputParameter->temperature, *tech)
-			+ CalculateOnResistance(pmosSize, PMOS, inputParameter->temperature, *tech);
+	double nmosSize = MIN_NMOS_SIZE * context->tech->featureSize;
+	double pmosSize = nmosSize * context->tech->pnSizeRatio;
+	double inputCap = CalculateGateCap(nmosSize, context->techView) + CalculateGateCap(pmosSize, context->techView);
+	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, context->techView)
+			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, context->techView);
+	double outputRes = CalculateOnResistance(nmosSize, NMOS, context->techView)
+			+ CalculateOnResistance(pmosSize, PMOS, context->techView);
 
 	repeaterSize = sqrt(outputRes * capWirePerUnit / inputCap / resWirePerUnit);
 	repeaterSpacing = sqrt(2 * outputRes * (outputCap + inputCap) / (resWirePerUnit * capWirePerUnit));
@@ -731,15 +736,15 @@ void Wire::findPenalizedRepeater(double _penalty) {
 	repeaterSize = targetRepeaterSize;
 }
 
-double Wire::getRepeatedWireUnitDelay() {
+double Wire::getRepeatedWireUnitDelay() const {
 	/* Use the scaled size of the repeater */
-	double nmosSize = MIN_NMOS_SIZE * tech->featureSize * repeaterSize;
-	double pmosSize = nmosSize * tech->pnSizeRatio;
-	double inputCap = CalculateGateCap(nmosSize, *tech) + CalculateGateCap(pmosSize, *tech);
-	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, *tech)
-			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, *tech);
-	double outputRes = CalculateOnResistance(nmosSize, NMOS, inputParameter->temperature, *tech)
-			+ CalculateOnResistance(pmosSize, PMOS, inputParameter->temperature, *tech);
+	double nmosSize = MIN_NMOS_SIZE * context->tech->featureSize * repeaterSize;
+	double pmosSize = nmosSize * context->tech->pnSizeRatio;
+	double inputCap = CalculateGateCap(nmosSize, context->techView) + CalculateGateCap(pmosSize, context->techView);
+	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, context->techView)
+			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, context->techView);
+	double outputRes = CalculateOnResistance(nmosSize, NMOS, context->techView)
+			+ CalculateOnResistance(pmosSize, PMOS, context->techView);
 	double wireCap = capWirePerUnit * repeaterSpacing;
 	double wireRes = resWirePerUnit * repeaterSpacing;
 
@@ -750,31 +755,31 @@ double Wire::getRepeatedWireUnitDelay() {
 	return 0.693 * tau / repeaterSpacing;
 }
 
-double Wire::getRepeatedWireUnitDynamicEnergy() {
+double Wire::getRepeatedWireUnitDynamicEnergy() const {
 	/* Use the scaled size of the repeater */
-	double nmosSize = MIN_NMOS_SIZE * tech->featureSize * repeaterSize;
-	double pmosSize = nmosSize * tech->pnSizeRatio;
-	double inputCap = CalculateGateCap(nmosSize, *tech) + CalculateGateCap(pmosSize, *tech);
-	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, *tech)
-			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, *tech);
+	double nmosSize = MIN_NMOS_SIZE * context->tech->featureSize * repeaterSize;
+	double pmosSize = nmosSize * context->tech->pnSizeRatio;
+	double inputCap = CalculateGateCap(nmosSize, context->techView) + CalculateGateCap(pmosSize, context->techView);
+	double outputCap = CalculateDrainCap(nmosSize, NMOS, 1 /*no limit*/, context->techView)
+			+ CalculateDrainCap(pmosSize, PMOS, 1 /*no limit*/, context->techView);
 	double wireCap = capWirePerUnit * repeaterSpacing;
 
-	double switchingEnergy = (inputCap + outputCap + wireCap) * tech->vdd * tech->vdd;
+	double switchingEnergy = (inputCap + outputCap + wireCap) * context->tech->vdd * context->tech->vdd;
 	double shortCircuitEnergy = 0;		/* TO-DO: no short circuit energy in this version */
 
 	return (switchingEnergy + shortCircuitEnergy) / repeaterSpacing;
 }
 
-double Wire::getRepeatedWireUnitLeakage() {
-	double nmosSize = MIN_NMOS_SIZE * tech->featureSize * repeaterSize;
-	double pmosSize = nmosSize * tech->pnSizeRatio;
-	double leakagePerRepeater = CalculateGateLeakage(INV, 1, nmosSize, pmosSize, inputParameter->temperature, *tech)
-			* tech->vdd;
+double Wire::getRepeatedWireUnitLeakage() const {
+	double nmosSize = MIN_NMOS_SIZE * context->tech->featureSize * repeaterSize;
+	double pmosSize = nmosSize * context->tech->pnSizeRatio;
+	double leakagePerRepeater = CalculateGateLeakage(INV, 1, nmosSize, pmosSize, context->techView)
+			* context->tech->vdd;
 
 	return leakagePerRepeater / repeaterSpacing;
 }
 
-void Wire::PrintProperty() {
+void Wire::PrintProperty() const {
 	if (wireRepeaterType == repeated_none) {
 		cout << "Wire Type: passive (without repeaters)";
 		if (isLowSwing) {
@@ -794,6 +799,7 @@ void Wire::PrintProperty() {
 }
 
 Wire & Wire::operator=(const Wire &rhs) {
+	context = rhs.context;
 	initialized = rhs.initialized;
 	featureSizeInNano = rhs.featureSizeInNano;
 	featureSize = rhs.featureSize;
@@ -816,6 +822,14 @@ Wire & Wire::operator=(const Wire &rhs) {
 	repeatedWirePitch = rhs.repeatedWirePitch;
 	resWirePerUnit = rhs.resWirePerUnit;
 	capWirePerUnit = rhs.capWirePerUnit;
+	if (rhs.senseAmp) {
+		if (!senseAmp)
+			senseAmp = new SenseAmp;
+		*senseAmp = *(rhs.senseAmp);
+	} else if (senseAmp) {
+		delete senseAmp;
+		senseAmp = NULL;
+	}
 
 	return *this;
 }
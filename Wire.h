@@ -44,24 +44,27 @@
 
 using namespace std;
 
+class SimulationContext;
+
 class Wire {
 public:
 	Wire();
 	virtual ~Wire();
 
 	/* Functions */
-	void PrintProperty();
-	void Initialize(int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
+	void PrintProperty() const;
+	void Initialize(SimulationContext *_context, int _featureSizeInNano, WireType _wireType, WireRepeaterType _wireRepeaterType,
 			int _temperature, bool _isLowSwing);
-	void CalculateLatencyAndPower(double _wireLength, double *delay, double *dynamicEnergy, double *leakagePower);
+	void CalculateLatencyAndPower(double _wireLength, double *delay, double *dynamicEnergy, double *leakagePower) const;
 	void findOptimalRepeater();
 	void findPenalizedRepeater(double _penalty);
-	double getRepeatedWireUnitDelay();				/* Return delay per unit, Unit: s/m */
-	double getRepeatedWireUnitDynamicEnergy();		/* Return dynamic energy per unit, Unit: J/m */
-	double getRepeatedWireUnitLeakage();			/* Return leakage power per unit, Unit: W/m */
+	double getRepeatedWireUnitDelay() const;				/* Return delay per unit, Unit: s/m */
+	double getRepeatedWireUnitDynamicEnergy() const;		/* Return dynamic energy per unit, Unit: J/m */
+	double getRepeatedWireUnitLeakage() const;			/* Return leakage power per unit, Unit: W/m */
 	Wire & operator=(const Wire &);
 
 	/* Properties */
+	SimulationContext *context;	/* The technology this wire is built with */
 	bool initialized;	/* Initialization flag */
 	int featureSizeInNano; /* Process feature size, Unit: nm */
 	double featureSize;	/* Process feature size, Unit: m */
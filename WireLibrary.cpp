@@ -0,0 +1,91 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "WireLibrary.h"
+
+bool WireKey::operator<(const WireKey &rhs) const {
+	if (featureSizeInNano != rhs.featureSizeInNano)
+		return featureSizeInNano < rhs.featureSizeInNano;
+	if (wireType != rhs.wireType)
+		return wireType < rhs.wireType;
+	if (wireRepeaterType != rhs.wireRepeaterType)
+		return wireRepeaterType < rhs.wireRepeaterType;
+	if (temperature != rhs.temperature)
+		return temperature < rhs.temperature;
+	return isLowSwing < rhs.isLowSwing;
+}
+
+WireLibrary::WireLibrary() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	context = NULL;
+}
+
+WireLibrary::~WireLibrary() {
+	// TODO Auto-generated destructor stub
+	for (WireMap::iterator it = wire.begin(); it != wire.end(); it++)
+		delete it->second;
+}
+
+void WireLibrary::Initialize(SimulationContext *_context) {
+	context = _context;
+	initialized = true;
+}
+
+const Wire * WireLibrary::GetWire(int _featureSizeInNano, WireType _wireType,
+		WireRepeaterType _wireRepeaterType, int _temperature, bool _isLowSwing) {
+	if (!initialized) {
+		cout << "[WireLibrary] Error: Require initialization first!" << endl;
+		return NULL;
+	}
+
+	WireKey key;
+	key.featureSizeInNano = _featureSizeInNano;
+	key.wireType = _wireType;
+	key.wireRepeaterType = _wireRepeaterType;
+	key.temperature = _temperature;
+	key.isLowSwing = _isLowSwing;
+
+	lock_guard<mutex> guard(lock);
+	WireMap::iterator it = wire.find(key);
+	if (it != wire.end())
+		return it->second;
+	Wire *newWire = new Wire();
+	newWire->Initialize(context, _featureSizeInNano, _wireType, _wireRepeaterType, _temperature, _isLowSwing);
+	wire[key] = newWire;
+	return newWire;
+}
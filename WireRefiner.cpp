@@ -0,0 +1,218 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "WireRefiner.h"
+#include "SimulationContext.h"
+#include "formula.h"
+#include "macros.h"
+
+WireRefiner::WireRefiner() {
+	// TODO Auto-generated constructor stub
+	initialized = false;
+	context = NULL;
+	refineTarget = full_exploration;
+	localWire = true;
+	keepBank = false;
+	reuseBank = false;
+	best = NULL;
+	trial = NULL;
+}
+
+WireRefiner::~WireRefiner() {
+	// TODO Auto-generated destructor stub
+}
+
+void WireRefiner::Initialize(SimulationContext *_context, const SearchSpace &_space, MemoryType _memoryType) {
+	context = _context;
+	space = _space;
+	memoryType = _memoryType;
+	initialized = true;
+}
+
+void WireRefiner::RefineLocalWire(ThreadPool *pool, Result *bestResults, ostream *_outputFile, Result *_tagResults) {
+	int localWireType, localWireRepeaterType, isLocalWireLowSwing;	/* actually WireType, WireRepeaterType and boolean value */
+	variant.clear();
+	REFINE_LOCAL_WIRE_FORLOOP(space)
+		variant.push_back(context->wireLibrary->GetWire(context->inputParameter->processNode, (WireType)localWireType,
+				(WireRepeaterType)localWireRepeaterType, context->inputParameter->temperature, (bool)isLocalWireLowSwing));
+	Refine(pool, bestResults, true, _outputFile, _tagResults);
+}
+
+void WireRefiner::RefineGlobalWire(ThreadPool *pool, Result *bestResults, ostream *_outputFile, Result *_tagResults) {
+	int globalWireType, globalWireRepeaterType, isGlobalWireLowSwing;	/* actually WireType, WireRepeaterType and boolean value */
+	variant.clear();
+	REFINE_GLOBAL_WIRE_FORLOOP(space)
+		variant.push_back(context->wireLibrary->GetWire(context->inputParameter->processNode, (WireType)globalWireType,
+				(WireRepeaterType)globalWireRepeaterType, context->inputParameter->temperature, (bool)isGlobalWireLowSwing));
+	Refine(pool, bestResults, false, _outputFile, _tagResults);
+}
+
+void WireRefiner::Refine(ThreadPool *pool, Result *bestResults, bool _localWire, ostream *_outputFile, Result *_tagResults) {
+	if (!initialized) {
+		cout << "[WireRefiner] Error: Require initialization first!" << endl;
+		return;
+	}
+	PROFILE_STAGE(wire_refiner_profile, run_stage);
+
+	best = bestResults;
+	localWire = _localWire;
+	keepBank = _outputFile != NULL;
+	reuseBank = !_localWire && !keepBank;	/* Only the routing depends on the global wire */
+	target.clear();
+	for (int i = 0; i < (int)full_exploration; i++)
+		if (refineTarget == full_exploration || i == (int)refineTarget)
+			target.push_back(i);
+	long numVariant = (long)variant.size();
+	long numTrial = (long)target.size() * numVariant;
+	if (numTrial == 0)
+		return;
+
+	trial = new Result[numTrial];
+	for (long i = 0; i < numTrial; i++)
+		trial[i].Initialize(context);
+	for (int w = 0; w < pool->numThread; w++) {
+		SimulationContext *taskContext = new SimulationContext();
+		taskContext->InitializeWith(context);
+		workerContext.push_back(taskContext);
+	}
+
+	pool->Run(this, reuseBank ? (long)target.size() : numTrial);
+
+	/* Reduce in the serial order: variant by variant, and the targets within a variant */
+	for (long v = 0; v < numVariant; v++) {
+		for (int t = 0; t < (int)target.size(); t++)
+			best[target[t]].compareAndUpdate(trial[t * numVariant + v]);
+		/* The last trial of each variant is written, as the serial refinement did, if its
+		 * repeaters still let it fit the floorplan */
+		Result &lastTrial = trial[(target.size() - 1) * numVariant + v];
+		if (_outputFile && best[target.back()].checkShape(lastTrial.record.height, lastTrial.record.width)) {
+			if (_tagResults) {
+				for (int i = 0; i < (int)full_exploration; i++)
+					lastTrial.printAsCacheToCsvFile(_tagResults[i], context->inputParameter->cacheAccessMode, *_outputFile);
+			} else {
+				lastTrial.printToCsvFile(*_outputFile);
+				*_outputFile << endl;
+			}
+		}
+	}
+
+	for (int w = 0; w < (int)workerContext.size(); w++)
+		delete workerContext[w];
+	workerContext.clear();
+	delete [] trial;
+	trial = NULL;
+}
+
+void WireRefiner::Execute(long _index, int _workerId) {
+	SimulationContext *taskContext = workerContext[_workerId];
+	if (!reuseBank) {
+		PROFILE_EVENT(wire_trial_event);
+		SetWire(_index, taskContext);
+		Bank *bank = Calculate(_index, taskContext);
+		Result &result = trial[_index];
+		if (keepBank) {
+			result.adopt(bank);		/* For the CSV rows */
+		} else {
+			result.store(bank);
+			delete bank;
+		}
+		result.localWire = taskContext->localWire;
+		result.globalWire = taskContext->globalWire;
+		return;
+	}
+
+	/* _index is a target, its mat is calculated once for all the global wire variants */
+	long numVariant = (long)variant.size();
+	Bank *bank = NULL;
+	for (long v = 0; v < numVariant; v++) {
+		long index = _index * numVariant + v;
+		PROFILE_EVENT(wire_trial_event);
+		SetWire(index, taskContext);
+		if (bank) {
+			bank->RecalculateGlobalWire();
+			if (bank->invalid) {
+				/* Built again below, so that it is the same as a new invalid bank */
+				delete bank;
+				bank = NULL;
+			}
+		}
+		if (!bank)
+			bank = Calculate(index, taskContext);
+		trial[index].store(bank);
+		trial[index].localWire = taskContext->localWire;
+		trial[index].globalWire = taskContext->globalWire;
+	}
+	delete bank;
+}
+
+void WireRefiner::SetWire(long _trial, SimulationContext *_context) {
+	long numVariant = (long)variant.size();
+	Result &oldResult = best[target[_trial / numVariant]];
+	SimulationContext *context = _context;	/* for the macros */
+	if (localWire) {
+		context->localWire = variant[_trial % numVariant];
+		LOAD_GLOBAL_WIRE(oldResult);
+	} else {
+		context->globalWire = variant[_trial % numVariant];
+		LOAD_LOCAL_WIRE(oldResult);
+	}
+}
+
+Bank * WireRefiner::Calculate(long _trial, SimulationContext *_context) {
+	Result &oldResult = best[target[_trial / (long)variant.size()]];
+	SimulationContext *context = _context;	/* for the macros */
+	int numRowMat = oldResult.record.design.numRowMat;
+	int numColumnMat = oldResult.record.design.numColumnMat;
+	int numActiveMatPerRow = oldResult.record.design.numActiveMatPerRow;
+	int numActiveMatPerColumn = oldResult.record.design.numActiveMatPerColumn;
+	int numRowSubarray = oldResult.record.design.numRowSubarray;
+	int numColumnSubarray = oldResult.record.design.numColumnSubarray;
+	int numActiveSubarrayPerRow = oldResult.record.design.numActiveSubarrayPerRow;
+	int numActiveSubarrayPerColumn = oldResult.record.design.numActiveSubarrayPerColumn;
+	int muxSenseAmp = oldResult.record.design.muxSenseAmp;
+	int muxOutputLev1 = oldResult.record.design.muxOutputLev1;
+	int muxOutputLev2 = oldResult.record.design.muxOutputLev2;
+	int numRowPerSet = oldResult.record.design.numRowPerSet;
+	int areaOptimizationLevel = oldResult.record.design.areaOptimizationLevel;
+	long long capacity = oldResult.record.capacity;
+	long blockSize = oldResult.record.blockSize;
+	int associativity = oldResult.record.associativity;
+
+	Bank *bank;
+	CALCULATE(bank, memoryType);
+	return bank;
+}
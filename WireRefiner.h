@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef WIREREFINER_H_
+#define WIREREFINER_H_
+
+#include <iostream>
+#include <vector>
+#include "ThreadPool.h"
+#include "Result.h"
+#include "SearchSpace.h"
+#include "typedef.h"
+
+using namespace std;
+
+/* Tries the wire variants on the best design of each target after the exploration.
+ * Every (target, variant) pair is a task with its own context, and the trials are
+ * reduced in the serial REFINE_*_WIRE_FORLOOP order, so the results do not depend
+ * on the number of threads. The global wire variants of a target are one task that
+ * calculates the mat once, unless the trials keep their banks. */
+class WireRefiner: public ParallelTask {
+public:
+	WireRefiner();
+	virtual ~WireRefiner();
+
+	/* Functions */
+	void Initialize(SimulationContext *_context, const SearchSpace &_space, MemoryType _memoryType);
+	void RefineLocalWire(ThreadPool *pool, Result *bestResults, ostream *_outputFile, Result *_tagResults);
+	void RefineGlobalWire(ThreadPool *pool, Result *bestResults, ostream *_outputFile, Result *_tagResults);
+	void Execute(long _index, int _workerId);
+
+	/* Properties */
+	bool initialized;	/* Initialization flag */
+	SimulationContext *context;
+	SearchSpace space;		/* The wire bounds of the refinement */
+	MemoryType memoryType;
+	OptimizationTarget refineTarget;	/* Only refine this target, full_exploration means all of them */
+
+private:
+	void Refine(ThreadPool *pool, Result *bestResults, bool _localWire, ostream *_outputFile, Result *_tagResults);
+	Bank * Calculate(long _trial, SimulationContext *_context);	/* Build the bank of a trial with the wires set in _context */
+	void SetWire(long _trial, SimulationContext *_context);
+
+	bool localWire;				/* Whether the variants replace the local or the global wire */
+	bool keepBank;				/* Whether the trials keep their banks for the CSV rows */
+	bool reuseBank;				/* Whether a task tries every variant of its target on one bank */
+	vector<const Wire *> variant;	/* In the REFINE_*_WIRE_FORLOOP order */
+	vector<int> target;			/* The targets to refine */
+	Result *best;				/* The best results that are refined */
+	Result *trial;				/* target.size() x variant.size() trial results */
+	vector<SimulationContext *> workerContext;	/* The wires of a task are set in the context of its worker */
+};
+
+#endif /* WIREREFINER_H_ */
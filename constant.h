@@ -40,6 +40,9 @@
 
 #define WARNING	0
 
+/* Part of the result cache key, raise it with every change that alters the results */
+#define MODEL_VERSION	"r131.2"
+
 #define INV		0
 #define NOR		1
 #define NAND	2
@@ -103,4 +106,14 @@
 
 #define TOTAL_ADDRESS_BIT	48
 
+#define MAX_HTREE_LEVEL		16	/* The H-tree of a bank has at most 2^16 mats in each direction */
+#define MAX_ROW_PER_SET_STEP	32	/* numRowPerSet is doubled in an int, so it takes fewer values */
+
+#define MAX_SUBARRAY_CACHE_ENTRY	65536	/* Per stage, a cached subarray takes a few KB */
+
+#define PARETO_MAX_LEAF_SIZE	20	/* Points in a leaf of the Pareto frontier tree before it is split */
+#define PARETO_NUM_CHILD		7	/* Children of a split node, num_objective + 1 */
+
+#define PROGRESS_INTERVAL	1.0	/* Unit: s, between two status lines of an exploration */
+
 #endif /* CONSTANT_H_ */
@@ -45,24 +45,23 @@ bool isPow2(int n) {
 	return !(n & (n - 1));
 }
 
-double CalculateGateCap(double width, Technology tech) {
-	return (tech.capIdealGate + tech.capOverlap + 3 * tech.capFringe) * width
-			+ tech.phyGateLength * tech.capPolywire;
+double CalculateGateCap(double width, const TechView &tech) {
+	return tech.capGate * width + tech.capGatePolywire;
 }
 
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech) {
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const TechView &tech) {
 	return (tech.capIdealGate / thicknessFactor + tech.capOverlap + 3 * tech.capFringe) * width
 			+ tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateFBRAMDrainCap(double width, Technology tech) {
+double CalculateFBRAMDrainCap(double width, const TechView &tech) {
 	return (3 * tech.capSidewall + tech.capDrainToChannel) * width;
 }
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const TechView &tech,
 		double *height, double *width) {
 	double	ratio = widthPMOS / (widthPMOS + widthNMOS);
 
@@ -147,7 +146,7 @@ double CalculateGateArea(
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const TechView &tech,
 		double *capInput, double *capOutput) {
 	/* TO-DO: most parts of this function is the same of CalculateGateArea,
 	 * perhaps they will be combined in future
@@ -177,8 +176,13 @@ void CalculateGateCapacitance(
 			heightDrainP = widthPMOS;
 		} else {	/* Folding */
 			if (maxWidthPMOS < 3 * tech.featureSize) {
-				cout << "Error: Unable to do PMOS folding because PMOS size limitation is less than 3F!" <<endl;
-				exit(-1);
+				/* Cannot be folded into the region. The units reject such a region before, otherwise the
+				 * infinite load keeps the design from being chosen */
+				if (capInput)
+					*(capInput) = 1e41;
+				if (capOutput)
+					*(capOutput) = 1e41;
+				return;
 			}
 			numFoldedPMOS = (int)(ceil(widthPMOS / (maxWidthPMOS - 3 * tech.featureSize)));	/* 3F for folding overhead */
 			unitWidthDrainP = (numFoldedPMOS-1) * tech.featureSize * MIN_GAP_BET_POLY;
@@ -195,8 +199,13 @@ void CalculateGateCapacitance(
 			heightDrainN = widthNMOS;
 		} else {	/* Folding */
 			if (maxWidthNMOS < 3 * tech.featureSize) {
-				cout << "Error: Unable to do NMOS folding because NMOS size limitation is less than 3F!" <<endl;
-				exit(-1);
+				/* Cannot be folded into the region. The units reject such a region before, otherwise the
+				 * infinite load keeps the design from being chosen */
+				if (capInput)
+					*(capInput) = 1e41;
+				if (capOutput)
+					*(capOutput) = 1e41;
+				return;
 			}
 			numFoldedNMOS = (int)(ceil(widthNMOS / (maxWidthNMOS - 3 * tech.featureSize)));	/* 3F for folding overhead */
 			unitWidthDrainN = (numFoldedNMOS-1) * tech.featureSize * MIN_GAP_BET_POLY;
@@ -265,7 +274,7 @@ void CalculateGateCapacitance(
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech) {
+		double heightTransistorRegion, const TechView &tech) {
 	double drainCap = 0;
 	if (type == NMOS)
 		CalculateGateCapacitance(INV, 1, width, 0, heightTransistorRegion, tech, NULL, &drainCap);
@@ -277,22 +286,15 @@ double CalculateDrainCap(
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech) {
-	int tempIndex = (int)temperature - 300;
-	if ((tempIndex > 100) || (tempIndex < 0)) {
-		cout<<"Error: Temperature is out of range"<<endl;
-		exit(-1);
-	}
-	double *leakN = tech.currentOffNmos;
-	double *leakP = tech.currentOffPmos;
+		const TechView &tech) {
 	double leakageN, leakageP;
 	switch (gateType) {
 	case INV:
-		leakageN = widthNMOS * leakN[tempIndex];
-		leakageP = widthPMOS * leakP[tempIndex];
+		leakageN = widthNMOS * tech.currentOffNmos;
+		leakageP = widthPMOS * tech.currentOffPmos;
 		return MAX(leakageN, leakageP);
 	case NOR:
-		leakageN = widthNMOS * leakN[tempIndex] * numInput;
+		leakageN = widthNMOS * tech.currentOffNmos * numInput;
 		if (numInput == 2) {
 			return AVG_RATIO_LEAK_2INPUT_NOR * leakageN;
 		}
@@ -300,7 +302,7 @@ double CalculateGateLeakage(
 			return AVG_RATIO_LEAK_3INPUT_NOR * leakageN;
 		}
 	case NAND:
-		leakageP = widthPMOS * leakP[tempIndex] * numInput;
+		leakageP = widthPMOS * tech.currentOffPmos * numInput;
 		if (numInput == 2) {
 			return AVG_RATIO_LEAK_2INPUT_NAND * leakageP;
 		}
@@ -312,30 +314,21 @@ double CalculateGateLeakage(
 	}
 }
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech) {
+double CalculateOnResistance(double width, int type, const TechView &tech) {
 	double r;
-	int tempIndex = (int)temperature - 300;
-	if ((tempIndex > 100) || (tempIndex < 0)) {
-		cout<<"Error: Temperature is out of range"<<endl;
-		exit(-1);
-	}
 	if (type == NMOS)
-		r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.currentOnNmos[tempIndex] * width);
+		r = tech.resistanceOnFactor / (tech.currentOnNmos * width);
 	else
-		r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.currentOnPmos[tempIndex] * width);
+		r = tech.resistanceOnFactor / (tech.currentOnPmos * width);
 	return r;
 }
 
-double CalculateTransconductance(double width, int type, Technology tech) {
+double CalculateTransconductance(double width, int type, const TechView &tech) {
 	double gm;
-	double vsat;
-	if (type == NMOS) {
-		vsat = MIN(tech.vdsatNmos, tech.vdd - tech.vth);
-		gm = (tech.effectiveElectronMobility * tech.capOx) / 2 * width / tech.phyGateLength * vsat;
-	} else {
-		vsat = MIN(tech.vdsatPmos, tech.vdd - tech.vth);
-		gm = (tech.effectiveHoleMobility * tech.capOx) / 2 * width / tech.phyGateLength * vsat;
-	}
+	if (type == NMOS)
+		gm = tech.transconductanceNmos * width / tech.phyGateLength * tech.vsatNmos;
+	else
+		gm = tech.transconductancePmos * width / tech.phyGateLength * tech.vsatPmos;
 	return gm;
 }
 
@@ -38,7 +38,7 @@
 #ifndef FORMULA_H_
 #define FORMULA_H_
 
-#include "Technology.h"
+#include "TechView.h"
 #include "constant.h"
 #include <math.h>
 
@@ -48,38 +48,38 @@
 bool isPow2(int n);
 
 /* calculate the gate capacitance */
-double CalculateGateCap(double width, Technology tech);
+double CalculateGateCap(double width, const TechView &tech);
 
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const TechView &tech,
 		double *height, double *width);
 
 /* calculate the capacitance of a gate */
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const TechView &tech,
 		double *capInput, double *capOutput);
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech);
+		double heightTransistorRegion, const TechView &tech);
 
 /* calculate the capacitance of a FBRAM */
-double CalculateFBRAMGateCap(double width, double thicknessFactor, Technology tech);
+double CalculateFBRAMGateCap(double width, double thicknessFactor, const TechView &tech);
 
-double CalculateFBRAMDrainCap(double width, Technology tech);
+double CalculateFBRAMDrainCap(double width, const TechView &tech);
 
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech);
+		const TechView &tech);
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech);
+double CalculateOnResistance(double width, int type, const TechView &tech);
 
-double CalculateTransconductance(double width, int type, Technology tech);
+double CalculateTransconductance(double width, int type, const TechView &tech);
 
 double horowitz(double tr, double beta, double rampInput, double *rampOutput);
 
@@ -39,251 +39,144 @@
 #define MACROS_H_
 
 
-#define INITIAL_BASIC_WIRE { \
+#define INITIAL_BASIC_WIRE(space) { \
 	WireType basicWireType; \
 	WireRepeaterType basicWireRepeaterType; \
 	bool isBasicLowSwing; \
-	if (inputParameter->minLocalWireType == inputParameter->maxLocalWireType) \
-		basicWireType = (WireType)inputParameter->minLocalWireType; \
+	if ((space).minLocalWireType == (space).maxLocalWireType) \
+		basicWireType = (WireType)(space).minLocalWireType; \
 	else \
 		basicWireType = local_aggressive; \
-	if (inputParameter->minLocalWireRepeaterType == inputParameter->maxLocalWireRepeaterType) \
-		basicWireRepeaterType = (WireRepeaterType)inputParameter->minLocalWireRepeaterType; \
+	if ((space).minLocalWireRepeaterType == (space).maxLocalWireRepeaterType) \
+		basicWireRepeaterType = (WireRepeaterType)(space).minLocalWireRepeaterType; \
 	else \
 		basicWireRepeaterType = repeated_none; \
-	if (inputParameter->minIsLocalWireLowSwing == inputParameter->maxIsLocalWireLowSwing) \
-		isBasicLowSwing = inputParameter->minIsLocalWireLowSwing; \
+	if ((space).minIsLocalWireLowSwing == (space).maxIsLocalWireLowSwing) \
+		isBasicLowSwing = (space).minIsLocalWireLowSwing; \
 	else \
 		isBasicLowSwing = false; \
-	localWire->Initialize(inputParameter->processNode, basicWireType, basicWireRepeaterType, inputParameter->temperature, isBasicLowSwing); \
-	if (inputParameter->minGlobalWireType == inputParameter->maxGlobalWireType) \
-		basicWireType = (WireType)inputParameter->minGlobalWireType; \
+	context->SetLocalWire(basicWireType, basicWireRepeaterType, isBasicLowSwing); \
+	if ((space).minGlobalWireType == (space).maxGlobalWireType) \
+		basicWireType = (WireType)(space).minGlobalWireType; \
 	else \
 		basicWireType = global_aggressive; \
-	if (inputParameter->minGlobalWireRepeaterType == inputParameter->maxGlobalWireRepeaterType) \
-		basicWireRepeaterType = (WireRepeaterType)inputParameter->minGlobalWireRepeaterType; \
+	if ((space).minGlobalWireRepeaterType == (space).maxGlobalWireRepeaterType) \
+		basicWireRepeaterType = (WireRepeaterType)(space).minGlobalWireRepeaterType; \
 	else \
 		basicWireRepeaterType = repeated_none; \
-	if (inputParameter->minIsGlobalWireLowSwing == inputParameter->maxIsGlobalWireLowSwing) \
-		isBasicLowSwing = inputParameter->minIsGlobalWireLowSwing; \
+	if ((space).minIsGlobalWireLowSwing == (space).maxIsGlobalWireLowSwing) \
+		isBasicLowSwing = (space).minIsGlobalWireLowSwing; \
 	else \
 		isBasicLowSwing = false; \
-	globalWire->Initialize(inputParameter->processNode, basicWireType, basicWireRepeaterType, inputParameter->temperature, isBasicLowSwing); \
+	context->SetGlobalWire(basicWireType, basicWireRepeaterType, isBasicLowSwing); \
 }
 
 
 
-#define REFINE_LOCAL_WIRE_FORLOOP \
-	for (localWireType = inputParameter->minLocalWireType; localWireType <= inputParameter->maxLocalWireType; localWireType++) \
-	for (localWireRepeaterType = inputParameter->minLocalWireRepeaterType; localWireRepeaterType <= inputParameter->maxLocalWireRepeaterType; localWireRepeaterType++) \
-	for (isLocalWireLowSwing = inputParameter->minIsLocalWireLowSwing; isLocalWireLowSwing <= inputParameter->maxIsLocalWireLowSwing; isLocalWireLowSwing++) \
+#define REFINE_LOCAL_WIRE_FORLOOP(space) \
+	for (localWireType = (space).minLocalWireType; localWireType <= (space).maxLocalWireType; localWireType++) \
+	for (localWireRepeaterType = (space).minLocalWireRepeaterType; localWireRepeaterType <= (space).maxLocalWireRepeaterType; localWireRepeaterType++) \
+	for (isLocalWireLowSwing = (space).minIsLocalWireLowSwing; isLocalWireLowSwing <= (space).maxIsLocalWireLowSwing; isLocalWireLowSwing++) \
 	if ((WireRepeaterType)localWireRepeaterType == repeated_none || (bool)isLocalWireLowSwing == false)
 
 
-#define REFINE_GLOBAL_WIRE_FORLOOP \
-	for (globalWireType = inputParameter->minGlobalWireType; globalWireType <= inputParameter->maxGlobalWireType; globalWireType++) \
-	for (globalWireRepeaterType = inputParameter->minGlobalWireRepeaterType; globalWireRepeaterType <= inputParameter->maxGlobalWireRepeaterType; globalWireRepeaterType++) \
-	for (isGlobalWireLowSwing = inputParameter->minIsGlobalWireLowSwing; isGlobalWireLowSwing <= inputParameter->maxIsGlobalWireLowSwing; isGlobalWireLowSwing++) \
+#define REFINE_GLOBAL_WIRE_FORLOOP(space) \
+	for (globalWireType = (space).minGlobalWireType; globalWireType <= (space).maxGlobalWireType; globalWireType++) \
+	for (globalWireRepeaterType = (space).minGlobalWireRepeaterType; globalWireRepeaterType <= (space).maxGlobalWireRepeaterType; globalWireRepeaterType++) \
+	for (isGlobalWireLowSwing = (space).minIsGlobalWireLowSwing; isGlobalWireLowSwing <= (space).maxIsGlobalWireLowSwing; isGlobalWireLowSwing++) \
 	if ((WireRepeaterType)globalWireRepeaterType == repeated_none || (bool)isGlobalWireLowSwing == false)
 
 
 
 
 #define LOAD_GLOBAL_WIRE(oldResult) { \
-	globalWire->Initialize(inputParameter->processNode, (oldResult).globalWire->wireType, (oldResult).globalWire->wireRepeaterType, \
-			inputParameter->temperature, (oldResult).globalWire->isLowSwing); \
+	context->globalWire = (oldResult).globalWire; \
 }
 
 
 #define LOAD_LOCAL_WIRE(oldResult) \
-	localWire->Initialize(inputParameter->processNode, (oldResult).localWire->wireType, (oldResult).localWire->wireRepeaterType, \
-			inputParameter->temperature, (oldResult).localWire->isLowSwing);
+	context->localWire = (oldResult).localWire;
 
 
 
-#define TRY_AND_UPDATE(oldResult, memoryType) { \
-	if (inputParameter->routingMode == h_tree) \
-		trialBank = new BankWithHtree(); \
-	else \
-		trialBank = new BankWithoutHtree(); \
-	trialBank->Initialize((oldResult).bank->numRowMat, (oldResult).bank->numColumnMat, (oldResult).bank->capacity, (oldResult).bank->blockSize, (oldResult).bank->associativity, \
-				(oldResult).bank->numRowPerSet, (oldResult).bank->numActiveMatPerRow, (oldResult).bank->numActiveMatPerColumn, (oldResult).bank->muxSenseAmp, \
-				inputParameter->internalSensing, (oldResult).bank->muxOutputLev1, (oldResult).bank->muxOutputLev2, (oldResult).bank->numRowSubarray, (oldResult).bank->numColumnSubarray, \
-				(oldResult).bank->numActiveSubarrayPerRow, (oldResult).bank->numActiveSubarrayPerColumn, (oldResult).bank->areaOptimizationLevel, (memoryType)); \
-	trialBank->CalculateArea(); \
-	trialBank->CalculateRC(); \
-	trialBank->CalculateLatencyAndPower(); \
-	*(tempResult.bank) = *trialBank; \
-	*(tempResult.localWire) = *localWire; \
-	*(tempResult.globalWire) = *globalWire; \
-	oldResult.compareAndUpdate(tempResult); \
-	delete trialBank; \
-}
+#define ORGANIZATION_FORLOOP(space) \
+	for (numRowMat = (space).minNumRowMat; numRowMat <= (space).maxNumRowMat; numRowMat *= 2) \
+	for (numColumnMat = (space).minNumColumnMat; numColumnMat <= (space).maxNumColumnMat; numColumnMat *= 2) \
+	for (numActiveMatPerRow = MIN(numColumnMat, (space).minNumActiveMatPerRow); numActiveMatPerRow <= MIN(numColumnMat, (space).maxNumActiveMatPerRow); numActiveMatPerRow *= 2) \
+	for (numActiveMatPerColumn = MIN(numRowMat, (space).minNumActiveMatPerColumn); numActiveMatPerColumn <= MIN(numRowMat, (space).maxNumActiveMatPerColumn); numActiveMatPerColumn *= 2) \
+	for (numRowSubarray = (space).minNumRowSubarray; numRowSubarray <= (space).maxNumRowSubarray; numRowSubarray *= 2) \
+	for (numColumnSubarray = (space).minNumColumnSubarray; numColumnSubarray <= (space).maxNumColumnSubarray; numColumnSubarray *= 2) \
+	for (numActiveSubarrayPerRow = MIN(numColumnSubarray, (space).minNumActiveSubarrayPerRow); numActiveSubarrayPerRow <= MIN(numColumnSubarray, (space).maxNumActiveSubarrayPerRow); numActiveSubarrayPerRow *=2) \
+	for (numActiveSubarrayPerColumn = MIN(numRowSubarray, (space).minNumActiveSubarrayPerColumn); numActiveSubarrayPerColumn <= MIN(numRowSubarray, (space).maxNumActiveSubarrayPerColumn); numActiveSubarrayPerColumn *= 2)
 
 
+#define PERIPHERAL_FORLOOP(space, associativity) \
+	for (muxSenseAmp = (space).minMuxSenseAmp; muxSenseAmp <= (space).maxMuxSenseAmp; muxSenseAmp *= 2) \
+	for (muxOutputLev1 = (space).minMuxOutputLev1; muxOutputLev1 <= (space).maxMuxOutputLev1; muxOutputLev1 *= 2) \
+	for (muxOutputLev2 = (space).minMuxOutputLev2; muxOutputLev2 <= (space).maxMuxOutputLev2; muxOutputLev2 *= 2) \
+	for (numRowPerSet = (space).minNumRowPerSet; numRowPerSet <= MIN((space).maxNumRowPerSet, (associativity)); numRowPerSet *= 2) \
+	for (areaOptimizationLevel = (space).minAreaOptimizationLevel; areaOptimizationLevel <= (space).maxAreaOptimizationLevel; areaOptimizationLevel++)
 
-#define BIGFOR \
-	for (numRowMat = inputParameter->minNumRowMat; numRowMat <= inputParameter->maxNumRowMat; numRowMat *= 2) \
-	for (numColumnMat = inputParameter->minNumColumnMat; numColumnMat <= inputParameter->maxNumColumnMat; numColumnMat *= 2) \
-	for (numActiveMatPerRow = MIN(numColumnMat, inputParameter->minNumActiveMatPerRow); numActiveMatPerRow <= MIN(numColumnMat, inputParameter->maxNumActiveMatPerRow); numActiveMatPerRow *= 2) \
-	for (numActiveMatPerColumn = MIN(numRowMat, inputParameter->minNumActiveMatPerColumn); numActiveMatPerColumn <= MIN(numRowMat, inputParameter->maxNumActiveMatPerColumn); numActiveMatPerColumn *= 2) \
-	for (numRowSubarray = inputParameter->minNumRowSubarray; numRowSubarray <= inputParameter->maxNumRowSubarray; numRowSubarray *= 2) \
-	for (numColumnSubarray = inputParameter->minNumColumnSubarray; numColumnSubarray <= inputParameter->maxNumColumnSubarray; numColumnSubarray *= 2) \
-	for (numActiveSubarrayPerRow = MIN(numColumnSubarray, inputParameter->minNumActiveSubarrayPerRow); numActiveSubarrayPerRow <= MIN(numColumnSubarray, inputParameter->maxNumActiveSubarrayPerRow); numActiveSubarrayPerRow *=2) \
-	for (numActiveSubarrayPerColumn = MIN(numRowSubarray, inputParameter->minNumActiveSubarrayPerColumn); numActiveSubarrayPerColumn <= MIN(numRowSubarray, inputParameter->maxNumActiveSubarrayPerColumn); numActiveSubarrayPerColumn *= 2) \
-	for (muxSenseAmp = inputParameter->minMuxSenseAmp; muxSenseAmp <= inputParameter->maxMuxSenseAmp; muxSenseAmp *= 2) \
-	for (muxOutputLev1 = inputParameter->minMuxOutputLev1; muxOutputLev1 <= inputParameter->maxMuxOutputLev1; muxOutputLev1 *= 2) \
-	for (muxOutputLev2 = inputParameter->minMuxOutputLev2; muxOutputLev2 <= inputParameter->maxMuxOutputLev2; muxOutputLev2 *= 2) \
-	for (numRowPerSet = inputParameter->minNumRowPerSet; numRowPerSet <= MIN(inputParameter->maxNumRowPerSet, inputParameter->associativity); numRowPerSet *= 2) \
-	for (areaOptimizationLevel = inputParameter->minAreaOptimizationLevel; areaOptimizationLevel <= inputParameter->maxAreaOptimizationLevel; areaOptimizationLevel++)
 
+/* The Explorer splits BIGFOR at this boundary: every ORGANIZATION_FORLOOP point is a work item */
+#define BIGFOR(space, associativity) \
+	ORGANIZATION_FORLOOP(space) \
+	PERIPHERAL_FORLOOP(space, associativity)
 
 
-#define CALCULATE(bank, memoryType) { \
-	if (inputParameter->routingMode == h_tree) \
+
+#define INITIALIZE_BANK(bank, memoryType) { \
+	if (context->inputParameter->routingMode == h_tree) \
 		(bank) = new BankWithHtree(); \
 	else \
 		(bank) = new BankWithoutHtree(); \
-	(bank)->Initialize(numRowMat, numColumnMat, capacity, blockSize, associativity, \
-				numRowPerSet, numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, \
-				inputParameter->internalSensing, muxOutputLev1, muxOutputLev2, numRowSubarray, numColumnSubarray, \
-				numActiveSubarrayPerRow, numActiveSubarrayPerColumn, (BufferDesignTarget)areaOptimizationLevel, (memoryType)); \
-	(bank)->CalculateArea(); \
-	(bank)->CalculateRC(); \
-	(bank)->CalculateLatencyAndPower(); \
+	INITIALIZE_BANK_PARAMETERS(bank, memoryType); \
 }
 
 
-#define UPDATE_BEST_DATA { \
-	*(tempResult.bank) = *dataBank; \
-	*(tempResult.localWire) = *localWire; \
-	*(tempResult.globalWire) = *globalWire; \
-	for (int i = 0; i < (int)full_exploration; i++) \
-		bestDataResults[i].compareAndUpdate(tempResult); \
+/* The same in the storage of BANK_STORAGE_SIZE bytes, the bank is released with (bank)->~Bank() */
+#define INITIALIZE_BANK_AT(bank, storage, memoryType) { \
+	if (context->inputParameter->routingMode == h_tree) \
+		(bank) = new (storage) BankWithHtree(); \
+	else \
+		(bank) = new (storage) BankWithoutHtree(); \
+	INITIALIZE_BANK_PARAMETERS(bank, memoryType); \
 }
 
 
-#define VERIFY_DATA_CAPACITY { \
-	if ((long long)dataBank->mat.subarray.numColumn * dataBank->mat.subarray.numRow * dataBank->numColumnMat * \
-			dataBank->numRowMat * dataBank->numColumnSubarray * dataBank->numRowSubarray != capacity) { \
-				cout << "1 Bank = " << dataBank->numRowMat << "x" << dataBank->numColumnMat << " Mats" << endl; \
-				cout << "Activation - " << dataBank->numActiveMatPerColumn << "x" << dataBank->numActiveMatPerRow << " Mats" << endl; \
-				cout << "1 Mat  = " << dataBank->numRowSubarray << "x" << dataBank->numColumnSubarray << " Subarrays" << endl; \
-				cout << "Activation - " << dataBank->numActiveSubarrayPerColumn << "x" << dataBank->numActiveSubarrayPerRow << " Subarrays" << endl; \
-				cout << "Mux Degree - " << dataBank->muxSenseAmp << " x " << dataBank->muxOutputLev1 << " x " << dataBank->muxOutputLev2 << endl; \
-				cout << "ERROR: DATA capacity violation. Shouldn't happen" << endl; \
-				exit(-1); \
-			} \
+#define BANK_STORAGE_SIZE MAX(sizeof(BankWithHtree), sizeof(BankWithoutHtree))
+
+
+#define INITIALIZE_BANK_PARAMETERS(bank, memoryType) { \
+	(bank)->Initialize(context, numRowMat, numColumnMat, capacity, blockSize, associativity, \
+				numRowPerSet, numActiveMatPerRow, numActiveMatPerColumn, muxSenseAmp, \
+				context->inputParameter->internalSensing, muxOutputLev1, muxOutputLev2, numRowSubarray, numColumnSubarray, \
+				numActiveSubarrayPerRow, numActiveSubarrayPerColumn, (BufferDesignTarget)areaOptimizationLevel, (memoryType)); \
 }
 
 
-#define UPDATE_BEST_TAG { \
-	*(tempResult.bank) = *tagBank; \
-	*(tempResult.localWire) = *localWire; \
-	*(tempResult.globalWire) = *globalWire; \
-	for (int i = 0; i < (int)full_exploration; i++) \
-		bestTagResults[i].compareAndUpdate(tempResult); \
+#define CALCULATE(bank, memoryType) { \
+	INITIALIZE_BANK(bank, memoryType); \
+	(bank)->CalculateArea(); \
+	(bank)->CalculateRC(); \
+	(bank)->CalculateLatencyAndPower(); \
 }
 
 
-#define VERIFY_TAG_CAPACITY { \
-	if ((long long)tagBank->mat.subarray.numColumn * tagBank->mat.subarray.numRow * tagBank->numColumnMat * \
-			tagBank->numRowMat * tagBank->numColumnSubarray * tagBank->numRowSubarray != capacity) { \
-				cout << "1 Bank = " << tagBank->numRowMat << "x" << tagBank->numColumnMat << " Mats" << endl; \
-				cout << "Activation - " << tagBank->numActiveMatPerColumn << "x" << tagBank->numActiveMatPerRow << " Mats" << endl; \
-				cout << "1 Mat  = " << tagBank->numRowSubarray << "x" << tagBank->numColumnSubarray << " Subarrays" << endl; \
-				cout << "Activation - " << tagBank->numActiveSubarrayPerColumn << "x" << tagBank->numActiveSubarrayPerRow << " Subarrays" << endl; \
-				cout << "Mux Degree - " << tagBank->muxSenseAmp << " x " << tagBank->muxOutputLev1 << " x " << tagBank->muxOutputLev2 << endl; \
+#define VERIFY_CAPACITY(bank) { \
+	if ((long long)(bank)->mat.subarray.numColumn * (bank)->mat.subarray.numRow * (bank)->numColumnMat * \
+			(bank)->numRowMat * (bank)->numColumnSubarray * (bank)->numRowSubarray != capacity) { \
+				cout << "1 Bank = " << (bank)->numRowMat << "x" << (bank)->numColumnMat << " Mats" << endl; \
+				cout << "Activation - " << (bank)->numActiveMatPerColumn << "x" << (bank)->numActiveMatPerRow << " Mats" << endl; \
+				cout << "1 Mat  = " << (bank)->numRowSubarray << "x" << (bank)->numColumnSubarray << " Subarrays" << endl; \
+				cout << "Activation - " << (bank)->numActiveSubarrayPerColumn << "x" << (bank)->numActiveSubarrayPerRow << " Subarrays" << endl; \
+				cout << "Mux Degree - " << (bank)->muxSenseAmp << " x " << (bank)->muxOutputLev1 << " x " << (bank)->muxOutputLev2 << endl; \
 				cout << "ERROR: DATA capacity violation. Shouldn't happen" << endl; \
 				exit(-1); \
 			} \
 }
 
 
-#define REDUCE_SEARCH_SIZE { \
-	inputParameter->minNumRowMat = 1; \
-	inputParameter->maxNumRowMat = 64; \
-	inputParameter->minNumColumnMat = 1; \
-	inputParameter->maxNumColumnMat = 64; \
-	inputParameter->minNumActiveMatPerRow = 1; \
-	inputParameter->maxNumActiveMatPerRow = inputParameter->maxNumColumnMat; \
-	inputParameter->minNumActiveMatPerColumn = 1; \
-	inputParameter->maxNumActiveMatPerColumn = inputParameter->maxNumRowMat; \
-	inputParameter->minNumRowSubarray = 1; \
-	inputParameter->maxNumRowSubarray = 2; \
-	inputParameter->minNumColumnSubarray = 1; \
-	inputParameter->maxNumColumnSubarray = 2; \
-	inputParameter->minNumActiveSubarrayPerRow = 1; \
-	inputParameter->maxNumActiveSubarrayPerRow = inputParameter->maxNumColumnSubarray; \
-	inputParameter->minNumActiveSubarrayPerColumn = 1; \
-	inputParameter->maxNumActiveSubarrayPerColumn = inputParameter->maxNumRowSubarray; \
-	inputParameter->minMuxSenseAmp = 1; \
-	inputParameter->maxMuxSenseAmp = 64; \
-	inputParameter->minMuxOutputLev1 = 1; \
-	inputParameter->maxMuxOutputLev1 = 64; \
-	inputParameter->minMuxOutputLev2 = 1; \
-	inputParameter->maxMuxOutputLev2 = 64; \
-	inputParameter->minNumRowPerSet = 1; \
-	inputParameter->maxNumRowPerSet = 1; \
-	inputParameter->minAreaOptimizationLevel = latency_first; \
-	inputParameter->maxAreaOptimizationLevel = area_first;	\
-	inputParameter->minLocalWireType = local_aggressive; \
-	inputParameter->maxLocalWireType = local_conservative; \
-	inputParameter->minGlobalWireType = global_aggressive; \
-	inputParameter->maxGlobalWireType = global_conservative; \
-	inputParameter->minLocalWireRepeaterType = repeated_none; \
-	inputParameter->maxLocalWireRepeaterType = repeated_opt; \
-	inputParameter->minGlobalWireRepeaterType = repeated_none; \
-	inputParameter->maxGlobalWireRepeaterType = repeated_opt; \
-	inputParameter->minIsLocalWireLowSwing = false; \
-	inputParameter->maxIsLocalWireLowSwing = true; \
-	inputParameter->minIsGlobalWireLowSwing = false; \
-	inputParameter->maxIsGlobalWireLowSwing = true; \
-}
-
-
-#define RESTORE_SEARCH_SIZE { \
-	inputParameter->minNumRowMat = 1; \
-	inputParameter->maxNumRowMat = 512; \
-	inputParameter->minNumColumnMat = 1; \
-	inputParameter->maxNumColumnMat = 512; \
-	inputParameter->minNumActiveMatPerRow = 1; \
-	inputParameter->maxNumActiveMatPerRow = inputParameter->maxNumColumnMat; \
-	inputParameter->minNumActiveMatPerColumn = 1; \
-	inputParameter->maxNumActiveMatPerColumn = inputParameter->maxNumRowMat; \
-	inputParameter->minNumRowSubarray = 1; \
-	inputParameter->maxNumRowSubarray = 2; \
-	inputParameter->minNumColumnSubarray = 1; \
-	inputParameter->maxNumColumnSubarray = 2; \
-	inputParameter->minNumActiveSubarrayPerRow = 1; \
-	inputParameter->maxNumActiveSubarrayPerRow = inputParameter->maxNumColumnSubarray; \
-	inputParameter->minNumActiveSubarrayPerColumn = 1; \
-	inputParameter->maxNumActiveSubarrayPerColumn = inputParameter->maxNumRowSubarray; \
-	inputParameter->minMuxSenseAmp = 1; \
-	inputParameter->maxMuxSenseAmp = 256; \
-	inputParameter->minMuxOutputLev1 = 1; \
-	inputParameter->maxMuxOutputLev1 = 256; \
-	inputParameter->minMuxOutputLev2 = 1; \
-	inputParameter->maxMuxOutputLev2 = 256; \
-	inputParameter->minNumRowPerSet = 1; \
-	inputParameter->maxNumRowPerSet = inputParameter->associativity; \
-	inputParameter->minAreaOptimizationLevel = latency_first; \
-	inputParameter->maxAreaOptimizationLevel = area_first; \
-	inputParameter->minLocalWireType = local_aggressive; \
-	inputParameter->maxLocalWireType = semi_conservative; \
-	inputParameter->minGlobalWireType = semi_aggressive; \
-	inputParameter->maxGlobalWireType = global_conservative; \
-	inputParameter->minLocalWireRepeaterType = repeated_none; \
-	inputParameter->maxLocalWireRepeaterType = repeated_50;		/* The limit is repeated_50 */ \
-	inputParameter->minGlobalWireRepeaterType = repeated_none; \
-	inputParameter->maxGlobalWireRepeaterType = repeated_50;	/* The limit is repeated_50 */ \
-	inputParameter->minIsLocalWireLowSwing = false; \
-	inputParameter->maxIsLocalWireLowSwing = true; \
-	inputParameter->minIsGlobalWireLowSwing = false; \
-	inputParameter->maxIsGlobalWireLowSwing = true; \
-}
-
-
 #define APPLY_LIMIT(result) { \
 	(result).reset(); \
 	(result).limitReadLatency = allowedDataReadLatency; \
@@ -297,16 +190,16 @@
 }
 
 
-#define OUTPUT_TO_FILE { \
-	if (inputParameter->designTarget == cache) { \
-		for (int i = 0; i < (int)full_exploration; i++) \
-			tempResult.printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile); \
-	} else { \
-		tempResult.printToCsvFile(outputFile); \
-		outputFile << endl; \
-	} \
+#define PROFILE_EVENT(event) { \
+	if (context->profiler) \
+		context->profiler->Count(event); \
 }
 
+
+#define PROFILE_STAGE(unit, stage) \
+	ProfileTimer profileTimer(context ? context->profiler : NULL, (unit), (stage))
+
+
 #define TO_SECOND(x) \
 	((x) < 1e-9 ? (x) * 1e12 : (x) < 1e-6 ? (x) * 1e9 : (x) < 1e-3 ? (x) * 1e6 : (x) < 1 ? (x) * 1e3 : (x)) \
 	<< \
@@ -40,6 +40,9 @@
 #include <sstream>
 #include <iomanip>
 #include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
 #include "InputParameter.h"
 #include "MemCell.h"
 #include "RowDecoder.h"
@@ -55,459 +58,279 @@
 #include "BankWithoutHtree.h"
 #include "Wire.h"
 #include "Result.h"
+#include "SimulationContext.h"
 #include "formula.h"
 #include "macros.h"
+#include "ThreadPool.h"
+#include "Simulator.h"
+#include "Batch.h"
+#include "Server.h"
+#include "ResultCache.h"
+#include "Progress.h"
 
 using namespace std;
 
-InputParameter *inputParameter;
-Technology *tech;
-MemCell *cell;
-Wire *localWire;
-Wire *globalWire;
-
-void applyConstraint();
+void writeProfile(Profiler *profiler, const string &profileFileName);
+string shardFileName(const string &inputFileName, int shardIndex, int numShard);
 
 int main(int argc, char *argv[])
 {
 	cout << fixed << setprecision(3);
 	string inputFileName;
-
-	if (argc == 1) {
-		inputFileName = "nvsim.cfg";
-		cout << "Default configuration file (nvsim.cfg) is loaded" << endl;
-	} else if (argc == 2) {
-		inputFileName = argv[1];
-		cout << "User-defined configuration file (" << inputFileName << ") is loaded" << endl;
-	} else {
+	string manifestFileName;	/* Empty means a single configuration */
+	string socketPath;			/* Empty means no server */
+	int numThread = 0;		/* 0 means one thread per hardware thread */
+	string profileFileName;	/* Empty means no profiling */
+	string cacheDirectory;	/* Empty means no result cache */
+	int shardIndex = 0;
+	int numShard = 0;		/* 0 means the whole design space is explored */
+	int numMergedShard = 0;	/* 0 means no merge */
+	double timeBudget = 0;	/* Unit: s, 0 means the exploration is not bounded */
+	string statusFileName;	/* Empty means the progress goes to stderr */
+	bool isProgressTracked = false;
+	int numArgument = 0;
+	bool argumentError = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			numThread = atoi(argv[++i]);
+			if (numThread <= 0)
+				argumentError = true;
+		} else if (!strcmp(argv[i], "--profile") && i + 1 < argc) {
+			profileFileName = argv[++i];
+		} else if (!strcmp(argv[i], "--cache") && i + 1 < argc) {
+			cacheDirectory = argv[++i];
+		} else if (!strcmp(argv[i], "--shard") && i + 1 < argc) {
+			if (sscanf(argv[++i], "%d/%d", &shardIndex, &numShard) != 2 || shardIndex < 0 || shardIndex >= numShard)
+				argumentError = true;
+		} else if (!strcmp(argv[i], "--merge") && i + 1 < argc) {
+			numMergedShard = atoi(argv[++i]);
+			if (numMergedShard <= 0)
+				argumentError = true;
+		} else if (!strcmp(argv[i], "--time-budget") && i + 1 < argc) {
+			timeBudget = atof(argv[++i]);
+			isProgressTracked = true;
+			if (timeBudget <= 0)
+				argumentError = true;
+		} else if (!strcmp(argv[i], "--status") && i + 1 < argc) {
+			statusFileName = argv[++i];
+			isProgressTracked = true;
+		} else if (!strcmp(argv[i], "--batch") && i + 1 < argc) {
+			manifestFileName = argv[++i];
+		} else if (!strcmp(argv[i], "--server") && i + 1 < argc) {
+			socketPath = argv[++i];
+		} else if (argv[i][0] != '-' && numArgument == 0) {
+			inputFileName = argv[i];
+			numArgument++;
+		} else {
+			argumentError = true;
+		}
+	}
+	if ((!manifestFileName.empty() || !socketPath.empty()) && numArgument > 0)
+		argumentError = true;
+	if (!manifestFileName.empty() && !socketPath.empty())
+		argumentError = true;
+	if ((numShard > 0 || numMergedShard > 0) && (!manifestFileName.empty() || !socketPath.empty() || !cacheDirectory.empty()))
+		argumentError = true;
+	if (numShard > 0 && numMergedShard > 0)
+		argumentError = true;
+	if (isProgressTracked && (!manifestFileName.empty() || !socketPath.empty() || numMergedShard > 0))
+		argumentError = true;
+	if (timeBudget > 0 && (numShard > 0 || !cacheDirectory.empty()))
+		argumentError = true;	/* The results of a budget are not the ones of the configuration */
+
+	if (argumentError) {
 		cout << "[NVSIM Error]: Please use the correct format as follows" << endl;
 		cout << "  Use the default configuration: " << argv[0] << endl;
 		cout << "  Use the customized configuration: " << argv[0] << " <.cfg file>"  << endl;
+		cout << "  Run every configuration listed in a manifest: " << argv[0] << " --batch <manifest>" << endl;
+		cout << "  Answer the queries on a UNIX domain socket: " << argv[0] << " --server <socket>" << endl;
+		cout << "  Limit the number of exploration threads: " << argv[0] << " [<.cfg file>] --threads <N>" << endl;
+		cout << "  Write the event counters and stage times as CSV: " << argv[0] << " [<.cfg file>] --profile <file>" << endl;
+		cout << "  Reuse the results of identical earlier runs: " << argv[0] << " [<.cfg file>] --cache <directory>" << endl;
+		cout << "  Explore shard i of N (0 <= i < N) into <.cfg file>.shard<i>of<N>: " << argv[0] << " [<.cfg file>] --shard <i>/<N>" << endl;
+		cout << "  Merge the N shard files into the results of a single run: " << argv[0] << " [<.cfg file>] --merge <N>" << endl;
+		cout << "  Stop the exploration after S seconds with the best designs so far: " << argv[0] << " [<.cfg file>] --time-budget <S>" << endl;
+		cout << "  Write the progress of the exploration to a file instead of stderr: " << argv[0] << " [<.cfg file>] --status <file>" << endl;
 		exit(-1);
 	}
-	cout << endl;
-
-	inputParameter = new InputParameter();
-	RESTORE_SEARCH_SIZE;
-	inputParameter->ReadInputParameterFromFile(inputFileName);
 
-	tech = new Technology();
-	tech->Initialize(inputParameter->processNode, inputParameter->deviceRoadmap);
+	ThreadPool threadPool;
+	threadPool.Initialize(numThread);
 
-	Technology techHigh;
-	double alpha = 0;
-	if (inputParameter->processNode > 200){
-		// TO-DO: technology node > 200 nm
-	} else if (inputParameter->processNode > 120) { // 120 nm < technology node <= 200 nm
-		techHigh.Initialize(200, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 120.0) / 60;
-	} else if (inputParameter->processNode > 90) { // 90 nm < technology node <= 120 nm
-		techHigh.Initialize(120, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 90.0) / 30;
-	} else if (inputParameter->processNode > 65) { // 65 nm < technology node <= 90 nm
-		techHigh.Initialize(90, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 65.0) / 25;
-	} else if (inputParameter->processNode > 45) { // 45 nm < technology node <= 65 nm
-		techHigh.Initialize(65, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 45.0) / 20;
-	} else if (inputParameter->processNode >= 32) { // 32 nm < technology node <= 45 nm
-		techHigh.Initialize(45, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 32.0) / 13;
-	} else if (inputParameter->processNode >= 22) { // 22 nm < technology node <= 32 nm
-		techHigh.Initialize(32, inputParameter->deviceRoadmap);
-		alpha = (inputParameter->processNode - 22.0) / 10;
-	} else {
-		//TO-DO: technology node < 22 nm
+	ResultCache resultCache;
+	if (!cacheDirectory.empty()) {
+		resultCache.Initialize(cacheDirectory);
+		if (!resultCache.initialized)
+			exit(-1);
 	}
 
-	tech->InterpolateWith(techHigh, alpha);
-
-	cell = new MemCell();
-	cell->ReadCellFromFile(inputParameter->fileMemCell);
-//	cell->CellScaling(inputParameter->processNode);
-
-	ofstream outputFile;
-	string outputFileName;
-	if (inputParameter->optimizationTarget == full_exploration) {
-		stringstream temp;
-		temp << inputParameter->outputFilePrefix << "_" << inputParameter->capacity / 1024 << "K_" << inputParameter->wordWidth
-				<< "_" << inputParameter->associativity;
-		if (inputParameter->internalSensing)
-			temp << "_IN";
-		else
-			temp << "_EX";
-		if (cell->readMode)
-			temp << "_VOL";
-		else
-			temp << "_CUR";
-		temp << ".csv";
-		outputFileName = temp.str();
-		outputFile.open(outputFileName.c_str(), ofstream::app);
+	if (!manifestFileName.empty()) {
+		Batch batch;
+		batch.Initialize(manifestFileName);
+		if (!profileFileName.empty())
+			batch.profiler = new Profiler();
+		if (resultCache.initialized)
+			batch.cache = &resultCache;
+		string outputFileName = manifestFileName + ".csv";
+		ofstream outputFile(outputFileName.c_str());
+		batch.Run(&threadPool, outputFile);
+		outputFile.close();
+		cout << outputFileName << " generated successfully!" << endl;
+		cout << batch.inputFileName.size() << " configurations, " << batch.library.numModel << " distinct technology and cell models" << endl;
+		if (resultCache.initialized)
+			cout << resultCache.numHit << " of them found in the result cache" << endl;
+		writeProfile(batch.profiler, profileFileName);
+		if (batch.profiler)
+			delete batch.profiler;
+		return 0;
 	}
 
-	cell->PrintCell();
-
-	applyConstraint();
-
-	int numRowMat, numColumnMat, numActiveMatPerRow, numActiveMatPerColumn;
-	int numRowSubarray, numColumnSubarray, numActiveSubarrayPerRow, numActiveSubarrayPerColumn;
-	int muxSenseAmp, muxOutputLev1, muxOutputLev2, numRowPerSet;
-	int areaOptimizationLevel;							/* actually BufferDesignTarget */
-	int localWireType, globalWireType;					/* actually WireType */
-	int localWireRepeaterType, globalWireRepeaterType;	/* actually WireRepeaterType */
-	int isLocalWireLowSwing, isGlobalWireLowSwing;		/* actually boolean value */
-
-	long long capacity;
-	long blockSize;
-	int associativity;
-
-	/* for cache data array, memory array */
-	Result bestDataResults[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
-	Bank *dataBank;
-	for (int i = 0; i < (int)full_exploration; i++)
-		bestDataResults[i].optimizationTarget = (OptimizationTarget)i;
-
-	/* for cache tag array only */
-	Result bestTagResults[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
-	Bank *tagBank = NULL;
-	for (int i = 0; i < (int)full_exploration; i++)
-		bestTagResults[i].optimizationTarget = (OptimizationTarget)i;
-
-	localWire = new Wire();
-	globalWire = new Wire();
-
-	long long numSolution = 0;
-
-	inputParameter->PrintInputParameter();
-
-	/* search tag first */
-	if (inputParameter->designTarget == cache) {
-		/* need to design the tag array */
-		REDUCE_SEARCH_SIZE;
-		/* calculate the tag configuration */
-		int numDataSet = inputParameter->capacity * 8 / inputParameter->wordWidth / inputParameter->associativity;
-		int numIndexBit = (int)(log2(numDataSet) + 0.1);
-		int numOffsetBit = (int)(log2(inputParameter->wordWidth / 8) + 0.1);
-		INITIAL_BASIC_WIRE;
-		/* Simulate tag */
-		BIGFOR {
-			blockSize = TOTAL_ADDRESS_BIT - numIndexBit - numOffsetBit;
-			blockSize += 2;		/* add dirty bits and valid bits */
-			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-				/* To aggressive partitioning */
-				continue;
-			}
-			if (blockSize % (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn)) {
-				blockSize = (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) + 1)
-						* (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn);
-			}
-			capacity = (long long)inputParameter->capacity * 8 / inputParameter->wordWidth * blockSize;
-			associativity = inputParameter->associativity;
-			CALCULATE(tagBank, tag);
-			if (!tagBank->invalid) {
-				Result tempResult;
-				VERIFY_TAG_CAPACITY;
-				numSolution++;
-				UPDATE_BEST_TAG;
-			}
-			delete tagBank;
-		}
-
-		if (numSolution > 0) {
-			Bank * trialBank;
-			Result tempResult;
-			/* refine local wire type */
-			REFINE_LOCAL_WIRE_FORLOOP {
-				localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
-						(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
-						(bool)isLocalWireLowSwing);
-				for (int i = 0; i < (int)full_exploration; i++) {
-					LOAD_GLOBAL_WIRE(bestTagResults[i]);
-					TRY_AND_UPDATE(bestTagResults[i], tag);
-				}
-			}
-			/* refine global wire type */
-			REFINE_GLOBAL_WIRE_FORLOOP {
-				globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
-						(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
-						(bool)isGlobalWireLowSwing);
-				for (int i = 0; i < (int)full_exploration; i++) {
-					LOAD_LOCAL_WIRE(bestTagResults[i]);
-					TRY_AND_UPDATE(bestTagResults[i], tag);
-				}
-			}
-		}
-
-		if (numSolution == 0) {
-			cout << "No valid solutions for tags." << endl;
-			cout << endl << "Finished!" << endl;
-			if (localWire) delete localWire;
-			if (globalWire) delete globalWire;
-			outputFile.close();
-			return 0;
-		} else {
-			numSolution = 0;
-			RESTORE_SEARCH_SIZE;
-			inputParameter->ReadInputParameterFromFile(inputFileName);	/* just for restoring the search space */
-			applyConstraint();
-		}
+	if (!socketPath.empty()) {
+		Server server;
+		server.Initialize(socketPath);
+		if (!server.initialized)
+			exit(-1);
+		if (resultCache.initialized)
+			server.cache = &resultCache;
+		cout << "Listening on " << socketPath << endl;
+		server.Run(&threadPool);
+		cout << server.numQuery << " queries answered, " << server.library.numModel << " distinct technology and cell models" << endl;
+		return 0;
 	}
 
-	/* adjust cache data array parameters according to the access mode */
-	capacity = (long long)inputParameter->capacity * 8;
-	blockSize = inputParameter->wordWidth;
-	associativity = inputParameter->associativity;
-	if (inputParameter->designTarget == cache) {
-		switch (inputParameter->cacheAccessMode) {
-		case sequential_access_mode:
-			/* already knows which way to access */
-			associativity = 1;
-			break;
-		case fast_access_mode:
-			/* load the entire set as a single word */
-			blockSize *= associativity;
-			associativity = 1;
-			break;
-		default:	/* Normal */
-			/* Normal access does not allow one set be distributed into multiple rows
-			 * otherwise, the row activation has to be delayed until the hit signals arrive.
-			 */
-			inputParameter->minNumRowPerSet = inputParameter->maxNumRowPerSet = 1;
-		}
+	if (numArgument == 0) {
+		inputFileName = "nvsim.cfg";
+		cout << "Default configuration file (nvsim.cfg) is loaded" << endl;
+	} else {
+		cout << "User-defined configuration file (" << inputFileName << ") is loaded" << endl;
 	}
+	cout << endl;
 
-	/* adjust block size is it is SLC NAND flash or DRAM memory chip */
-	if (inputParameter->designTarget == RAM_chip && (cell->memCellType == SLCNAND || cell->memCellType == DRAM)) {
-		blockSize = inputParameter->pageSize;
-		associativity = 1;
+	SimulationContext *context = new SimulationContext();
+	string error;
+	if (!context->Initialize(inputFileName, NULL, &error)) {
+		cout << "Error: " << error << "!" << endl;
+		exit(-1);
 	}
-
-	INITIAL_BASIC_WIRE;
-	BIGFOR {
-		if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-			/* To aggressive partitioning */
-			continue;
-		}
-		CALCULATE(dataBank, data);
-		if (!dataBank->invalid) {
-			Result tempResult;
-			VERIFY_DATA_CAPACITY;
-			numSolution++;
-			UPDATE_BEST_DATA;
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
-			}
-		}
-		delete dataBank;
+	if (!profileFileName.empty())
+		context->profiler = new Profiler();
+
+	Simulator simulator;
+	simulator.Initialize(context);
+	Progress progress;
+	if (isProgressTracked) {
+		progress.Initialize(timeBudget, statusFileName);
+		simulator.progress = &progress;
 	}
 
-	if (numSolution > 0) {
-		Bank * trialBank;
-		Result tempResult;
-		/* refine local wire type */
-		REFINE_LOCAL_WIRE_FORLOOP {
-			localWire->Initialize(inputParameter->processNode, (WireType)localWireType,
-					(WireRepeaterType)localWireRepeaterType, inputParameter->temperature,
-					(bool)isLocalWireLowSwing);
-			for (int i = 0; i < (int)full_exploration; i++) {
-				LOAD_GLOBAL_WIRE(bestDataResults[i]);
-				TRY_AND_UPDATE(bestDataResults[i], data);
-			}
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
-			}
-		}
-		/* refine global wire type */
-		REFINE_GLOBAL_WIRE_FORLOOP {
-			globalWire->Initialize(inputParameter->processNode, (WireType)globalWireType,
-					(WireRepeaterType)globalWireRepeaterType, inputParameter->temperature,
-					(bool)isGlobalWireLowSwing);
-			for (int i = 0; i < (int)full_exploration; i++) {
-				LOAD_LOCAL_WIRE(bestDataResults[i]);
-				TRY_AND_UPDATE(bestDataResults[i], data);
-			}
-			if (inputParameter->optimizationTarget == full_exploration && !inputParameter->isPruningEnabled) {
-				OUTPUT_TO_FILE;
-			}
+	if (numShard > 0) {
+		string fileName = shardFileName(inputFileName, shardIndex, numShard);
+		ofstream shardFile(fileName.c_str());
+		if (!shardFile.is_open()) {
+			cout << "[NVSIM Error]: Cannot write the shard to " << fileName << endl;
+			exit(-1);
 		}
+		simulator.shardIndex = shardIndex;
+		simulator.numShard = numShard;
+		if (!simulator.Run(&threadPool, &shardFile))
+			exit(-1);
+		shardFile.close();
+		cout << endl << fileName << " generated successfully!" << endl;
+		cout << simulator.numSolution << " solutions in this shard" << endl;
+		writeProfile(context->profiler, profileFileName);
+		delete context;
+		return 0;
 	}
 
-	if (inputParameter->optimizationTarget == full_exploration && inputParameter->isPruningEnabled) {
-		/* pruning is enabled */
-		Result **** pruningResults;
-		/* pruningResults[x][y][z] points to the result which is optimized for x, with constraint on y with z overhead */
-		pruningResults = new Result***[(int)full_exploration];	/* full_exploration is always set as the last element in the enum, so if full_exploration is 8, what we want here is a 0-7 array, which is correct */
-		for (int i = 0; i < (int)full_exploration; i++) {
-			pruningResults[i] = new Result**[(int)full_exploration];
-			for (int j = 0; j < (int)full_exploration; j++) {
-				pruningResults[i][j] = new Result*[3];		/* 10%, 20%, and 30% overhead */
-				for (int k = 0; k < 3; k++)
-					pruningResults[i][j][k] = new Result;
-			}
-		}
-
-		/* assign the constraints */
-		for (int i = 0; i < (int)full_exploration; i++)
-			for (int j = 0; j < (int)full_exploration; j++)
-				for (int k = 0; k < 3; k++) {
-					pruningResults[i][j][k]->optimizationTarget = (OptimizationTarget)i;
-					*(pruningResults[i][j][k]->localWire) = *(bestDataResults[i].localWire);
-					*(pruningResults[i][j][k]->globalWire) = *(bestDataResults[i].globalWire);
-					switch ((OptimizationTarget)j) {
-					case read_latency_optimized:
-						pruningResults[i][j][k]->limitReadLatency = bestDataResults[j].bank->readLatency * (1 + (k + 1.0) / 10);
-						break;
-					case write_latency_optimized:
-						pruningResults[i][j][k]->limitWriteLatency = bestDataResults[j].bank->writeLatency * (1 + (k + 1.0) / 10);
-						break;
-					case read_energy_optimized:
-						pruningResults[i][j][k]->limitReadDynamicEnergy = bestDataResults[j].bank->readDynamicEnergy * (1 + (k + 1.0) / 10);
-						break;
-					case write_energy_optimized:
-						pruningResults[i][j][k]->limitWriteDynamicEnergy = bestDataResults[j].bank->writeDynamicEnergy * (1 + (k + 1.0) / 10);
-						break;
-					case read_edp_optimized:
-						pruningResults[i][j][k]->limitReadEdp = bestDataResults[j].bank->readLatency * bestDataResults[j].bank->readDynamicEnergy * (1 + (k + 1.0) / 10);
-						break;
-					case write_edp_optimized:
-						pruningResults[i][j][k]->limitWriteEdp = bestDataResults[j].bank->writeLatency * bestDataResults[j].bank->writeDynamicEnergy * (1 + (k + 1.0) / 10);
-						break;
-					case area_optimized:
-						pruningResults[i][j][k]->limitArea = bestDataResults[j].bank->area * (1 + (k + 1.0) / 10);
-						break;
-					case leakage_optimized:
-						pruningResults[i][j][k]->limitLeakage = bestDataResults[j].bank->leakage * (1 + (k + 1.0) / 10);
-						break;
-					default:
-						/* nothing should happen here */
-						cout << "Warning: should not happen" << endl;
-					}
-				}
-
-		for (int i = 0; i < (int)full_exploration; i++) {
-			bestDataResults[i].printAsCacheToCsvFile(bestTagResults[i], inputParameter->cacheAccessMode, outputFile);
-		}
-		cout << "Pruning done" << endl;
-		/* Run pruning here */
-		/* TO-DO */
-
-		/* delete */
-		for (int i = 0; i < (int)full_exploration; i++) {
-			for (int j = 0; j < (int)full_exploration; j++) {
-				for (int k = 0; k < 3; k++)
-					delete pruningResults[i][j][k];
-				delete [] pruningResults[i][j];
+	if (numMergedShard > 0) {
+		vector<istream *> shardFiles;
+		for (int i = 0; i < numMergedShard; i++) {
+			string fileName = shardFileName(inputFileName, i, numMergedShard);
+			ifstream *shardFile = new ifstream(fileName.c_str(), ifstream::binary);
+			if (!shardFile->is_open()) {
+				cout << "[NVSIM Error]: Cannot open the shard " << fileName << endl;
+				exit(-1);
 			}
-			delete [] pruningResults[i];
+			shardFiles.push_back(shardFile);
 		}
+		ofstream outputFile;
+		if (context->inputParameter->optimizationTarget == full_exploration)
+			outputFile.open(simulator.OutputFileName().c_str(), ofstream::app);
+		simulator.numShard = numMergedShard;
+		if (!simulator.Merge(&threadPool, shardFiles, outputFile.is_open() ? &outputFile : NULL))
+			exit(-1);
+		simulator.Print();
+		if (outputFile.is_open())
+			outputFile.close();
+		for (int i = 0; i < numMergedShard; i++)
+			delete shardFiles[i];
+		writeProfile(context->profiler, profileFileName);
+		delete context;
+		return 0;
 	}
 
-	/* If design constraint is applied */
-	if (inputParameter->optimizationTarget != full_exploration && inputParameter->isConstraintApplied) {
-		double allowedDataReadLatency = bestDataResults[read_latency_optimized].bank->readLatency * (inputParameter->readLatencyConstraint + 1);
-		double allowedDataWriteLatency = bestDataResults[write_latency_optimized].bank->writeLatency * (inputParameter->writeLatencyConstraint + 1);
-		double allowedDataReadDynamicEnergy = bestDataResults[read_energy_optimized].bank->readDynamicEnergy * (inputParameter->readDynamicEnergyConstraint + 1);
-		double allowedDataWriteDynamicEnergy = bestDataResults[write_energy_optimized].bank->writeDynamicEnergy * (inputParameter->writeDynamicEnergyConstraint + 1);
-		double allowedDataLeakage = bestDataResults[leakage_optimized].bank->leakage * (inputParameter->leakageConstraint + 1);
-		double allowedDataArea = bestDataResults[area_optimized].bank->area * (inputParameter->areaConstraint + 1);
-		double allowedDataReadEdp = bestDataResults[read_edp_optimized].bank->readLatency
-				* bestDataResults[read_edp_optimized].bank->readDynamicEnergy * (inputParameter->readEdpConstraint + 1);
-		double allowedDataWriteEdp = bestDataResults[write_edp_optimized].bank->writeLatency
-				* bestDataResults[write_edp_optimized].bank->writeDynamicEnergy * (inputParameter->writeEdpConstraint + 1);
-		for (int i = 0; i < (int)full_exploration; i++) {
-			APPLY_LIMIT(bestDataResults[i]);
-		}
-
-		numSolution = 0;
-		INITIAL_BASIC_WIRE;
-		BIGFOR {
-			if (blockSize / (numActiveMatPerRow * numActiveMatPerColumn * numActiveSubarrayPerRow * numActiveSubarrayPerColumn) == 0) {
-				/* To aggressive partitioning */
-				continue;
-			}
-			CALCULATE(dataBank, data);
-			if (!dataBank->invalid && dataBank->readLatency <= allowedDataReadLatency && dataBank->writeLatency <= allowedDataWriteLatency
-					&& dataBank->readDynamicEnergy <= allowedDataReadDynamicEnergy && dataBank->writeDynamicEnergy <= allowedDataWriteDynamicEnergy
-					&& dataBank->leakage <= allowedDataLeakage && dataBank->area <= allowedDataArea
-					&& dataBank->readLatency * dataBank->readDynamicEnergy <= allowedDataReadEdp && dataBank->writeLatency * dataBank->writeDynamicEnergy <= allowedDataWriteEdp) {
-				Result tempResult;
-				VERIFY_DATA_CAPACITY;
-				numSolution++;
-				UPDATE_BEST_DATA;
-			}
-			delete dataBank;
-		}
-	}
+	/* An entry without a report was stored by a batch or a server, the run is repeated for the report */
+	string cacheKey;
+	CacheEntry cacheEntry;
+	if (resultCache.initialized)
+		cacheKey = ResultCache::Key(*context->inputParameter, *context->cell);
+	bool cached = resultCache.initialized && resultCache.Find(cacheKey, &cacheEntry) && !cacheEntry.report.empty();
 
-	if (inputParameter->optimizationTarget != full_exploration) {
-		if (numSolution > 0) {
-			if (inputParameter->designTarget == cache)
-				bestDataResults[inputParameter->optimizationTarget].printAsCache(bestTagResults[inputParameter->optimizationTarget], inputParameter->cacheAccessMode);
-			else
-				bestDataResults[inputParameter->optimizationTarget].print();
-		} else {
-			cout << "No valid solutions." << endl;
-		}
-		cout << endl << "Finished!" << endl;
+	ofstream outputFile;
+	if (context->inputParameter->optimizationTarget == full_exploration || context->inputParameter->topK > 1)
+		outputFile.open(simulator.OutputFileName().c_str(), ofstream::app);
+
+	if (cached) {
+		cout << cacheEntry.report;
+		outputFile << cacheEntry.exploration;
+	} else if (resultCache.initialized) {
+		/* The report and the exploration rows are kept for the cache, and written when the run is over */
+		stringstream report, exploration;
+		streambuf *console = cout.rdbuf(report.rdbuf());
+		bool supported = simulator.Run(&threadPool, outputFile.is_open() ? &exploration : NULL);
+		if (supported)
+			simulator.Print();
+		cout.rdbuf(console);
+		cout << report.str();
+		if (!supported)
+			exit(-1);
+		outputFile << exploration.str();
+
+		stringstream record;
+		simulator.PrintToCsvFile(record);
+		cacheEntry.record = record.str();
+		cacheEntry.exploration = exploration.str();
+		cacheEntry.report = report.str();
+		resultCache.Store(cacheKey, cacheEntry);
 	} else {
-		cout << endl << outputFileName << " generated successfully!" << endl;
-		if (inputParameter->isPruningEnabled) {
-			cout << "The results are pruned" << endl;
-		} else {
-			int solutionMultiplier = 1;
-			if (inputParameter->designTarget == cache)
-				solutionMultiplier = 8;
-			cout << numSolution * solutionMultiplier << " solutions in total" << endl;
-		}
+		if (!simulator.Run(&threadPool, outputFile.is_open() ? &outputFile : NULL))
+			exit(-1);
+		simulator.Print();
 	}
 
 	if (outputFile.is_open())
 		outputFile.close();
-	if (localWire) delete localWire;
-	if (globalWire) delete globalWire;
+	writeProfile(context->profiler, profileFileName);
+	delete context;
 
 	return 0;
 }
 
-void applyConstraint() {
-	/* Check functions that are not yet implemented */
-	if (inputParameter->designTarget == CAM_chip) {
-		cout << "[ERROR] CAM model is still under development" << endl;
-		exit(-1);
-	}
-	if (cell->memCellType == DRAM) {
-		cout << "[ERROR] DRAM model is still under development" << endl;
-		exit(-1);
-	}
-	if (cell->memCellType == eDRAM) {
-		cout << "[Warning] Embedded DRAM model is still under development" << endl;
-		//exit(-1);
-	}
-	if (cell->memCellType == MLCNAND) {
-		cout << "[ERROR] MLC NAND flash model is still under development" << endl;
-		exit(-1);
-	}
-
-	if (inputParameter->designTarget != cache && inputParameter->associativity > 1) {
-		cout << "[WARNING] Associativity setting is ignored for non-cache designs" << endl;
-		inputParameter->associativity = 1;
-	}
-
-	if (!isPow2(inputParameter->associativity)) {
-		cout << "[ERROR] The associativity value has to be a power of 2 in this version" << endl;
-		exit(-1);
+void writeProfile(Profiler *profiler, const string &profileFileName) {
+	if (!profiler)
+		return;
+	ofstream profileFile(profileFileName.c_str());
+	if (!profileFile.is_open()) {
+		cout << "[NVSIM Error]: Cannot write the profile to " << profileFileName << endl;
+		return;
 	}
+	profiler->PrintToCsvFile(profileFile);
+	profileFile.close();
+}
 
-	if (inputParameter->routingMode == h_tree && inputParameter->internalSensing == false) {
-		cout << "[ERROR] H-tree does not support external sensing scheme in this version" << endl;
-		exit(-1);
-	}
-/*
-	if (inputParameter->globalWireRepeaterType != repeated_none && inputParameter->internalSensing == false) {
-		cout << "[ERROR] Repeated global wire does not support external sensing scheme" << endl;
-		exit(-1);
-	}
-*/
-
-	/* TO-DO: more rules to add here */
+string shardFileName(const string &inputFileName, int shardIndex, int numShard) {
+	stringstream fileName;
+	fileName << inputFileName << ".shard" << shardIndex << "of" << numShard;
+	return fileName.str();
 }
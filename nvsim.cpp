@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#include "nvsim.h"
+#include "SimulationContext.h"
+#include "Simulator.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+struct nvsim_context {
+	SimulationContext context;
+	ThreadPool pool;
+	OptimizationTarget loadedTarget;	/* The target of the configuration, restored after every optimization */
+	Simulator evaluator;	/* Builds the organizations of nvsim_evaluate */
+	Result result;
+};
+
+static bool ReadText(const char *_fileName, string *_text) {
+	ifstream file(_fileName);
+	if (!file.is_open())
+		return false;	/* The host is told by the status, nothing is printed */
+	stringstream text;
+	text << file.rdbuf();
+	*_text = text.str();
+	return true;
+}
+
+static bool ValidWire(int _wireType, int _wireRepeaterType, int _isLowSwing) {
+	if (_wireType < (int)local_aggressive || _wireType > (int)global_conservative)
+		return false;
+	if (_wireRepeaterType < (int)repeated_none || _wireRepeaterType > (int)repeated_50)
+		return false;
+	return !(_isLowSwing && _wireRepeaterType != (int)repeated_none);	/* The wire model does not support it */
+}
+
+static void FillMetrics(const Result &_result, nvsim_metrics *_metrics) {
+	const BankRecord &record = _result.record;
+	nvsim_organization *organization = &_metrics->organization;
+	organization->num_row_mat = record.design.numRowMat;
+	organization->num_column_mat = record.design.numColumnMat;
+	organization->num_active_mat_per_row = record.design.numActiveMatPerRow;
+	organization->num_active_mat_per_column = record.design.numActiveMatPerColumn;
+	organization->num_row_subarray = record.design.numRowSubarray;
+	organization->num_column_subarray = record.design.numColumnSubarray;
+	organization->num_active_subarray_per_row = record.design.numActiveSubarrayPerRow;
+	organization->num_active_subarray_per_column = record.design.numActiveSubarrayPerColumn;
+	organization->mux_sense_amp = record.design.muxSenseAmp;
+	organization->mux_output_lev1 = record.design.muxOutputLev1;
+	organization->mux_output_lev2 = record.design.muxOutputLev2;
+	organization->num_row_per_set = record.design.numRowPerSet;
+	organization->area_optimization_level = record.design.areaOptimizationLevel;
+	organization->local_wire_type = (int)_result.localWire->wireType;
+	organization->local_wire_repeater_type = (int)_result.localWire->wireRepeaterType;
+	organization->local_wire_low_swing = _result.localWire->isLowSwing;
+	organization->global_wire_type = (int)_result.globalWire->wireType;
+	organization->global_wire_repeater_type = (int)_result.globalWire->wireRepeaterType;
+	organization->global_wire_low_swing = _result.globalWire->isLowSwing;
+
+	_metrics->num_row_subarray_cell = record.numRowSubarrayCell;
+	_metrics->num_column_subarray_cell = record.numColumnSubarrayCell;
+	_metrics->height = record.height;
+	_metrics->width = record.width;
+	_metrics->area = record.area;
+	_metrics->read_latency = record.readLatency;
+	_metrics->write_latency = record.writeLatency;
+	_metrics->set_latency = record.setLatency;
+	_metrics->reset_latency = record.resetLatency;
+	_metrics->read_dynamic_energy = record.readDynamicEnergy;
+	_metrics->write_dynamic_energy = record.writeDynamicEnergy;
+	_metrics->set_dynamic_energy = record.setDynamicEnergy;
+	_metrics->reset_dynamic_energy = record.resetDynamicEnergy;
+	_metrics->leakage = record.leakage;
+}
+
+int nvsim_abi_version(void) {
+	return NVSIM_ABI_VERSION;
+}
+
+nvsim_context *nvsim_create(const nvsim_config *config, const nvsim_cell *cell) {
+	nvsim_context *context = NULL;
+	nvsim_open(config, cell, &context);
+	return context;
+}
+
+nvsim_status nvsim_open(const nvsim_config *config, const nvsim_cell *cell, nvsim_context **context) {
+	if (!context)
+		return NVSIM_INVALID_ARGUMENT;
+	*context = NULL;
+	if (!config)
+		return NVSIM_INVALID_ARGUMENT;
+
+	string configText, cellText;
+	if (config->config_file) {
+		if (!ReadText(config->config_file, &configText))
+			return NVSIM_INVALID_CONFIG;
+	} else if (config->config_text) {
+		configText = config->config_text;
+	} else {
+		return NVSIM_INVALID_ARGUMENT;
+	}
+
+	/* The cell is always handed over as text, the file reader of MemCell exits if the file is missing */
+	if (cell && cell->cell_file) {
+		if (!ReadText(cell->cell_file, &cellText))
+			return NVSIM_INVALID_CONFIG;
+	} else if (cell && cell->cell_text) {
+		cellText = cell->cell_text;
+	} else {
+		InputParameter inputParameter;
+		inputParameter.ReadInputParameterFromText(configText);
+		if (!ReadText(inputParameter.fileMemCell.c_str(), &cellText))
+			return NVSIM_INVALID_CONFIG;
+	}
+
+	/* The configurations the models would stop the host process on are refused before they are built */
+	nvsim_context *newContext = new nvsim_context;
+	if (!newContext->context.InitializeFromText(configText, cellText)) {
+		delete newContext;
+		return NVSIM_INVALID_CONFIG;
+	}
+	newContext->evaluator.verbose = false;
+	newContext->evaluator.Initialize(&newContext->context);
+	if (!newContext->evaluator.ApplyConstraint()) {
+		delete newContext;
+		return NVSIM_NOT_SUPPORTED;
+	}
+	newContext->loadedTarget = newContext->context.inputParameter->optimizationTarget;
+	newContext->pool.Initialize(config->num_thread);
+	newContext->result.Initialize(&newContext->context);
+	*context = newContext;
+	return NVSIM_OK;
+}
+
+void nvsim_destroy(nvsim_context *context) {
+	delete context;
+}
+
+nvsim_status nvsim_evaluate(nvsim_context *context, const nvsim_organization *organization, nvsim_metrics *metrics) {
+	if (!context || !organization || !metrics)
+		return NVSIM_INVALID_ARGUMENT;
+	if (!ValidWire(organization->local_wire_type, organization->local_wire_repeater_type, organization->local_wire_low_swing)
+			|| !ValidWire(organization->global_wire_type, organization->global_wire_repeater_type, organization->global_wire_low_swing))
+		return NVSIM_INVALID_ARGUMENT;
+
+	SimulationContext *simulation = &context->context;
+	simulation->SetLocalWire((WireType)organization->local_wire_type, (WireRepeaterType)organization->local_wire_repeater_type,
+			organization->local_wire_low_swing != 0);
+	simulation->SetGlobalWire((WireType)organization->global_wire_type, (WireRepeaterType)organization->global_wire_repeater_type,
+			organization->global_wire_low_swing != 0);
+
+	DesignPoint design;
+	design.numRowMat = organization->num_row_mat;
+	design.numColumnMat = organization->num_column_mat;
+	design.numActiveMatPerRow = organization->num_active_mat_per_row;
+	design.numActiveMatPerColumn = organization->num_active_mat_per_column;
+	design.numRowSubarray = organization->num_row_subarray;
+	design.numColumnSubarray = organization->num_column_subarray;
+	design.numActiveSubarrayPerRow = organization->num_active_subarray_per_row;
+	design.numActiveSubarrayPerColumn = organization->num_active_subarray_per_column;
+	design.muxSenseAmp = organization->mux_sense_amp;
+	design.muxOutputLev1 = organization->mux_output_lev1;
+	design.muxOutputLev2 = organization->mux_output_lev2;
+	design.numRowPerSet = organization->num_row_per_set;
+	design.areaOptimizationLevel = organization->area_optimization_level;
+	if (!context->evaluator.Evaluate(design, &context->result))
+		return NVSIM_NO_SOLUTION;
+
+	FillMetrics(context->result, metrics);
+	return NVSIM_OK;
+}
+
+nvsim_status nvsim_optimize(nvsim_context *context, int target, nvsim_metrics *data, nvsim_metrics *tag) {
+	if (!context || !data || target < -1 || target > (int)full_exploration)
+		return NVSIM_INVALID_ARGUMENT;
+
+	InputParameter *inputParameter = context->context.inputParameter;
+	inputParameter->optimizationTarget = context->loadedTarget;
+	if (target >= 0)
+		inputParameter->optimizationTarget = (OptimizationTarget)target;
+	OptimizationTarget optimizationTarget = inputParameter->optimizationTarget;
+	if (optimizationTarget == full_exploration)
+		return NVSIM_NOT_SUPPORTED;
+
+	Simulator simulator;
+	simulator.verbose = false;
+	simulator.Initialize(&context->context);
+	nvsim_status status = NVSIM_OK;
+	if (!simulator.Run(&context->pool, NULL)) {
+		status = NVSIM_NOT_SUPPORTED;
+	} else if (simulator.numSolution == 0 || (inputParameter->designTarget == cache && simulator.numTagSolution == 0)) {
+		status = NVSIM_NO_SOLUTION;
+	} else {
+		FillMetrics(simulator.bestDataResults[optimizationTarget], data);
+		if (tag && inputParameter->designTarget == cache)
+			FillMetrics(simulator.bestTagResults[optimizationTarget], tag);
+	}
+
+	inputParameter->optimizationTarget = context->loadedTarget;
+	return status;
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+* Copyright (c) 2012-2013, The Microsystems Design Labratory (MDL)
+* Department of Computer Science and Engineering, The Pennsylvania State University
+* Exascale Computing Lab, Hewlett-Packard Company
+* All rights reserved.
+* 
+* This source code is part of NVSim - An area, timing and power model for both 
+* volatile (e.g., SRAM, DRAM) and non-volatile memory (e.g., PCRAM, STT-RAM, ReRAM, 
+* SLC NAND Flash). The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Author list: 
+*   Cong Xu	    ( Email: czx102 at psu dot edu 
+*                     Website: http://www.cse.psu.edu/~czx102/ )
+*   Xiangyu Dong    ( Email: xydong at cse dot psu dot edu
+*                     Website: http://www.cse.psu.edu/~xydong/ )
+*******************************************************************************/
+
+
+#ifndef NVSIM_H_
+#define NVSIM_H_
+
+/* The C interface of libnvsim, for the programs that evaluate NVSim designs in their own process.
+ *
+ * A context holds one configuration and its technology, cell and wire models. Each context must be
+ * used by one thread at a time, different contexts can be used by different threads. The structs
+ * are plain C data, new fields are only appended and NVSIM_ABI_VERSION is raised when they are. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NVSIM_ABI_VERSION 2
+
+typedef struct nvsim_context nvsim_context;
+
+typedef enum {
+	NVSIM_OK = 0,
+	NVSIM_NO_SOLUTION = 1,			/* The organization is not valid, or no design meets the configuration */
+	NVSIM_NOT_SUPPORTED = 2,		/* The configuration or the optimization target is not supported */
+	NVSIM_INVALID_ARGUMENT = 3,
+	NVSIM_INVALID_CONFIG = 4		/* A file cannot be read, or the models cannot be built for the configuration */
+} nvsim_status;
+
+typedef struct {
+	const char *config_file;	/* Path of a .cfg file, NULL to use config_text */
+	const char *config_text;	/* The configuration in the .cfg format */
+	int num_thread;				/* Threads of nvsim_optimize, 0 means one per hardware thread */
+} nvsim_config;
+
+typedef struct {
+	const char *cell_file;		/* Path of a .cell file, NULL to use cell_text */
+	const char *cell_text;		/* The cell in the .cell format, NULL to use the cell file of the configuration */
+} nvsim_cell;
+
+typedef struct {
+	int num_row_mat, num_column_mat;	/* Every count is a power of 2 */
+	int num_active_mat_per_row, num_active_mat_per_column;
+	int num_row_subarray, num_column_subarray;
+	int num_active_subarray_per_row, num_active_subarray_per_column;
+	int mux_sense_amp, mux_output_lev1, mux_output_lev2;
+	int num_row_per_set;			/* 1 except for the caches that are not in the normal access mode */
+	int area_optimization_level;	/* 0: latency first, 1: latency-area trade-off, 2: area first */
+	int local_wire_type;			/* The WireType values of typedef.h: 0 local aggressive ... 5 global conservative */
+	int local_wire_repeater_type;	/* The WireRepeaterType values: 0 none, 1 optimal, 2-7 with 5% to 50% delay overhead */
+	int local_wire_low_swing;
+	int global_wire_type;
+	int global_wire_repeater_type;
+	int global_wire_low_swing;
+} nvsim_organization;
+
+typedef struct {
+	nvsim_organization organization;
+	int num_row_subarray_cell;		/* Cell rows of each subarray */
+	int num_column_subarray_cell;	/* Cell columns of each subarray */
+	double height, width, area;		/* Unit: m, m, m^2 */
+	double read_latency, write_latency, set_latency, reset_latency;	/* Unit: s */
+	double read_dynamic_energy, write_dynamic_energy, set_dynamic_energy, reset_dynamic_energy;	/* Unit: J */
+	double leakage;					/* Unit: W */
+} nvsim_metrics;
+
+int nvsim_abi_version(void);	/* NVSIM_ABI_VERSION of the library */
+
+/* Load a configuration, cell may be NULL. NULL if a file cannot be read or the configuration is not supported */
+nvsim_context *nvsim_create(const nvsim_config *config, const nvsim_cell *cell);
+/* The same, and the status tells why *context is NULL */
+nvsim_status nvsim_open(const nvsim_config *config, const nvsim_cell *cell, nvsim_context **context);
+void nvsim_destroy(nvsim_context *context);
+
+/* Calculate one organization of the memory, or of the data array of a cache. The context keeps the
+ * subarrays it has calculated, so the organizations that share them are faster */
+nvsim_status nvsim_evaluate(nvsim_context *context, const nvsim_organization *organization, nvsim_metrics *metrics);
+
+/* Search the configured design space for the best design of target (the OptimizationTarget values of
+ * typedef.h: 0 read latency ... 7 area), -1 for the target of the configuration. The exploration is not
+ * supported. tag may be NULL, it is only written for caches */
+nvsim_status nvsim_optimize(nvsim_context *context, int target, nvsim_metrics *data, nvsim_metrics *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NVSIM_H_ */
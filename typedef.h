@@ -138,6 +138,79 @@ enum OptimizationTarget
 	full_exploration = 8
 };
 
+enum ParetoObjective	/* The metrics a Pareto frontier is built on, all of them are minimized */
+{
+	read_latency_objective = 0,
+	write_latency_objective = 1,
+	read_energy_objective = 2,
+	write_energy_objective = 3,
+	leakage_objective = 4,
+	area_objective = 5,
+	num_objective = 6	/* always the last one */
+};
+
+enum InvalidScope	/* The peripheral points of the same organization that fail like an invalid one, see Explorer::Execute() */
+{
+	design_scope = 0,		/* Only this design */
+	area_level_scope = 1,	/* Every area optimization level of the same mux degrees and numRowPerSet */
+	mux_scope = 2,			/* The same numRowPerSet with the same or a larger product of the mux degrees */
+	row_per_set_scope = 3,	/* The same or a larger numRowPerSet with any mux degree */
+	organization_scope = 4	/* Every later point, the later mux degrees are never smaller */
+};
+
+enum ProfileEvent	/* The events counted by the profiler, see Profiler.h */
+{
+	design_point_event = 0,			/* A BIGFOR point visited by the exploration */
+	aggressive_partitioning_event = 1,	/* A design skipped by one of the "too aggressive partitioning" checks */
+	mux_overflow_event = 2,			/* A peripheral point skipped, a smaller mux degree already failed with mux_scope */
+	invalid_mat_event = 3,			/* Mat::Initialize marked the mat invalid */
+	invalid_subarray_event = 4,		/* SubArray::Initialize marked the subarray invalid */
+	invalid_row_decoder_event = 5,	/* RowDecoder::Initialize marked the decoder invalid */
+	invalid_sense_amp_event = 6,	/* SenseAmp::Initialize marked the sense amplifier invalid */
+	invalid_output_driver_event = 7,	/* OutputDriver::Initialize marked the driver invalid */
+	invalid_bank_event = 8,			/* A bank that was invalid after its calculation */
+	area_bound_event = 9,			/* Pruned by Bank::LowerBound() after CalculateArea() */
+	mat_bound_event = 10,			/* Pruned by Bank::LowerBound() after the mat calculation */
+	constraint_event = 11,			/* Rejected by the constraints of the configuration */
+	solution_event = 12,			/* A valid design compared with the best ones */
+	subarray_cache_hit_event = 13,	/* A subarray copied from the subarray cache */
+	subarray_cache_miss_event = 14,	/* A subarray that had to be calculated */
+	wire_trial_event = 15,			/* A design recalculated by the wire refinement */
+	invalid_scope_event = 16,		/* A peripheral point skipped, it is in the InvalidScope of an earlier invalid one */
+	shape_event = 17,				/* Rejected by the floorplan limits after CalculateArea() */
+	num_profile_event = 18			/* always the last one */
+};
+
+enum ProfileUnit	/* The classes whose calculation is timed by the profiler */
+{
+	bank_profile = 0,
+	mat_profile = 1,
+	subarray_profile = 2,
+	row_decoder_profile = 3,
+	predecode_block_profile = 4,
+	basic_decoder_profile = 5,
+	precharger_profile = 6,
+	sense_amp_profile = 7,
+	mux_profile = 8,
+	output_driver_profile = 9,
+	comparator_profile = 10,
+	explorer_profile = 11,
+	wire_refiner_profile = 12,
+	num_profile_unit = 13	/* always the last one */
+};
+
+enum ProfileStage
+{
+	initialize_stage = 0,
+	area_stage = 1,
+	rc_stage = 2,
+	latency_stage = 3,
+	power_stage = 4,
+	latency_and_power_stage = 5,
+	run_stage = 6,		/* The whole Explore() or refinement */
+	num_profile_stage = 7	/* always the last one */
+};
+
 enum CacheAccessMode
 {
 	normal_access_mode,		/* data array lookup and tag access happen in parallel